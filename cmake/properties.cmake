@@ -11,6 +11,7 @@ set (DEBUG_FLAG_LOGGING 	1)
 set (DEBUG_FLAG_MEMORY 		2)
 set (DEBUG_FLAG_CLOCKS 		4)
 set (DEBUG_FLAG_POSTLOGGING 5)
+set (DEBUG_FLAG_TRACING 	16)
 
 # --- Compiler based operations.
 if 		(MSVC)
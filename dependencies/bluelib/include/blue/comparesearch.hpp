@@ -2,8 +2,191 @@
 //  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
 //
 #pragma once
+#include <bit>
+//
 #include "types.hpp"
 
+#if defined (__SSE2__) || defined (_M_X64) || defined (_M_AMD64)
+	#define COMPARESEARCH_SSE2
+	#include <emmintrin.h>
+#endif
+
+
+//  ABOUT
+// Prefix matching of byte strings.
+//  - 'IsPrefix' / 'IsPrefixLowCase' compare 16 bytes at a time with SSE2 (baseline on x64),
+//     the latter folding ASCII 'A'-'Z' of the element in-register. Comparison stops at the
+//     first mismatch (including the element's null-terminator) so elements shorter than the
+//     prefix are safe to pass. 16-byte loads never cross a page boundary.
+//  - 'PERFECT' is a perfect-hash lookup of a static keyword set built at compile-time.
+//     One hash, one slot and one 'IsPrefix' per lookup.
+//  - 'ArrayPartFirstMatch*' keep their interface and use 'IsPrefix*' for 1-byte elements.
+//
+
+namespace COMPARESEARCH {
+
+	constexpr u32 PAGE_SIZE 	= 4096;
+	constexpr u32 CHUNK_SIZE 	= 16;
+
+	constexpr u8 LowCase (
+		IN		const u8& 			byte
+	) {
+		return (u8)(byte - 'A') < 26 ? byte | 0x20 : byte;
+	}
+
+	template <bool isLowCase>
+	bool IsPrefixFolded (
+		IN		const void* const& 	prefix,
+		IN		const u32& 			length,
+		IN		const void* const& 	element
+	) {
+		const u8* const a = (const u8*)prefix;
+		const u8* const b = (const u8*)element;
+		u32 i = 0;
+
+		#ifdef COMPARESEARCH_SSE2
+			for (; i < length; i += CHUNK_SIZE) {
+				// Unaligned loads of the element may not cross into a page it doesn't own.
+				if (((uintptr_t)(a + i) & (PAGE_SIZE - 1)) > PAGE_SIZE - CHUNK_SIZE) break;
+				if (((uintptr_t)(b + i) & (PAGE_SIZE - 1)) > PAGE_SIZE - CHUNK_SIZE) break;
+
+				const __m128i left = _mm_loadu_si128 ((const __m128i*)(a + i));
+				__m128i right = _mm_loadu_si128 ((const __m128i*)(b + i));
+
+				if constexpr (isLowCase) { // 'A' - 'Z' -> 'a' - 'z'
+					const __m128i shifted = _mm_add_epi8 (right, _mm_set1_epi8 ((c8)(128 - 'A')));
+					const __m128i isUpper = _mm_cmplt_epi8 (shifted, _mm_set1_epi8 ((c8)(-128 + 26)));
+					right = _mm_or_si128 (right, _mm_and_si128 (isUpper, _mm_set1_epi8 (0x20)));
+				}
+
+				// Only differences within the prefix count.
+				const u32 remaining = length - i;
+				const u32 compared = remaining < CHUNK_SIZE ? (1u << remaining) - 1 : 0xFFFF;
+				const u32 differ = ~_mm_movemask_epi8 (_mm_cmpeq_epi8 (left, right)) & compared;
+
+				if (differ) return false;
+				if (remaining <= CHUNK_SIZE) return true;
+			}
+		#endif
+
+		for (; i < length; ++i) {
+			const u8 byte = isLowCase ? LowCase (b[i]) : b[i];
+			if (a[i] != byte) return false;
+		}
+
+		return true;
+	}
+
+	// Does 'element' start with 'length' bytes of 'prefix'.
+	bool IsPrefix (
+		IN		const void* const& 	prefix,
+		IN		const u32& 			length,
+		IN		const void* const& 	element
+	) {
+		return IsPrefixFolded<false> (prefix, length, element);
+	}
+
+	// As 'IsPrefix' with ASCII upper-case letters of 'element' folded. 'prefix' has to be low-case.
+	bool IsPrefixLowCase (
+		IN		const void* const& 	prefix,
+		IN		const u32& 			length,
+		IN		const void* const& 	element
+	) {
+		return IsPrefixFolded<true> (prefix, length, element);
+	}
+
+	// Index of the first element starting with 'prefix' or 'elementsCount'.
+	template <bool isLowCase>
+	u32 FirstPrefixMatch (
+		IN		const void* const& 			prefix,
+		IN		const u32& 					length,
+		IN		u32 						index,
+		IN		const u32& 					elementsCount,
+		IN		const void* const* const& 	elements
+	) {
+		for (; index < elementsCount; ++index) {
+			if (IsPrefixFolded<isLowCase> (prefix, length, elements[index])) break;
+		}
+
+		return index;
+	}
+
+}
+
+
+namespace COMPARESEARCH {
+
+	constexpr u32 Hash (
+		IN		const c8* const& 	key,
+		OUT		u32& 				length,
+		IN		const u32& 			seed
+	) {
+		u32 hash = 2166136261u ^ seed; // FNV-1a
+		for (length = 0; key[length] != '\0'; ++length) {
+			hash = (hash ^ (u8)key[length]) * 16777619u;
+		}
+
+		return hash ^ (hash >> 15);
+	}
+
+	// Keys have to be unique. 'Find' returns the key index or 'count'.
+	template <u32 count>
+	struct PERFECT {
+
+		static constexpr u32 SLOTS = std::bit_ceil (count * 4);
+		static constexpr u8 EMPTY = 0xFF;
+
+		static_assert (count < EMPTY, "Too many keys for a 'PERFECT' table.");
+
+		const c8* keys [count];
+		u32 lengths [count];
+		u8 slots [SLOTS];
+		u32 seed;
+
+		u32 Find (
+			IN		const c8* const& 	name
+		) const {
+			u32 length;
+			const u32 hash = Hash (name, length, seed);
+			const u8 index = slots[hash & (SLOTS - 1)];
+
+			if (index == EMPTY || lengths[index] != length) return count;
+			return IsPrefix (keys[index], length, name) ? index : count;
+		}
+
+	};
+
+	template <u32 count>
+	consteval PERFECT<count> MakePerfect (
+		IN		const c8* const (&keys) [count]
+	) {
+		PERFECT<count> table {};
+
+		for (u32 seed = 0;; ++seed) {
+			bool isCollision = false;
+
+			for (u32 i = 0; i < table.SLOTS; ++i) table.slots[i] = table.EMPTY;
+
+			for (u32 i = 0; i < count && !isCollision; ++i) {
+				u32 length;
+				u8& slot = table.slots[Hash (keys[i], length, seed) & (table.SLOTS - 1)];
+
+				isCollision = slot != table.EMPTY;
+				slot = i;
+				table.keys[i] = keys[i];
+				table.lengths[i] = length;
+			}
+
+			if (!isCollision) {
+				table.seed = seed;
+				return table;
+			}
+		}
+	}
+
+}
+
+
 namespace COMPARESEARCH {
 
 	void ArrayPartFirstMatch (
@@ -14,6 +197,12 @@ namespace COMPARESEARCH {
 		IN		const u32&			elementsCount,
 		IN		const void* const	elements
 	) {
+		if (comperedSize == 1) {
+			index = FirstPrefixMatch<false> (compered, comperedCount, index, elementsCount, (const void* const*)elements);
+			index -= (index == elementsCount); // Last index when nothing matched, as below.
+			return;
+		}
+
 		auto& iElement = index;
 		u8 collision = 1;
 
@@ -40,6 +229,11 @@ namespace COMPARESEARCH {
 		IN		const u32&					elementsCount,
 		IN		const void* const* const&	elements
 	) {
+		if (comperedSize == 1) {
+			index = FirstPrefixMatch<false> (compered, comperedCount, index, elementsCount, elements);
+			return;
+		}
+
 		auto& iElement = index;
 		u8 collision = 1;
 
@@ -68,6 +262,11 @@ namespace COMPARESEARCH {
 		IN		const u32&					elementsCount,
 		IN		const void* const* const&	elements
 	) {
+		if (comperedSize == 1) {
+			index = FirstPrefixMatch<true> (compered, comperedCount, index, elementsCount, elements);
+			return;
+		}
+
 		auto& iElement = index;
 		u8 collision = 1;
 
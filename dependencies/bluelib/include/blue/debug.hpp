@@ -10,7 +10,8 @@
 	#define DEBUG_FLAG_MEMORY 		2
 	#define DEBUG_FLAG_CLOCKS 		4
 	#define DEBUG_FLAG_POSTLOGGING 	8
-	#define DEBUG_TYPE 				15 // ALL ON
+	#define DEBUG_FLAG_TRACING 		16
+	#define DEBUG_TYPE 				31 // ALL ON
 #endif
 
 #define DDEBUG(type) DEBUG_TYPE & type
@@ -13,6 +13,7 @@
 }
 
 #define ERROR(...) { \
+	LOGSTOP (); \
 	LOGERROR (__VA_ARGS__); \
 	 \
 	MEMORY::EXIT::ATEXIT (); \
@@ -23,6 +24,7 @@
 }
 
 #define WERROR(...) { \
+	LOGSTOP (); \
 	LOGWERROR (__VA_ARGS__); \
 	 \
 	MEMORY::EXIT::ATEXIT (); \
@@ -0,0 +1,119 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include "error.hpp"
+//
+#ifndef _WIN32
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+
+//  ABOUT
+// Read-only memory-mapped files. The whole file is mapped at once and paged in by the
+//  system on access - nothing is copied or allocated. 'data' is not null-terminated.
+//  An empty file maps to 'data == nullptr' and 'size == 0'.
+//
+//  'Map' errors out, 'TryMap' returns false instead (files being rewritten by an editor).
+//  'Unmap' is a 'DEALLOC' so a mapping can be pushed onto 'MEMORY::EXIT' while it's parsed.
+//
+
+namespace IO {
+
+	struct MAPPING {
+		const c8* data;
+		u64 size;
+		#ifdef _WIN32
+			HANDLE file;
+			HANDLE mapping;
+		#endif
+	};
+
+	// Returns false when the file can't be opened or mapped.
+	bool TryMap (
+		IN		const c8* const& 	pathname,
+		OUT		MAPPING& 			mapping
+	) {
+		mapping = {};
+
+		#ifdef _WIN32
+			mapping.file = CreateFileA (pathname, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (mapping.file == INVALID_HANDLE_VALUE) { mapping.file = nullptr; return false; }
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx (mapping.file, &size)) {
+				CloseHandle (mapping.file);
+				mapping = {};
+				return false;
+			}
+
+			mapping.size = size.QuadPart;
+			if (mapping.size == 0) return true; // Windows refuses to map empty files.
+
+			mapping.mapping = CreateFileMappingA (mapping.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping.mapping != nullptr) mapping.data = (const c8*) MapViewOfFile (mapping.mapping, FILE_MAP_READ, 0, 0, 0);
+
+			if (mapping.data == nullptr) {
+				if (mapping.mapping != nullptr) CloseHandle (mapping.mapping);
+				CloseHandle (mapping.file);
+				mapping = {};
+				return false;
+			}
+		#else
+			const s32 file = open (pathname, O_RDONLY);
+			if (file == -1) return false;
+
+			struct stat status;
+			if (fstat (file, &status) != 0) {
+				close (file);
+				return false;
+			}
+
+			mapping.size = status.st_size;
+			if (mapping.size != 0) {
+				void* data = mmap (nullptr, mapping.size, PROT_READ, MAP_PRIVATE, file, 0);
+				if (data == MAP_FAILED) {
+					close (file);
+					mapping = {};
+					return false;
+				}
+
+				madvise (data, mapping.size, MADV_SEQUENTIAL);
+				mapping.data = (const c8*) data;
+			}
+
+			close (file); // The mapping keeps its own reference.
+		#endif
+
+		return true;
+	}
+
+	void Map (
+		IN		const c8* const& 	pathname,
+		OUT		MAPPING& 			mapping
+	) {
+		if (!TryMap (pathname, mapping)) ERROR ("File could not be opened or mapped - '%s'." ERROR_NEW_LINE, pathname);
+	}
+
+	void Unmap (
+		INOUT	MAPPING& 			mapping
+	) {
+		#ifdef _WIN32
+			if (mapping.data != nullptr) UnmapViewOfFile (mapping.data);
+			if (mapping.mapping != nullptr) CloseHandle (mapping.mapping);
+			if (mapping.file != nullptr) CloseHandle (mapping.file);
+		#else
+			if (mapping.data != nullptr) munmap ((void*)mapping.data, mapping.size);
+		#endif
+
+		mapping = {};
+	}
+
+	DEALLOC ( Unmap,
+		Unmap (*(MAPPING*)data);
+	)
+
+}
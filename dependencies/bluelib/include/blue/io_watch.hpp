@@ -0,0 +1,192 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <threads.h>
+//
+#include "types.hpp"
+#include "log.hpp"
+#include "windows/types.hpp"
+//
+#ifndef _WIN32
+	#include <sys/stat.h>
+#endif
+#ifdef __linux__
+	#include <sys/inotify.h>
+	#include <poll.h>
+	#include <unistd.h>
+#endif
+
+
+//  ABOUT
+// Watches a few files for changes. A file changed when its last write time differs from
+//  the one seen before - that's what's compared, notifications only wake 'Wait' up early.
+//  On windows every watched directory gets a change notification handle
+//  ('FindFirstChangeNotification'), on linux an inotify watch for files written or moved
+//  into it ('IN_CLOSE_WRITE', 'IN_MOVED_TO'). Elsewhere 'Wait' sleeps for the whole timeout.
+//
+//  Missing files aren't errors, a file being replaced by an editor is missing for a moment.
+//  Paths are copied, nothing is allocated.
+//
+
+#ifndef IO_WATCH_FILES
+	#define IO_WATCH_FILES 16
+#endif
+
+#ifndef IO_WATCH_PATH
+	#define IO_WATCH_PATH 260 // MAX_PATH
+#endif
+
+
+namespace IO::WATCH {
+
+	struct WATCH {
+		u8 filesCount;
+		c8 files [IO_WATCH_FILES][IO_WATCH_PATH];
+		u64 modified [IO_WATCH_FILES]; 	// 0 -> missing
+		#ifdef _WIN32
+			u8 handlesCount;
+			HANDLE handles [IO_WATCH_FILES];
+		#elif defined (__linux__)
+			bool isNotify;
+			s32 notify; 					// inotify, when 'isNotify'
+		#endif
+	};
+
+	// Last write time in the system's units or 0 when the file doesn't exist.
+	u64 GetModified (
+		IN		const c8* const& 	pathname
+	) {
+		#ifdef _WIN32
+			WIN32_FILE_ATTRIBUTE_DATA attributes;
+			if (!GetFileAttributesExA (pathname, GetFileExInfoStandard, &attributes)) return 0;
+			return (u64)attributes.ftLastWriteTime.dwHighDateTime << 32 | attributes.ftLastWriteTime.dwLowDateTime;
+		#else
+			struct stat status;
+			if (stat (pathname, &status) != 0) return 0;
+			return (u64)status.st_mtim.tv_sec * 1000000000ull + status.st_mtim.tv_nsec;
+		#endif
+	}
+
+	// Directory part of 'pathname' ("." when there's none). A root keeps its separator ("/", "C:\\").
+	void GetDirectory (
+		IN		const c8* const& 	pathname,
+		OUT		c8* const& 			directory
+	) {
+		u32 length = 0;
+		bool isSeparated = false;
+
+		for (u32 i = 0; pathname[i] != '\0'; ++i) {
+			if (pathname[i] == '\\' || pathname[i] == '/') { length = i; isSeparated = true; }
+		}
+
+		if (!isSeparated) { directory[0] = '.'; directory[1] = '\0'; return; }
+		if (length == 0 || pathname[length - 1] == ':') ++length;
+
+		memcpy (directory, pathname, length);
+		directory[length] = '\0';
+	}
+
+	// Returns false when the file doesn't fit.
+	bool Add (
+		INOUT	WATCH& 				watch,
+		IN		const c8* const& 	pathname
+	) {
+		const u32 length = strlen (pathname);
+		if (watch.filesCount == IO_WATCH_FILES || length >= IO_WATCH_PATH) return false;
+
+		memcpy (watch.files[watch.filesCount], pathname, length + 1);
+		watch.modified[watch.filesCount] = GetModified (pathname);
+
+		#ifdef _WIN32
+			c8 directory [IO_WATCH_PATH];
+			GetDirectory (pathname, directory);
+
+			bool isWatched = false;
+			for (u8 i = 0; i < watch.filesCount && !isWatched; ++i) {
+				c8 other [IO_WATCH_PATH];
+				GetDirectory (watch.files[i], other);
+				isWatched = strcmp (directory, other) == 0;
+			}
+
+			if (!isWatched) {
+				const HANDLE handle = FindFirstChangeNotificationA (directory, FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+				if (handle != INVALID_HANDLE_VALUE) watch.handles[watch.handlesCount++] = handle;
+				else LOGWARN ("Directory '%s' can't be watched. Changes are noticed with a delay.\n", directory);
+			}
+		#elif defined (__linux__)
+			c8 directory [IO_WATCH_PATH];
+			GetDirectory (pathname, directory);
+
+			if (!watch.isNotify) {
+				watch.notify = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
+				watch.isNotify = watch.notify != -1;
+			}
+
+			// A directory watched already keeps its watch.
+			if (!watch.isNotify || inotify_add_watch (watch.notify, directory, IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+				LOGWARN ("Directory '%s' can't be watched. Changes are noticed with a delay.\n", directory);
+			}
+		#endif
+
+		++watch.filesCount;
+		return true;
+	}
+
+	// Returns true when any of the files changed since the last call. Waits up to 'timeout' ms.
+	bool Wait (
+		INOUT	WATCH& 				watch,
+		IN		const u32& 			timeout
+	) {
+		#ifdef _WIN32
+			if (watch.handlesCount) {
+				const DWORD result = WaitForMultipleObjects (watch.handlesCount, watch.handles, FALSE, timeout);
+				if (result >= WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + watch.handlesCount) {
+					FindNextChangeNotification (watch.handles[result - WAIT_OBJECT_0]);
+				}
+			} else {
+				Sleep (timeout);
+			}
+		#elif defined (__linux__)
+			if (watch.isNotify) {
+				pollfd descriptor { watch.notify, POLLIN, 0 };
+
+				if (poll (&descriptor, 1, timeout) > 0) { // Events are only a wake up, they're dropped.
+					alignas (inotify_event) c8 events [4096];
+					while (read (watch.notify, events, sizeof (events)) > 0);
+				}
+			} else {
+				const timespec duration { timeout / 1000, (timeout % 1000) * 1000000l };
+				thrd_sleep (&duration, nullptr);
+			}
+		#else
+			const timespec duration { timeout / 1000, (timeout % 1000) * 1000000l };
+			thrd_sleep (&duration, nullptr);
+		#endif
+
+		bool isChanged = false;
+
+		for (u8 i = 0; i < watch.filesCount; ++i) {
+			const u64 modified = GetModified (watch.files[i]);
+			isChanged |= modified != watch.modified[i];
+			watch.modified[i] = modified;
+		}
+
+		return isChanged;
+	}
+
+	void Destroy (
+		INOUT	WATCH& 				watch
+	) {
+		#ifdef _WIN32
+			for (u8 i = 0; i < watch.handlesCount; ++i) FindCloseChangeNotification (watch.handles[i]);
+			watch.handlesCount = 0;
+		#elif defined (__linux__)
+			if (watch.isNotify) close (watch.notify); // Closes its watches too.
+			watch.isNotify = false;
+		#endif
+
+		watch.filesCount = 0;
+	}
+
+}
@@ -12,6 +12,39 @@
 	#define ERROR_NEW_LINE "\n"
 #endif
 
+// Non-windows consoles have no 'SetConsoleTextAttribute'. Use ANSI escape codes instead.
+#if !defined (_WIN32) && !defined (LOGGER_ANSI)
+	#define LOGGER_ANSI
+#endif
+
+#ifdef LOGGER_ANSI
+
+	#include "log_line.hpp"
+
+	#ifdef DEBUG_FLAG_CLOCKS
+		#define LOGLINE_TIME() TIMESTAMP::GetElapsed (TIMESTAMP_BEGIN)
+	#else
+		#define LOGLINE_TIME() 0.0f
+	#endif
+
+	#define LOGINFO(...) { \
+		DEBUG (DEBUG_FLAG_LOGGING) \
+		LOGLINE::Write (LOGLINE::LEVEL_INFO, LOGLINE_TIME (), __VA_ARGS__); \
+	}
+
+	#define LOGWARN(...) { \
+		DEBUG (DEBUG_FLAG_LOGGING) \
+		LOGLINE::Write (LOGLINE::LEVEL_WARN, LOGLINE_TIME (), __VA_ARGS__); \
+	}
+
+	#ifndef LOGERROR
+		#define LOGERROR(...) { \
+			LOGLINE::Write (LOGLINE::LEVEL_ERROR, LOGLINE_TIME (), __VA_ARGS__); \
+		}
+	#endif
+
+#endif
+
 #ifdef DEBUG_FLAG_CLOCKS
 
 	#include "timestamp.hpp"
@@ -22,7 +55,7 @@
 		#define LOGGER_TIME_FORMAT "%2.2f"
 	#endif
 
-	#ifdef CONSOLE_COLOR_ENABLED
+	#if defined (CONSOLE_COLOR_ENABLED) && !defined (LOGGER_ANSI)
 
 		#include <windows.h>
 
@@ -93,20 +126,24 @@
 
 	#else
 
-		#define LOGINFO(...) { \
-			DEBUG (DEBUG_FLAG_LOGGING) \
-			printf ("INFO: " __VA_ARGS__); \
-		}
+		#ifndef LOGINFO
+			#define LOGINFO(...) { \
+				DEBUG (DEBUG_FLAG_LOGGING) \
+				printf ("INFO: " __VA_ARGS__); \
+			}
+		#endif
 
 		#define LOGWINFO(...) { \
 			DEBUG (DEBUG_FLAG_LOGGING) \
 			wprintf (L"INFO: " __VA_ARGS__); \
 		}
 
-		#define LOGWARN(...) { \
-			DEBUG (DEBUG_FLAG_LOGGING) \
-			printf ("WARN: " __VA_ARGS__); \
-		}
+		#ifndef LOGWARN
+			#define LOGWARN(...) { \
+				DEBUG (DEBUG_FLAG_LOGGING) \
+				printf ("WARN: " __VA_ARGS__); \
+			}
+		#endif
 
 		#define LOGWWARN(...) { \
 			DEBUG (DEBUG_FLAG_LOGGING) \
@@ -144,7 +181,7 @@
 
 #else
 
-	#ifdef CONSOLE_COLOR_ENABLED
+	#if defined (CONSOLE_COLOR_ENABLED) && !defined (LOGGER_ANSI)
 	
 		#include <windows.h>
 	
@@ -209,20 +246,24 @@
 	
 	#else
 	
-		#define LOGINFO(...) { \
-			DEBUG (DEBUG_FLAG_LOGGING) \
-			printf ("INFO: " __VA_ARGS__); \
-		}
+		#ifndef LOGINFO
+			#define LOGINFO(...) { \
+				DEBUG (DEBUG_FLAG_LOGGING) \
+				printf ("INFO: " __VA_ARGS__); \
+			}
+		#endif
 	
 		#define LOGWINFO(...) { \
 			DEBUG (DEBUG_FLAG_LOGGING) \
 			wprintf (L"INFO: " __VA_ARGS__); \
 		}
 	
-		#define LOGWARN(...) { \
-			DEBUG (DEBUG_FLAG_LOGGING) \
-			printf ("WARN: " __VA_ARGS__); \
-		}
+		#ifndef LOGWARN
+			#define LOGWARN(...) { \
+				DEBUG (DEBUG_FLAG_LOGGING) \
+				printf ("WARN: " __VA_ARGS__); \
+			}
+		#endif
 	
 		#define LOGWWARN(...) { \
 			DEBUG (DEBUG_FLAG_LOGGING) \
@@ -259,3 +300,33 @@
 	}
 
 #endif
+
+
+#ifdef LOGGER_ASYNC
+	#include "log_async.hpp"
+#else
+	#define LOGSTART() {} // dummy
+	#define LOGSTOP() {} // dummy
+#endif
+
+
+//  ABOUT
+// With logging compiled out (eg. release preset 'DEBUG_TYPE=0') log macros must not evaluate
+//  any of their arguments. Checked at compile-time via constant evaluation.
+//
+#if !(DDEBUG (DEBUG_FLAG_LOGGING))
+
+	namespace LOGCHECK {
+
+		constexpr bool IsDiscarded () {
+			u32 evaluated = 0;
+			LOGINFO ("%u", ++evaluated);
+			LOGWARN ("%u", ++evaluated);
+			return evaluated == 0;
+		}
+
+	}
+
+	static_assert (LOGCHECK::IsDiscarded (), "Log arguments are evaluated while logging is compiled out.");
+
+#endif
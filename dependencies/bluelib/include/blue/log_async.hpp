@@ -0,0 +1,338 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <threads.h>
+#include <atomic>
+#include <bit>
+#include <utility>
+#include <type_traits>
+//
+#include "types.hpp"
+#include "debug.hpp"
+#include "log_line.hpp"
+
+
+//  ABOUT
+// Asynchronous logger. Enabled with 'LOGGER_ASYNC' and included by 'log.hpp'.
+//  Producers (any thread) never touch stdio. They claim a slot in a lock-free MPSC ring
+//  and store a pointer to the (literal) format string, the arguments as raw u64 and a
+//  pointer to a printer instantiated for exactly those argument types. A single background
+//  thread formats and flushes them. When the ring is full the message is dropped and
+//  counted, dropped counts are reported by the background thread.
+//
+//  Format strings have to outlive the program (literals). 'c8*' arguments are copied
+//  into the message (truncated to 'LOGGER_ASYNC_STRINGS' bytes in total).
+//
+//  Before 'LOGSTART' and after 'LOGSTOP' messages are printed synchronously. 'LOGSTOP' waits
+//  for producers still putting a message in the ring ('pushing') before the last flush, so a
+//  message pushed while it stops is printed, not lost.
+//  Each line is written with a single call via 'LOGLINE' (unless windows console colours are used).
+//
+
+#ifndef LOGGER_ASYNC_SIZE
+	#define LOGGER_ASYNC_SIZE 256 // Has to be a power of 2.
+#endif
+
+#ifndef LOGGER_ASYNC_ARGUMENTS
+	#define LOGGER_ASYNC_ARGUMENTS 8
+#endif
+
+#ifndef LOGGER_ASYNC_STRINGS
+	#define LOGGER_ASYNC_STRINGS 96
+#endif
+
+static_assert ((LOGGER_ASYNC_SIZE & (LOGGER_ASYNC_SIZE - 1)) == 0, "LOGGER_ASYNC_SIZE has to be a power of 2.");
+
+
+namespace LOGASYNC {
+
+	using LEVEL = LOGLINE::LEVEL;
+
+	struct MESSAGE;
+
+	using Printer = u32 (*) (OUT c8* const& buffer, IN const u32& size, IN const MESSAGE& message);
+
+	struct MESSAGE {
+		std::atomic<u64> sequence; 	// 2 * lap -> free, 2 * lap + 1 -> full.
+		LEVEL level;
+		r32 time;
+		const c8* format;
+		Printer printer;
+		u64 arguments [LOGGER_ASYNC_ARGUMENTS];
+		c8 strings [LOGGER_ASYNC_STRINGS];
+	};
+
+	MESSAGE messages [LOGGER_ASYNC_SIZE];
+
+	alignas (64) std::atomic<u64> head 		= 0; 	// Producers.
+	alignas (64) u64 tail 					= 0; 	// Consumer only.
+	alignas (64) std::atomic<u32> dropped 	= 0;
+	std::atomic<u32> pushing 				= 0; 	// Producers past the running check.
+	std::atomic<bool> isRunning 			= false;
+	thrd_t consumer;
+
+}
+
+
+namespace LOGASYNC {
+
+	template <class T>
+	constexpr bool IsString = std::is_same_v<T, c8*> || std::is_same_v<T, const c8*>;
+
+	template <class T>
+	u64 Pack (
+		INOUT	MESSAGE& 	message,
+		INOUT	u16& 		stringsOffset,
+		IN		const T& 	value
+	) {
+		if constexpr (IsString<T>) {
+			const u16 offset = stringsOffset;
+			u16 i = 0;
+
+			if (value != nullptr) {
+				for (; value[i] != '\0' && offset + i < LOGGER_ASYNC_STRINGS - 1; ++i) {
+					message.strings[offset + i] = value[i];
+				}
+			}
+
+			message.strings[offset + i] = '\0';
+			stringsOffset = offset + i + (offset + i < LOGGER_ASYNC_STRINGS - 1);
+			return offset;
+		} else if constexpr (std::is_floating_point_v<T>) {
+			return std::bit_cast<u64> ((r64)value); // printf promotion.
+		} else if constexpr (std::is_pointer_v<T>) {
+			return (u64)(uintptr_t)value;
+		} else {
+			return (u64)value;
+		}
+	}
+
+	template <class T>
+	auto Unpack (
+		IN		const MESSAGE& 	message,
+		IN		const u64& 		value
+	) {
+		if constexpr (IsString<T>) {
+			return (const c8*)(message.strings + value);
+		} else if constexpr (std::is_floating_point_v<T>) {
+			return std::bit_cast<r64> (value);
+		} else if constexpr (std::is_pointer_v<T>) {
+			return (T)(uintptr_t)value;
+		} else {
+			return (T)value;
+		}
+	}
+
+	template <class... Arguments, size_t... indexes>
+	u32 PrintUnpacked (
+		OUT		c8* const& 			buffer,
+		IN		const u32& 			size,
+		IN		const MESSAGE& 		message,
+		IN		std::index_sequence<indexes...>
+	) {
+		const s32 result = snprintf (buffer, size, message.format, Unpack<Arguments> (message, message.arguments[indexes])...);
+		return LOGLINE::Fit (result, size);
+	}
+
+	template <class... Arguments>
+	u32 Print (
+		OUT		c8* const& 			buffer,
+		IN		const u32& 			size,
+		IN		const MESSAGE& 		message
+	) {
+		return PrintUnpacked<Arguments...> (buffer, size, message, std::index_sequence_for<Arguments...> {});
+	}
+
+	template <class... Arguments>
+	void Fill (
+		INOUT	MESSAGE& 			message,
+		IN		const LEVEL& 		level,
+		IN		const c8* const& 	format,
+		IN		Arguments... 		arguments
+	) {
+		message.level = level;
+		message.format = format;
+		message.printer = Print<Arguments...>;
+
+		#ifdef DEBUG_FLAG_CLOCKS
+			message.time = TIMESTAMP::GetElapsed (TIMESTAMP_BEGIN);
+		#endif
+
+		if constexpr (sizeof... (Arguments) != 0) {
+			u16 stringsOffset = 0;
+			u8 i = 0;
+
+			((message.arguments[i++] = Pack (message, stringsOffset, arguments)), ...);
+		}
+	}
+
+	void Write (
+		IN		const MESSAGE& 		message
+	) {
+		c8 buffer [LOGGER_LINE_SIZE];
+
+		#if defined (CONSOLE_COLOR_ENABLED) && !defined (LOGGER_ANSI)
+			const c8* const tags [] { " INFO", " WARN" };
+			const WORD colors [] { CNS_CLR_INF, CNS_CLR_WAR };
+
+			#ifdef DEBUG_FLAG_CLOCKS
+				fprintf (stdout, "[" LOGGER_TIME_FORMAT "]", message.time);
+			#endif
+
+			SetConsoleTextAttribute (GetStdHandle (STD_OUTPUT_HANDLE), colors[message.level]);
+			fprintf (stdout, "%s", tags[message.level]);
+			SetConsoleTextAttribute (GetStdHandle (STD_OUTPUT_HANDLE), CNS_CLR_DEF);
+
+			message.printer (buffer, LOGGER_LINE_SIZE, message);
+			fprintf (stdout, ": %s", buffer);
+		#else
+			u32 length = LOGLINE::Header (buffer, message.level, message.time);
+			length += message.printer (buffer + length, LOGGER_LINE_SIZE - length, message);
+			LOGLINE::Output (buffer, length);
+		#endif
+	}
+
+	template <class... Arguments>
+	void Push (
+		IN		const LEVEL& 		level,
+		IN		const c8* const& 	format,
+		IN		Arguments... 		arguments
+	) {
+		static_assert (sizeof... (Arguments) <= LOGGER_ASYNC_ARGUMENTS, "Too many arguments for an async log message.");
+
+		// Counted before the check, 'Destroy' clears 'isRunning' before it waits for none.
+		pushing.fetch_add (1, std::memory_order_seq_cst);
+
+		if (!isRunning.load (std::memory_order_seq_cst)) { // Synchronous fallback.
+			pushing.fetch_sub (1, std::memory_order_release);
+
+			MESSAGE message;
+			Fill (message, level, format, arguments...);
+			Write (message);
+			return;
+		}
+
+		u64 position = head.load (std::memory_order_relaxed);
+		MESSAGE* message;
+		u64 free;
+
+		for (;;) {
+			message = &messages[position & (LOGGER_ASYNC_SIZE - 1)];
+			free = (position / LOGGER_ASYNC_SIZE) * 2;
+
+			const u64 sequence = message->sequence.load (std::memory_order_acquire);
+			const s64 difference = (s64)(sequence - free);
+
+			if (difference == 0) {
+				if (head.compare_exchange_weak (position, position + 1, std::memory_order_relaxed)) break;
+			} else if (difference < 0) { // Full. Never block.
+				dropped.fetch_add (1, std::memory_order_relaxed);
+				pushing.fetch_sub (1, std::memory_order_release);
+				return;
+			} else {
+				position = head.load (std::memory_order_relaxed);
+			}
+		}
+
+		Fill (*message, level, format, arguments...);
+		message->sequence.store (free + 1, std::memory_order_release);
+		pushing.fetch_sub (1, std::memory_order_release);
+	}
+
+	// Consumer only. Returns the number of messages written.
+	u32 Flush () {
+		u32 count = 0;
+
+		for (;; ++tail, ++count) {
+			MESSAGE& message = messages[tail & (LOGGER_ASYNC_SIZE - 1)];
+			const u64 lap = tail / LOGGER_ASYNC_SIZE;
+
+			if (message.sequence.load (std::memory_order_acquire) != lap * 2 + 1) break;
+
+			Write (message);
+			message.sequence.store ((lap + 1) * 2, std::memory_order_release);
+		}
+
+		#if defined (CONSOLE_COLOR_ENABLED) && !defined (LOGGER_ANSI)
+			if (count) fflush (stdout);
+		#endif
+		return count;
+	}
+
+	void ReportDropped (
+		IN		const u32& 			count
+	) {
+		MESSAGE report;
+		Fill (report, LOGLINE::LEVEL_WARN, "Logger dropped %u messages in total.\n", count);
+		Write (report);
+	}
+
+	s32 Consume (
+		INOUT 	void* anyargs
+	) {
+
+		DEBUG (DEBUG_FLAG_LOGGING) {
+			if (anyargs != nullptr) LOGWARN ("Arguments passed to the logger's consumer!");
+		}
+
+		const timespec idle { 0, 1000000 }; // 1ms
+		u32 droppedReported = 0;
+
+		while (isRunning.load (std::memory_order_acquire)) {
+			if (Flush () == 0) thrd_sleep (&idle, nullptr);
+
+			const u32 droppedCurrent = dropped.load (std::memory_order_relaxed);
+			if (droppedCurrent != droppedReported) {
+				droppedReported = droppedCurrent;
+				ReportDropped (droppedCurrent);
+			}
+		}
+
+		Flush ();
+		return 0;
+	}
+
+	void Create () {
+		isRunning.store (true, std::memory_order_release);
+		thrd_create (&consumer, Consume, nullptr);
+	}
+
+	void Destroy () {
+		if (!isRunning.exchange (false, std::memory_order_seq_cst)) return;
+		thrd_join (consumer, nullptr);
+
+		// Whoever passed the running check before it was cleared publishes into the ring.
+		while (pushing.load (std::memory_order_seq_cst) != 0) thrd_yield ();
+		std::atomic_thread_fence (std::memory_order_acquire);
+		Flush ();
+
+		const u32 droppedCurrent = dropped.load (std::memory_order_relaxed);
+		if (droppedCurrent) ReportDropped (droppedCurrent);
+	}
+
+}
+
+
+#undef LOGINFO
+#undef LOGWARN
+
+#define LOGINFO(...) { \
+	DEBUG (DEBUG_FLAG_LOGGING) \
+	LOGASYNC::Push (LOGLINE::LEVEL_INFO, __VA_ARGS__); \
+}
+
+#define LOGWARN(...) { \
+	DEBUG (DEBUG_FLAG_LOGGING) \
+	LOGASYNC::Push (LOGLINE::LEVEL_WARN, __VA_ARGS__); \
+}
+
+#define LOGSTART() { \
+	DEBUG (DEBUG_FLAG_LOGGING) \
+	LOGASYNC::Create (); \
+}
+
+#define LOGSTOP() { \
+	DEBUG (DEBUG_FLAG_LOGGING) \
+	LOGASYNC::Destroy (); \
+}
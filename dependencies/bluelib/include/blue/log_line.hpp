@@ -0,0 +1,117 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+//
+#ifdef _WIN32
+	#include <io.h>
+#else
+	#include <unistd.h>
+#endif
+//
+#include "types.hpp"
+#include "debug.hpp"
+
+
+//  ABOUT
+// Single-write log lines. The whole line - timestamp, level tag, ANSI colour codes and the
+//  message - is built in one stack buffer and handed to the OS with a single 'write'.
+//  No stdio locking, no per-part calls and no 'SetConsoleTextAttribute'. Used by 'log.hpp'
+//  when 'LOGGER_ANSI' is defined (default outside Windows) and by 'log_async.hpp'.
+//
+//  Lines longer than 'LOGGER_LINE_SIZE' are truncated.
+//
+
+#ifndef LOGGER_LINE_SIZE
+	#define LOGGER_LINE_SIZE 512
+#endif
+
+#ifndef LOGGER_TIME_FORMAT
+	#define LOGGER_TIME_FORMAT "%2.2f"
+#endif
+
+// Lets the compiler check a printf-style format (parameter index) against its arguments (from index).
+#if defined(__GNUC__)
+	#define LOGLINE_FORMAT(formatIndex, argumentsIndex) __attribute__((__format__ (__printf__, formatIndex, argumentsIndex)))
+#else
+	#define LOGLINE_FORMAT(formatIndex, argumentsIndex)
+#endif
+
+
+namespace LOGLINE {
+
+	enum LEVEL: u8 {
+		LEVEL_INFO 	= 0,
+		LEVEL_WARN 	= 1,
+		LEVEL_ERROR = 2,
+	};
+
+	#ifdef CONSOLE_COLOR_ENABLED
+		const c8* const TAGS [] { "\x1b[32mINFO\x1b[0m: ", "\x1b[33mWARN\x1b[0m: ", "\x1b[31mERRR\x1b[0m: " };
+		const u8 TAGS_LENGTH [] { 15, 15, 15 };
+	#else
+		const c8* const TAGS [] { "INFO: ", "WARN: ", "ERRR: " };
+		const u8 TAGS_LENGTH [] { 6, 6, 6 };
+	#endif
+
+	void Output (
+		IN		const c8* const& 	data,
+		IN		const u32& 			length
+	) {
+		#ifdef _WIN32
+			_write (1, data, length);
+		#else
+			for (u32 written = 0; written < length;) {
+				const auto result = write (1, data + written, length - written);
+				if (result <= 0) break;
+				written += result;
+			}
+		#endif
+	}
+
+	// Returns the number of characters written to 'buffer' which is expected to be 'LOGGER_LINE_SIZE' long.
+	u32 Header (
+		OUT		c8* const& 			buffer,
+		IN		const LEVEL& 		level,
+		IN		const r32& 			time
+	) {
+		u32 length = 0;
+
+		#ifdef DEBUG_FLAG_CLOCKS
+			length = snprintf (buffer, LOGGER_LINE_SIZE, "[" LOGGER_TIME_FORMAT "] ", time);
+		#endif
+
+		memcpy (buffer + length, TAGS[level], TAGS_LENGTH[level]);
+		return length + TAGS_LENGTH[level];
+	}
+
+	// Clamps a 'snprintf' result to what actually fit into 'size'.
+	u32 Fit (
+		IN		const s32& 			result,
+		IN		const u32& 			size
+	) {
+		if (result < 0) return 0;
+		return (u32)result < size ? result : size - 1;
+	}
+
+	LOGLINE_FORMAT (3, 4) void Write (
+		IN		const LEVEL& 		level,
+		IN		const r32& 			time,
+		IN		const c8* const 	format,
+		...
+	) {
+		c8 buffer [LOGGER_LINE_SIZE];
+		u32 length = Header (buffer, level, time);
+
+		va_list arguments;
+		va_start (arguments, format);
+		length += Fit (vsnprintf (buffer + length, LOGGER_LINE_SIZE - length, format, arguments), LOGGER_LINE_SIZE - length);
+		va_end (arguments);
+
+		Output (buffer, length);
+	}
+
+}
@@ -4,22 +4,75 @@
 #pragma once
 #include "types.hpp"
 
-const r32 DIV64LUT [64 + 1] {
-	00.0f / 64.0f, // 0
-	01.0f / 64.0f, 02.0f / 64.0f, 03.0f / 64.0f, 04.0f / 64.0f,
-	05.0f / 64.0f, 06.0f / 64.0f, 07.0f / 64.0f, 08.0f / 64.0f,
-	09.0f / 64.0f, 10.0f / 64.0f, 11.0f / 64.0f, 12.0f / 64.0f,
-	13.0f / 64.0f, 14.0f / 64.0f, 15.0f / 64.0f, 16.0f / 64.0f,
-	17.0f / 64.0f, 18.0f / 64.0f, 19.0f / 64.0f, 20.0f / 64.0f,
-	21.0f / 64.0f, 22.0f / 64.0f, 23.0f / 64.0f, 24.0f / 64.0f,
-	25.0f / 64.0f, 26.0f / 64.0f, 27.0f / 64.0f, 28.0f / 64.0f,
-	29.0f / 64.0f, 30.0f / 64.0f, 31.0f / 64.0f, 32.0f / 64.0f,
-	33.0f / 64.0f, 34.0f / 64.0f, 35.0f / 64.0f, 36.0f / 64.0f,
-	37.0f / 64.0f, 38.0f / 64.0f, 39.0f / 64.0f, 40.0f / 64.0f,
-	41.0f / 64.0f, 42.0f / 64.0f, 43.0f / 64.0f, 44.0f / 64.0f,
-	45.0f / 64.0f, 46.0f / 64.0f, 47.0f / 64.0f, 48.0f / 64.0f,
-	49.0f / 64.0f, 50.0f / 64.0f, 51.0f / 64.0f, 52.0f / 64.0f,
-	53.0f / 64.0f, 54.0f / 64.0f, 55.0f / 64.0f, 56.0f / 64.0f,
-	57.0f / 64.0f, 58.0f / 64.0f, 59.0f / 64.0f, 60.0f / 64.0f,
-	61.0f / 64.0f, 62.0f / 64.0f, 63.0f / 64.0f, 64.0f / 64.0f,
-};
+
+//  ABOUT
+// Lookup tables are generated at compile-time via 'LUT::Generate'. Generator functions
+//  have to be constexpr therefore 'LUT' implements its own 'Exp' and 'Sine'. These use
+//  only +, -, *, / on r64 which during constant evaluation are plain IEEE-754 operations
+//  (no fma contraction, no runtime libm) - the resulting tables are bit-exact across compilers.
+//
+
+namespace LUT {
+
+	constexpr r64 PI = 3.14159265358979323846;
+	constexpr r64 LN2 = 0.69314718055994530942;
+
+	template <class T, u32 length, class Function>
+	consteval arr32<T, length> Generate (
+		IN		Function function
+	) {
+		arr32<T, length> table {};
+		for (u32 i = 0; i < length; ++i) table[i] = function (i);
+		return table;
+	}
+
+	constexpr r64 Exp (
+		IN		r64 x
+	) {
+		// exp (x) = 2^k * exp (r) where |r| <= ln2 / 2.
+		const s32 k = (s32)(x / LN2 + (x < 0 ? -0.5 : 0.5));
+		const r64 r = x - k * LN2;
+
+		r64 term = 1.0, sum = 1.0;
+		for (u32 n = 1; n < 24; ++n) {
+			term *= r / n;
+			sum += term;
+		}
+
+		for (s32 i = 0; i < k; ++i) sum *= 2.0;
+		for (s32 i = 0; i > k; --i) sum *= 0.5;
+
+		return sum;
+	}
+
+	constexpr r64 Sine (
+		IN		r64 x
+	) {
+		// Range reduction to [-PI, PI].
+		const r64 turns = x / (2.0 * PI);
+		x -= (2.0 * PI) * (s64)(turns + (turns < 0 ? -0.5 : 0.5));
+
+		r64 term = x, sum = x;
+		for (u32 n = 1; n < 16; ++n) {
+			term *= -x * x / ((2 * n) * (2 * n + 1));
+			sum += term;
+		}
+
+		return sum;
+	}
+
+}
+
+
+// [i] -> i / 64
+constexpr auto DIV64LUT = LUT::Generate<r32, 64 + 1> (
+	[] (u32 i) { return (r32)i / 64.0f; }
+);
+
+// One period of sin (x) sampled at 64 points.
+constexpr auto SINE64LUT = LUT::Generate<r32, 64> (
+	[] (u32 i) { return (r32)LUT::Sine (2.0 * LUT::PI * i / 64.0); }
+);
+
+static_assert (DIV64LUT[0] == 0.0f && DIV64LUT[1] == 1.0f / 64.0f && DIV64LUT[64] == 1.0f);
+static_assert (SINE64LUT[0] == 0.0f && SINE64LUT[16] == 1.0f && SINE64LUT[48] == -1.0f);
@@ -3,10 +3,14 @@
 //
 #pragma once
 #include "debug.hpp"
+//
+#include <stdlib.h>
+#include <atomic>
 
 //  'About'
 // - Implements a simple wrapper around 'malloc'
 // - Implements a custom 'atexit' implementation that allows sending the parameter. 
+// - Implements an optional linear (arena) allocator behind 'ALLOCATE' / 'FREE'. See 'MEMORY_ARENA'.
 //
 
 
@@ -20,6 +24,24 @@
 #endif
 
 
+//  ABOUT - MEMORY_ARENA
+// With 'MEMORY_ARENA' defined 'ALLOCATE' bumps memory out of a single mapping reserved via
+//  'MEMORY::ARENA::Create'. 'FREE' on arena memory is a no-op unless it's the most recent
+//  allocation in which case the space is given back (LIFO). Whole arena is released at once
+//  with 'MEMORY::ARENA::Destroy' - on exit or on error via 'MEMORY::EXIT'. When the arena
+//  was not created or is full 'ALLOCATE' falls back to 'malloc' and 'FREE' to 'free'.
+//  'Destroy' stops further allocations but unmaps only once every arena block was freed, a
+//  'FREE' after it (exit handlers run in order) still finds its block and doesn't 'free' it.
+//
+//  'ALLOCATE' and 'FREE' can be called from any thread (e.g. sounds decoded while another
+//  thread plays), the offsets are moved with CAS. 'Create' belongs to the starting thread,
+//  before any other allocates.
+//
+#ifndef MEMORY_ARENA_SIZE
+	#define MEMORY_ARENA_SIZE (1024 * 1024)
+#endif
+
+
 #define DEALLOC_TYPE void
 #define DEALLOC_RET  
 
@@ -31,16 +53,157 @@
 #endif
 
 
+#ifdef MEMORY_ARENA
+
+	#ifdef _WIN32
+		#include <windows.h>
+	#else
+		#include <sys/mman.h>
+	#endif
+
+	namespace MEMORY::ARENA {
+
+		// Every block is preceded by the arena offsets from before and after its allocation.
+		//  16 bytes which also keeps every block 16-byte aligned.
+		struct HEADER {
+			u64 previous;
+			u64 next;
+		};
+
+		u8* base 		= nullptr;
+		u64 capacity 	= 0;
+		std::atomic<u64> offset 	= 0;
+		std::atomic<u64> peak 		= 0;
+		std::atomic<u64> blocks 	= 0; 		// Allocated and not freed yet.
+		std::atomic<bool> isDestroyed 	= false; 	// No more allocations, unmapped with the last block.
+		std::atomic<bool> isMapped 		= false;
+
+		bool Create (
+			IN		const u64& 		size
+		) {
+			#ifdef _WIN32
+				base = (u8*) VirtualAlloc (nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+			#else
+				base = (u8*) mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if (base == MAP_FAILED) base = nullptr;
+			#endif
+
+			capacity = base ? size : 0;
+			offset = 0;
+			peak = 0;
+			blocks = 0;
+			isDestroyed = false;
+			isMapped = base != nullptr;
+
+			return base != nullptr;
+		}
+
+		// Whoever lets go of the last block of a destroyed arena unmaps it, once.
+		void Release () {
+			if (blocks.fetch_sub (1, std::memory_order_seq_cst) != 1 || !isDestroyed.load (std::memory_order_seq_cst)) return;
+			if (!isMapped.exchange (false, std::memory_order_acq_rel)) return;
+
+			#ifdef _WIN32
+				VirtualFree (base, 0, MEM_RELEASE);
+			#else
+				munmap (base, capacity);
+			#endif
+
+			base = nullptr;
+			capacity = 0;
+			offset = 0;
+		}
+
+		void* Allocate (
+			IN		const u64& 		size
+		) {
+			const u64 aligned = (size + sizeof (HEADER) - 1) & ~(sizeof (HEADER) - 1);
+			if (base == nullptr) return nullptr;
+
+			// Counted before the check, 'Destroy' sets it before it looks for no blocks.
+			blocks.fetch_add (1, std::memory_order_seq_cst);
+			if (isDestroyed.load (std::memory_order_seq_cst)) { Release (); return nullptr; }
+
+			u64 previous = offset.load (std::memory_order_relaxed);
+			u64 next;
+
+			do {
+				if (capacity - previous < sizeof (HEADER) + aligned) { Release (); return nullptr; }
+				next = previous + sizeof (HEADER) + aligned;
+			} while (!offset.compare_exchange_weak (previous, next, std::memory_order_relaxed));
+
+			u64 top = peak.load (std::memory_order_relaxed);
+			while (next > top && !peak.compare_exchange_weak (top, next, std::memory_order_relaxed));
+
+			HEADER* header = (HEADER*)(base + previous);
+			header->previous = previous;
+			header->next = next;
+
+			return header + 1;
+		}
+
+		// Returns 'false' when 'data' does not belong to the arena.
+		bool Free (
+			INOUT	void* 			data
+		) {
+			if ((u8*)data < base || (u8*)data >= base + capacity) return false;
+
+			const HEADER* header = (HEADER*)data - 1;
+
+			// Only the most recent block can be given back. Any other is reclaimed on 'Destroy'.
+			u64 next = header->next;
+			offset.compare_exchange_strong (next, header->previous, std::memory_order_relaxed);
+
+			Release ();
+			return true;
+		}
+
+		void Destroy (DEALLOC_ARGS) {
+			if (base == nullptr) return;
+
+			// Let go of like a block, unmapped now unless some are still in use.
+			isDestroyed.store (true, std::memory_order_seq_cst);
+			blocks.fetch_add (1, std::memory_order_seq_cst);
+			Release ();
+		}
+
+	}
+
+	#define ARENAALLOCATE(size) MEMORY::ARENA::Allocate (size)
+	#define ARENAFREE(data) MEMORY::ARENA::Free (data)
+
+#else
+
+	#define ARENAALLOCATE(size) nullptr
+	#define ARENAFREE(data) false
+
+#endif
+
+
 #if DDEBUG (DEBUG_FLAG_MEMORY)
 
-	s32 allocationsCounter = 0;
+	std::atomic<s32> allocationsCounter = 0;
+	std::atomic<u64> allocationsTotal = 0; // Every 'ALLOCATE' call. Used to assert none happen on hot paths.
 
 	#if DDEBUG (DEBUG_FLAG_LOGGING)
 
+		#include <inttypes.h>
+		//
 		#include "log.hpp"
 
+		#ifdef MEMORY_ARENA
+			#define LOGARENA() LOGINFO ("Arena peak: %" PRIu64 " of %" PRIu64 " bytes\n", MEMORY::ARENA::peak.load (std::memory_order_relaxed), (u64)MEMORY_ARENA_SIZE);
+		#else
+			#define LOGARENA() {} // dummy
+		#endif
+
+		// Redefined by 'pool.hpp'.
+		#define LOGPOOL() {} // dummy
+
 		#define LOGMEMORY() { \
-			LOGWARN ("Missed Deallocations: %d\n", allocationsCounter); \
+			LOGWARN ("Missed Deallocations: %d\n", allocationsCounter.load ()); \
+			LOGARENA (); \
+			LOGPOOL (); \
 		}
 
 	#else
@@ -54,20 +217,28 @@
 	template <typename Type>
 	void _ALLOCATE (Type*& address, const u64& size) {
 		++allocationsCounter;
-		address = (Type*) malloc (size);
+		++allocationsTotal;
+		address = (Type*) ARENAALLOCATE (size);
+		if (address == nullptr) address = (Type*) malloc (size);
 	}
 
 	#define ALLOCATE(type, address, size) _ALLOCATE<type> (address, size)
 
 	void FREE (DEALLOC_ARGS) {
 		--allocationsCounter;
-		free (data);
+		if (!ARENAFREE (data)) free (data);
 	}
 
 #else
 
-	#define ALLOCATE(type, address, size) address = (type*) malloc (size)
-	void FREE (DEALLOC_ARGS) { free (data); }
+	template <typename Type>
+	void _ALLOCATE (Type*& address, const u64& size) {
+		address = (Type*) ARENAALLOCATE (size);
+		if (address == nullptr) address = (Type*) malloc (size);
+	}
+
+	#define ALLOCATE(type, address, size) _ALLOCATE<type> (address, size)
+	void FREE (DEALLOC_ARGS) { if (!ARENAFREE (data)) free (data); }
 	#define LOGMEMORY() {} // dummy
 	#define INCALLOCCO() // dummy
 	#define DECALLOCCO() // dummy
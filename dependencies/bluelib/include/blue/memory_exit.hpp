@@ -3,6 +3,9 @@
 //
 #pragma once
 #include "memory.hpp"
+//
+#include <stdio.h>
+#include <string.h>
 
 
 //  ABOUT
@@ -15,19 +18,55 @@
 // We cannot use both systems because it's important to dealloc memory in order of allocation!
 // #define MEMORY_TYPE_NOT_SIZED 
 
+//  ABOUT - CAPACITY
+// Stacks start with 'MEMORY_EXIT_SIZE' entries of static storage and double on overflow.
+//  Grown storage comes from 'malloc' directly (not 'ALLOCATE') as it has to outlive the arena
+//  which itself is released through this stack. It's never released - it lives until exit.
+//
+//  ABOUT - THREADS
+// The stacks aren't thread-safe. 'PUSH' and 'POP' belong to one thread at a time.
+//
+
+namespace MEMORY::EXIT {
+
+	template <typename T>
+	T* Grow (
+		IN		T* const& 			current,
+		IN		const void* const 	initial,
+		IN		const u32& 			count,
+		IN		const u32& 			capacity
+	) {
+		T* grown = (T*) malloc (capacity * sizeof (T));
+
+		if (grown == nullptr) {
+			fputs ("ERRR: MEMORY::EXIT stack could not grow.\n", stdout);
+			exit (-1);
+		}
+
+		memcpy (grown, current, count * sizeof (T));
+		if (current != initial) free (current);
+		return grown;
+	}
+
+}
+
 #ifdef MEMORY_TYPE_NOT_SIZED
 
 	namespace MEMORY::EXIT {
 
 		using DeleteFunction = void (*) (DEALLOC_ARGS);
 
-		u8 memoryCounter = 0;
+		u32 memoryCounter = 0;
+		u32 memoryCapacity = MEMORY_EXIT_SIZE;
 
-		DeleteFunction functions [MEMORY_EXIT_SIZE];
-		void* memories	[MEMORY_EXIT_SIZE];
+		DeleteFunction functionsInitial [MEMORY_EXIT_SIZE];
+		void* memoriesInitial	[MEMORY_EXIT_SIZE];
+
+		DeleteFunction* functions 	= functionsInitial;
+		void** memories 			= memoriesInitial;
 
 		void ATEXIT () {
-			for (u8 i = memoryCounter; i != 0; --i) {
+			for (u32 i = memoryCounter; i != 0; --i) {
 				auto& func		= functions	[i - 1];
 				auto& memory	= memories	[i - 1];
 
@@ -40,6 +79,12 @@
 			DeleteFunction function, 
 			void* memory
 		) {
+			if (memoryCounter == memoryCapacity) {
+				functions 	= Grow (functions, 	functionsInitial, 	memoryCounter, memoryCapacity * 2);
+				memories 	= Grow (memories, 	memoriesInitial, 	memoryCounter, memoryCapacity * 2);
+				memoryCapacity *= 2;
+			}
+
 			functions[memoryCounter] 	= function;
 			memories[memoryCounter] 	= memory;
 
@@ -47,6 +92,7 @@
 		}
 
 		void POP () {
+			if (memoryCounter == 0) { fputs ("WARN: MEMORY::EXIT::POP on an empty stack.\n", stdout); return; }
 			--memoryCounter;
 		}
 
@@ -56,16 +102,21 @@
 
 	namespace MEMORY::EXIT {
 
-		u8 memoryCounter = 0;
+		u32 memoryCounter = 0;
+		u32 memoryCapacity = MEMORY_EXIT_SIZE;
 
 		using DeleteFunction = void (*) (DEALLOC_ARGS);
 
-		DeleteFunction functions [MEMORY_EXIT_SIZE];
-		void* memories	[MEMORY_EXIT_SIZE];
-		u32   sizes		[MEMORY_EXIT_SIZE];
+		DeleteFunction functionsInitial [MEMORY_EXIT_SIZE];
+		void* memoriesInitial	[MEMORY_EXIT_SIZE];
+		u32   sizesInitial		[MEMORY_EXIT_SIZE];
+
+		DeleteFunction* functions 	= functionsInitial;
+		void** memories 			= memoriesInitial;
+		u32* sizes 					= sizesInitial;
 
 		void ATEXIT () {
-			for (u8 i = memoryCounter; i != 0; --i) {
+			for (u32 i = memoryCounter; i != 0; --i) {
 				auto& func		= functions	[i - 1];
 				auto& memory	= memories	[i - 1];
 				auto& size		= sizes 	[i - 1];
@@ -81,6 +132,13 @@
 			MEMORY_TYPE size, 
 			void* memory
 		) {
+			if (memoryCounter == memoryCapacity) {
+				functions 	= Grow (functions, 	functionsInitial, 	memoryCounter, memoryCapacity * 2);
+				memories 	= Grow (memories, 	memoriesInitial, 	memoryCounter, memoryCapacity * 2);
+				sizes 		= Grow (sizes, 		sizesInitial, 		memoryCounter, memoryCapacity * 2);
+				memoryCapacity *= 2;
+			}
+
 			functions[memoryCounter] 	= function;
 			memories[memoryCounter] 	= memory;
 			sizes[memoryCounter] 		= size;
@@ -89,6 +147,7 @@
 		}
 
 		void POP () {
+			if (memoryCounter == 0) { fputs ("WARN: MEMORY::EXIT::POP on an empty stack.\n", stdout); return; }
 			--memoryCounter;
 		}
 
@@ -0,0 +1,217 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <atomic>
+#include <new>
+#include <utility>
+#include <string.h>
+#include <inttypes.h>
+//
+#include "types.hpp"
+#include "debug.hpp"
+#include "memory.hpp"
+#include "log.hpp"
+
+
+//  ABOUT
+// Fixed-size, typed pool allocator for objects created on hot paths where 'ALLOCATE'
+//  (malloc) is not allowed. Every 'POOL<T, capacity>' is a single static pool - storage is
+//  reserved at compile-time, nothing is allocated on first use.
+//
+//  - Nodes are handed out first from a small per-thread cache, then from a lock-free
+//     global free-list (Treiber stack with an ABA tag) and finally from never used nodes.
+//  - Nodes freed by a thread land in its cache. A full cache spills into the free-list.
+//     A thread that exits before the program does gives its cache back with 'Detach'.
+//     Caches have no destructor - one would register a thread-exit handler on first use
+//     and that registration allocates (glibc's '__cxa_thread_atexit_impl').
+//  - With 'DEBUG_FLAG_MEMORY' freed nodes are poisoned with 'MEMORY_POOL_POISON'. Writes
+//     after free are reported on the next allocation of that node, double frees on free.
+//  - With 'DEBUG_FLAG_MEMORY' counters of all pools are reported by 'LOGMEMORY'.
+//
+//  'Allocate' returns nullptr when the pool is exhausted.
+//
+
+#ifndef MEMORY_POOL_CACHE
+	#define MEMORY_POOL_CACHE 8 // Nodes cached per thread per pool.
+#endif
+
+#ifndef MEMORY_POOL_POISON
+	#define MEMORY_POOL_POISON 0xDD
+#endif
+
+
+namespace MEMORY::POOLS {
+
+	struct COUNTERS {
+		std::atomic<u64> allocations 	= 0;
+		std::atomic<u64> frees 			= 0;
+		std::atomic<u64> cacheHits 		= 0;
+		std::atomic<u64> exhausted 		= 0;
+		std::atomic<u64> corruptions 	= 0; 	// Writes after free & double frees.
+		std::atomic<u32> inUse 			= 0;
+		std::atomic<u32> peak 			= 0;
+	};
+
+	// Shared by all pools. Updated only with 'DEBUG_FLAG_MEMORY'.
+	COUNTERS counters;
+
+}
+
+
+namespace MEMORY {
+
+	template <class T, u32 capacity>
+	struct POOL {
+
+		static_assert (capacity > 0 && capacity < UINT32_MAX, "Invalid pool capacity.");
+
+		static constexpr u32 EMPTY = UINT32_MAX;
+
+		struct NODE {
+			alignas (T) u8 data [sizeof (T)];
+			std::atomic<u32> next;
+			#if DDEBUG (DEBUG_FLAG_MEMORY)
+				std::atomic<u8> isFree;
+			#endif
+		};
+
+		struct CACHE {
+			u32 indexes [MEMORY_POOL_CACHE];
+			u8 count = 0;
+		};
+
+		static inline NODE nodes [capacity];
+		static inline std::atomic<u64> head 	= EMPTY; 	// (tag << 32) | index
+		static inline std::atomic<u32> fresh 	= 0; 		// Never used nodes start at.
+		static inline thread_local CACHE cache;
+
+
+		static void Push (
+			IN		const u32& 		index
+		) {
+			u64 current = head.load (std::memory_order_relaxed);
+			u64 next;
+
+			do {
+				nodes[index].next.store ((u32)current, std::memory_order_relaxed);
+				next = ((current >> 32) + 1) << 32 | index;
+			} while (!head.compare_exchange_weak (current, next, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		static u32 Pop () {
+			u64 current = head.load (std::memory_order_acquire);
+			u64 next;
+
+			do {
+				const u32 index = (u32)current;
+				if (index == EMPTY) return EMPTY;
+
+				// The tag makes a stale 'next' fail the exchange when the node was reused meanwhile.
+				next = ((current >> 32) + 1) << 32 | nodes[index].next.load (std::memory_order_relaxed);
+			} while (!head.compare_exchange_weak (current, next, std::memory_order_acquire, std::memory_order_acquire));
+
+			return (u32)current;
+		}
+
+		static u32 Take () {
+			if (cache.count) {
+				DEBUG (DEBUG_FLAG_MEMORY) POOLS::counters.cacheHits.fetch_add (1, std::memory_order_relaxed);
+				return cache.indexes[--cache.count];
+			}
+
+			u32 index = Pop ();
+			if (index != EMPTY) return index;
+
+			index = fresh.load (std::memory_order_relaxed);
+			while (index < capacity && !fresh.compare_exchange_weak (index, index + 1, std::memory_order_relaxed));
+
+			return index < capacity ? index : EMPTY;
+		}
+
+
+		template <class... Arguments>
+		static T* Allocate (
+			IN		Arguments&&... 	arguments
+		) {
+			const u32 index = Take ();
+
+			if (index == EMPTY) {
+				DEBUG (DEBUG_FLAG_MEMORY) POOLS::counters.exhausted.fetch_add (1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			NODE& node = nodes[index];
+
+			#if DDEBUG (DEBUG_FLAG_MEMORY)
+				if (node.isFree.exchange (false, std::memory_order_relaxed)) {
+					for (u32 i = 0; i < sizeof (T); ++i) {
+						if (node.data[i] != MEMORY_POOL_POISON) {
+							POOLS::counters.corruptions.fetch_add (1, std::memory_order_relaxed);
+							LOGWARN ("Pool: node %u was written to after it was freed.\n", index);
+							break;
+						}
+					}
+				}
+
+				POOLS::counters.allocations.fetch_add (1, std::memory_order_relaxed);
+				const u32 inUse = POOLS::counters.inUse.fetch_add (1, std::memory_order_relaxed) + 1;
+				u32 peak = POOLS::counters.peak.load (std::memory_order_relaxed);
+				while (inUse > peak && !POOLS::counters.peak.compare_exchange_weak (peak, inUse, std::memory_order_relaxed));
+			#endif
+
+			return new (node.data) T (std::forward<Arguments> (arguments)...);
+		}
+
+		static void Free (
+			INOUT	T* 				object
+		) {
+			if (object == nullptr) return;
+
+			NODE* node = (NODE*)object; // 'data' is the first member.
+			const u32 index = (u32)(node - nodes);
+
+			#if DDEBUG (DEBUG_FLAG_MEMORY)
+				if (node->isFree.exchange (true, std::memory_order_relaxed)) {
+					POOLS::counters.corruptions.fetch_add (1, std::memory_order_relaxed);
+					LOGWARN ("Pool: node %u was freed twice.\n", index);
+					return;
+				}
+			#endif
+
+			object->~T ();
+
+			#if DDEBUG (DEBUG_FLAG_MEMORY)
+				memset (node->data, MEMORY_POOL_POISON, sizeof (T));
+				POOLS::counters.frees.fetch_add (1, std::memory_order_relaxed);
+				POOLS::counters.inUse.fetch_sub (1, std::memory_order_relaxed);
+			#endif
+
+			if (cache.count < MEMORY_POOL_CACHE) cache.indexes[cache.count++] = index;
+			else Push (index);
+		}
+
+		// Gives the calling thread's cached nodes back to the free-list.
+		static void Detach () {
+			while (cache.count) Push (cache.indexes[--cache.count]);
+		}
+
+	};
+
+}
+
+
+#if DDEBUG (DEBUG_FLAG_MEMORY) && DDEBUG (DEBUG_FLAG_LOGGING)
+
+	#undef LOGPOOL
+	#define LOGPOOL() { \
+		LOGINFO ( \
+			"Pools: %" PRIu64 " allocations, %" PRIu64 " frees, %" PRIu64 " cache hits, %u peak in use.\n", \
+			MEMORY::POOLS::counters.allocations.load (), MEMORY::POOLS::counters.frees.load (), \
+			MEMORY::POOLS::counters.cacheHits.load (), MEMORY::POOLS::counters.peak.load () \
+		); \
+		if (MEMORY::POOLS::counters.exhausted.load ()) LOGWARN ("Pools: exhausted %" PRIu64 " times.\n", MEMORY::POOLS::counters.exhausted.load ()); \
+		if (MEMORY::POOLS::counters.corruptions.load ()) LOGWARN ("Pools: %" PRIu64 " corruptions detected.\n", MEMORY::POOLS::counters.corruptions.load ()); \
+	}
+
+#endif
@@ -0,0 +1,81 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <bit>
+#include <string.h>
+//
+#include "types.hpp"
+
+
+//  ABOUT
+// SWAR (SIMD within a register) - decimal digits 8 at a time in a u64. Bytes are loaded
+//  little-endian so the first character is the lowest byte. 'Load' reads 8 bytes, callers
+//  make sure there are 8 to read. Digits are '0'-'9', anything else ends a number.
+//
+
+static_assert (std::endian::native == std::endian::little, "SWAR expects a little-endian target.");
+
+namespace SWAR {
+
+	constexpr u64 ZEROS = 0x3030303030303030; // "00000000"
+
+	u64 Load (
+		IN		const c8* const& 	data
+	) {
+		u64 bytes;
+		memcpy (&bytes, data, sizeof (bytes));
+		return bytes;
+	}
+
+	// Index of the first 'byte', 8 when there is none.
+	u32 Find (
+		IN		const u64& 			bytes,
+		IN		const u8& 			byte
+	) {
+		const u64 low = 0x7F7F7F7F7F7F7F7F;
+		const u64 other = bytes ^ (0x0101010101010101 * byte);
+		const u64 found = ~(((other & low) + low) | other | low);
+		return found == 0 ? 8 : std::countr_zero (found) / 8;
+	}
+
+	// Index of the first byte under 0x20 (ASCII control), 8 when there is none.
+	u32 FindControl (
+		IN		const u64& 			bytes
+	) {
+		const u64 low = 0x7F7F7F7F7F7F7F7F;
+		const u64 found = ~(((bytes & low) + 0x6060606060606060) | bytes | low);
+		return found == 0 ? 8 : std::countr_zero (found) / 8;
+	}
+
+	// Leading digits, 0-8. A byte is a digit when its high nibble is 3 and it still is
+	//  after adding 6. Carries out of a byte only come from a non-digit below it.
+	u32 CountDigits (
+		IN		const u64& 			bytes
+	) {
+		const u64 high = 0xF0F0F0F0F0F0F0F0;
+		const u64 nonDigits = ((bytes & high) | (((bytes + 0x0606060606060606) & high) >> 4)) ^ 0x3333333333333333;
+		return nonDigits == 0 ? 8 : std::countr_zero (nonDigits) / 8;
+	}
+
+	// The leading 'count' (1-8) digits as a number.
+	u32 GetDigits (
+		IN		const u64& 			bytes,
+		IN		const u32& 			count
+	) {
+		const u64 mask = 0x000000FF000000FF;
+		const u64 hundreds = 0x000F424000000064; 	// 100 + (1000000 << 32)
+		const u64 ones = 0x0000271000000001; 		// 1 + (10000 << 32)
+
+		// Digits go to the top bytes with '0's before them, whatever followed is shifted out.
+		const u32 shift = (8 - count) * 8;
+		u64 digits = shift == 0 ? bytes : (bytes << shift) | (ZEROS >> (64 - shift));
+
+		digits -= ZEROS;
+		digits = (digits * 10) + (digits >> 8); 	// Pairs.
+		digits = (((digits & mask) * hundreds) + (((digits >> 16) & mask) * ones)) >> 32;
+
+		return (u32)digits;
+	}
+
+}
@@ -0,0 +1,229 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <bit>
+//
+#include "types.hpp"
+
+
+//  ABOUT
+// Hierarchical timer wheel of 'capacity' timers keyed on u64 nanosecond deadlines. Timers
+//  are identified by their index, a timer is either scheduled once or not at all.
+//
+//  Time is cut into ticks of 2^'TIMER_WHEEL_TICK' ns. Level 0 has a slot per tick, every
+//  next level a slot per 64 slots of the previous one. A timer is put on the lowest level
+//  where its tick and the current tick share all higher digits, so it's moved (cascaded) one
+//  level down each time the current tick reaches its slot - at most 'LEVELS' times in its
+//  life. Insert and remove are O(1), 'Expire' is O(1) per timer and per tick passed.
+//
+//  Slots are intrusive, doubly linked lists of indexes, each level keeps a bitmask of its
+//  non-empty slots - 'GetNext' finds the nearest one with a count of trailing zeros.
+//  Timers fire at their exact deadline, not at their tick - within the current tick only
+//  the due ones are taken. Deadlines further than 4 levels (~18 minutes) wait in the last
+//  slot and are put back until due. Nothing is allocated. Not thread-safe.
+//
+
+#ifndef TIMER_WHEEL_TICK
+	#define TIMER_WHEEL_TICK 16 // 2^16 ns, ~65.5 us
+#endif
+
+
+namespace TIMER {
+
+	template <u32 capacity>
+	struct WHEEL {
+
+		static_assert (capacity > 0 && capacity < UINT32_MAX, "Invalid timer wheel capacity.");
+
+		static constexpr u32 NONE 		= UINT32_MAX;
+		static constexpr u8 BITS 		= 6;
+		static constexpr u8 SLOTS 		= 1 << BITS;
+		static constexpr u8 LEVELS 		= 4;
+
+		struct NODE {
+			u64 deadline;
+			u32 next;
+			u32 previous;
+			u16 slot; 		// level * SLOTS + index, 'LEVELS * SLOTS' when not scheduled
+		};
+
+		NODE timers [capacity];
+		u32 heads [LEVELS * SLOTS];
+		u64 occupied [LEVELS]; 		// Bit per non-empty slot.
+		u64 current; 				// Tick, every earlier one was expired.
+		u32 count;
+
+
+		void Create (
+			IN		const u64& 		now
+		) {
+			for (u32 i = 0; i < capacity; ++i) timers[i].slot = LEVELS * SLOTS;
+			for (u32 i = 0; i < LEVELS * SLOTS; ++i) heads[i] = NONE;
+			for (u8 i = 0; i < LEVELS; ++i) occupied[i] = 0;
+
+			current = now >> TIMER_WHEEL_TICK;
+			count = 0;
+		}
+
+		bool IsScheduled (
+			IN		const u32& 		index
+		) const {
+			return timers[index].slot != LEVELS * SLOTS;
+		}
+
+		void Link (
+			IN		const u32& 		index
+		) {
+			NODE& timer = timers[index];
+
+			u64 tick = timer.deadline >> TIMER_WHEEL_TICK;
+			if (tick < current) tick = current; // Already due.
+
+			// Further than the last level reaches. Waits at its end.
+			if ((tick ^ current) >> (BITS * LEVELS)) tick = current | ((1ull << (BITS * LEVELS)) - 1);
+
+			u8 level = 0;
+			for (; level < LEVELS - 1 && (tick ^ current) >> (BITS * (level + 1)); ++level);
+
+			const u8 digit = (tick >> (BITS * level)) & (SLOTS - 1);
+			const u16 slot = level * SLOTS + digit;
+			u32& head = heads[slot];
+
+			timer.slot 		= slot;
+			timer.previous 	= NONE;
+			timer.next 		= head;
+
+			if (head != NONE) timers[head].previous = index;
+			head = index;
+			occupied[level] |= 1ull << digit;
+		}
+
+		void Unlink (
+			IN		const u32& 		index
+		) {
+			NODE& timer = timers[index];
+			const u16 slot = timer.slot;
+
+			if (timer.previous != NONE) timers[timer.previous].next = timer.next;
+			else heads[slot] = timer.next;
+
+			if (timer.next != NONE) timers[timer.next].previous = timer.previous;
+			if (heads[slot] == NONE) occupied[slot / SLOTS] &= ~(1ull << (slot % SLOTS));
+
+			timer.slot = LEVELS * SLOTS;
+		}
+
+		// Schedules or reschedules.
+		void Insert (
+			IN		const u32& 		index,
+			IN		const u64& 		deadline
+		) {
+			if (IsScheduled (index)) Unlink (index);
+			else ++count;
+
+			timers[index].deadline = deadline;
+			Link (index);
+		}
+
+		void Remove (
+			IN		const u32& 		index
+		) {
+			if (!IsScheduled (index)) return;
+
+			Unlink (index);
+			--count;
+		}
+
+		// Moves the slot the current tick reached on 'level' one level down.
+		void Cascade (
+			IN		const u8& 		level
+		) {
+			const u16 slot = level * SLOTS + ((current >> (BITS * level)) & (SLOTS - 1));
+			u32 index = heads[slot];
+
+			heads[slot] = NONE;
+			occupied[level] &= ~(1ull << (slot % SLOTS));
+
+			while (index != NONE) {
+				const u32 next = timers[index].next;
+				Link (index);
+				index = next;
+			}
+		}
+
+		// Calls 'function (index)' for every timer due at 'now', removed before the call - it
+		//  may insert it again.
+		template <class Function>
+		void Expire (
+			IN		const u64& 		now,
+			IN		Function 		function
+		) {
+			const u64 target = now >> TIMER_WHEEL_TICK;
+
+			for (;;) {
+				for (u8 level = LEVELS - 1; level > 0; --level) { // Higher levels first, they cascade into lower ones.
+					if ((current & ((1ull << (BITS * level)) - 1)) == 0) Cascade (level);
+				}
+
+				const u16 slot = current & (SLOTS - 1);
+				u32 index = heads[slot];
+
+				while (index != NONE) {
+					const u32 next = timers[index].next;
+
+					if (timers[index].deadline <= now) {
+						Unlink (index);
+						--count;
+						function (index);
+					} else if (current < target) { // Waited in the last slot.
+						Unlink (index);
+						Link (index);
+					}
+
+					index = next;
+				}
+
+				if (current == target) return;
+				++current;
+
+				// Nothing on level 0 until the next cascade, skip to it.
+				if (occupied[0] == 0) {
+					const u64 cascade = (current + SLOTS - 1) & ~(u64)(SLOTS - 1);
+					current = cascade < target ? cascade : target;
+				}
+			}
+		}
+
+		// Nanoseconds when something is due - a timer's deadline or a cascade that might bring
+		//  one. UINT64_MAX when empty.
+		u64 GetNext () const {
+			if (count == 0) return UINT64_MAX;
+
+			const u64 ahead = occupied[0] & (~0ull << (current & (SLOTS - 1)));
+
+			if (ahead) { // Exact deadline within the nearest slot.
+				u64 deadline = UINT64_MAX;
+
+				for (u32 index = heads[std::countr_zero (ahead)]; index != NONE; index = timers[index].next) {
+					if (timers[index].deadline < deadline) deadline = timers[index].deadline;
+				}
+
+				return deadline;
+			}
+
+			for (u8 level = 1; level < LEVELS; ++level) {
+				const u8 shift = BITS * level;
+				const u64 later = occupied[level] & (~0ull << ((current >> shift) & (SLOTS - 1)));
+				if (later == 0) continue;
+
+				const u64 tick = (current >> (shift + BITS) << BITS | std::countr_zero (later)) << shift;
+				return tick << TIMER_WHEEL_TICK;
+			}
+
+			return (current + 1) << TIMER_WHEEL_TICK; // Waiting at the end of the last level.
+		}
+
+	};
+
+}
@@ -24,4 +24,8 @@ namespace TIMESTAMP {
 		return elapsed.count ();
 	}
 
+	[[nodiscard]] u64 GetNanoseconds (IN const Timestamp& timestamp) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds> (timestamp.time_since_epoch ()).count ();
+	}
+
 }
@@ -0,0 +1,128 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include "debug.hpp"
+
+
+//  ABOUT
+// Binary event tracing. Compiled in only with 'DEBUG_FLAG_TRACING' set in 'DEBUG_TYPE'.
+//  Every thread records fixed-size events (nanosecond timestamp, type, value) into its
+//  own preallocated buffer - no locks, no allocations, no formatting. 'TRACEDUMP' writes
+//  all buffers into a single file at exit. Event types are defined by the application.
+//
+//  FILE LAYOUT (little-endian)
+//  - HEADER { magic 'MTRC', version, threads, events }
+//  - EVENT [events] - grouped by thread, in recording order.
+//
+
+#ifndef TRACE_SIZE
+	#define TRACE_SIZE 16384 // Events per thread.
+#endif
+
+#ifndef TRACE_THREADS
+	#define TRACE_THREADS 8
+#endif
+
+#define TRACE_MAGIC 	0x4352544D // 'MTRC'
+#define TRACE_VERSION 	1
+
+
+namespace TRACE {
+
+	struct HEADER {
+		u32 magic;
+		u32 version;
+		u32 threads;
+		u32 events;
+	};
+
+	struct EVENT {
+		u64 time; 		// nanoseconds
+		u16 type;
+		u16 thread;
+		u32 value;
+	};
+
+	static_assert (sizeof (EVENT) == 16);
+
+}
+
+
+#if DDEBUG (DEBUG_FLAG_TRACING)
+
+	#include <atomic>
+	#include <stdio.h>
+	//
+	#include "timestamp.hpp"
+	#include "log.hpp"
+
+	namespace TRACE {
+
+		EVENT events [TRACE_THREADS][TRACE_SIZE];
+		u32 counts [TRACE_THREADS] {};
+		std::atomic<u32> overflows = 0;
+		std::atomic<u16> threadsCounter = 0;
+
+		thread_local u16 thread = UINT16_MAX;
+
+		void RecordAt (
+			IN		const u64& 		time,
+			IN		const u16& 		type,
+			IN		const u32& 		value
+		) {
+			if (thread == UINT16_MAX) thread = threadsCounter.fetch_add (1, std::memory_order_relaxed);
+
+			if (thread >= TRACE_THREADS || counts[thread] == TRACE_SIZE) {
+				overflows.fetch_add (1, std::memory_order_relaxed);
+				return;
+			}
+
+			EVENT& event = events[thread][counts[thread]++];
+			event.time = time;
+			event.type = type;
+			event.thread = thread;
+			event.value = value;
+		}
+
+		void Record (
+			IN		const u16& 		type,
+			IN		const u32& 		value
+		) {
+			RecordAt (TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ()), type, value);
+		}
+
+		// Call only after all recording threads have been joined.
+		void Dump (
+			IN		const c8* const& 	filename
+		) {
+			FILE* file = fopen (filename, "wb");
+			if (file == nullptr) { LOGWARN ("Could not open trace file '%s'.\n", filename); return; }
+
+			u16 threads = threadsCounter.load ();
+			if (threads > TRACE_THREADS) threads = TRACE_THREADS;
+
+			HEADER header { TRACE_MAGIC, TRACE_VERSION, threads, 0 };
+			for (u16 i = 0; i < threads; ++i) header.events += counts[i];
+
+			fwrite (&header, sizeof (header), 1, file);
+			for (u16 i = 0; i < threads; ++i) fwrite (events[i], sizeof (EVENT), counts[i], file);
+			fclose (file);
+
+			LOGINFO ("Trace: %u events from %u threads written to '%s'.\n", header.events, threads, filename);
+			if (overflows.load ()) LOGWARN ("Trace: %u events did not fit.\n", overflows.load ());
+		}
+
+	}
+
+	#define TRACEEVENT(type, value) TRACE::Record (type, value)
+	#define TRACEEVENTAT(time, type, value) TRACE::RecordAt (time, type, value)
+	#define TRACEDUMP(filename) TRACE::Dump (filename)
+
+#else
+
+	#define TRACEEVENT(type, value) {} // dummy
+	#define TRACEEVENTAT(time, type, value) {} // dummy
+	#define TRACEDUMP(filename) {} // dummy
+
+#endif
@@ -50,7 +50,7 @@ class w8 {
 				} base;
 			} real;
 
-			const r32 STEP6 = 1.0f / 64.0f;
+			[[maybe_unused]] const r32 STEP6 = 1.0f / 64.0f; // Not with 'WAVE_LUT_OPT'.
 
 			#ifdef WAVE_NO_OPT
 				if (base.bitmask.phase) { real.value = (~base.bitmask.wave + 64 + 1) * STEP6; } // 65 -> 127
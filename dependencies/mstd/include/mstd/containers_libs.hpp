@@ -9,6 +9,11 @@
 
 #pragma once
 #include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <type_traits>
+#include <functional>
 #include <unordered_map>
 #include <initializer_list>
 #include <stdexcept>
\ No newline at end of file
@@ -9,6 +9,7 @@
 
 #pragma once
 #include "string_types.hpp"
+#include "swar_digits.hpp"
 
 namespace mstd {
 	static bool isstrhex(const std::string& str) {
@@ -78,11 +79,7 @@ namespace mstd {
 			if (i == str.size()) return false;
 		}
 
-		for (; i != str.size(); ++i) {
-			if (str[i] < '0' || str[i] > '9') return false;
-		}
-
-		return true;
+		return _skip_digits(str, i) == str.size();
 	}
 
 	static bool isstrunum(const std::string& str) {
@@ -108,11 +105,7 @@ namespace mstd {
 			if (i == str.size()) return false;
 		}
 
-		for (; i != str.size(); ++i) {
-			if (str[i] < '0' || str[i] > '9') return false;
-		}
-
-		return true;
+		return _skip_digits(str, i) == str.size();
 	}
 
 	static bool isstrfp(const std::string& str) {
@@ -124,19 +117,16 @@ namespace mstd {
 			if (i == str.size()) return false;
 		}
 
-		while (str[i] >= '0' && str[i] <= '9') {
-			++i;
-			if (i == str.size()) return true;
-		}
+		i = _skip_digits(str, i);
+		if (i == str.size()) return true;
 
 		if (str[i] == '.') {
 			++i;
 			if (i == str.size()) return false;
 
-			while (str[i] >= '0' && str[i] <= '9') {
-				++i;
-				if (i == str.size()) return true;
-			}
+			const size_t fraction_begin = i;
+			i = _skip_digits(str, i);
+			return i == str.size() && i != fraction_begin;
 		}
 
 		return false;
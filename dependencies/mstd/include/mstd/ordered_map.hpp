@@ -11,24 +11,166 @@
 #include "containers_libs.hpp"
 
 namespace mstd {
+    // Elements are kept in insertion order in a dense vector. Keys are stored only there,
+    // lookups go through an open-addressing (linear probing) table of indexes into that vector.
+    // - insert at end() and erase are O(1) amortized, nothing after them is reindexed,
+    // - erase leaves a tombstone in both the vector and the table, they are compacted
+    //   lazily once tombstones outnumber live elements (or on the next positional insert),
+    // - insert in the middle (or moving an existing key) shifts the vector and rebuilds
+    //   the table from cached hashes, O(n) without rehashing any key.
+    // Iterators skip tombstones and are invalidated by insert and erase.
     template <class Key, class T>
     class ordered_map {
+    private:
+        struct _entry {
+            std::pair<Key, T> value;
+            size_t hash;
+            bool alive;
+        };
+
+        static constexpr size_t _empty_slot = SIZE_MAX;
+        static constexpr size_t _dead_slot = SIZE_MAX - 1;
+        static constexpr size_t _min_slots = 8;
+
+        template <bool _is_const>
+        class _iterator {
+        private:
+            using _entries_t = std::conditional_t<_is_const, const std::vector<_entry>, std::vector<_entry>>;
+
+            _entries_t* _entries = nullptr;
+            size_t _index = 0;
+
+            friend class ordered_map;
+            friend class _iterator<!_is_const>;
+
+            void _skip_forward() {
+                while (_index != _entries->size() && !(*_entries)[_index].alive) ++_index;
+            }
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::pair<Key, T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<_is_const, const value_type*, value_type*>;
+            using reference = std::conditional_t<_is_const, const value_type&, value_type&>;
+
+            _iterator() = default;
+
+            _iterator(_entries_t* entries, const size_t& index) : _entries(entries), _index(index) {
+                _skip_forward();
+            }
+
+            template <bool _other_const, class = std::enable_if_t<_is_const && !_other_const>>
+            _iterator(const _iterator<_other_const>& other) : _entries(other._entries), _index(other._index) {}
+
+            reference operator*() const { return (*_entries)[_index].value; }
+            pointer operator->() const { return &(*_entries)[_index].value; }
+
+            _iterator& operator++() {
+                ++_index;
+                _skip_forward();
+                return *this;
+            }
+
+            _iterator operator++(int) {
+                _iterator old = *this;
+                ++(*this);
+                return old;
+            }
+
+            _iterator& operator--() {
+                do --_index; while (!(*_entries)[_index].alive);
+                return *this;
+            }
+
+            _iterator operator--(int) {
+                _iterator old = *this;
+                --(*this);
+                return old;
+            }
+
+            bool operator==(const _iterator& other) const { return _index == other._index; }
+            bool operator!=(const _iterator& other) const { return _index != other._index; }
+        };
+
     public:
         using key_type = Key;
         using value_type = T;
-        using iterator = std::vector<std::pair<Key, T>>::iterator;
-        using const_iterator = std::vector<std::pair<Key, T>>::const_iterator;
-        using reverse_iterator = std::vector<std::pair<Key, T>>::reverse_iterator;
-        using const_reverse_iterator = std::vector<std::pair<Key, T>>::const_reverse_iterator;
+        using iterator = _iterator<false>;
+        using const_iterator = _iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     private:
-        std::vector<std::pair<Key, T>> _ordered_elements;
-        std::unordered_map<Key, size_t> _elements_map;
+        std::vector<_entry> _entries;
+        std::vector<size_t> _slots;
+        size_t _size = 0;
+        size_t _dead_slots = 0;
+
+        size_t _mask() const { return _slots.size() - 1; }
+
+        // Returns the slot holding 'key' or _empty_slot.
+        size_t _find_slot(const Key& key, const size_t& hash) const {
+            if (_slots.empty()) return _empty_slot;
+
+            for (size_t slot = hash & _mask();; slot = (slot + 1) & _mask()) {
+                const size_t& index = _slots[slot];
+                if (index == _empty_slot) return _empty_slot;
+                if (index == _dead_slot) continue;
+
+                const _entry& entry = _entries[index];
+                if (entry.hash == hash && entry.value.first == key) return slot;
+            }
+        }
+
+        void _place(const size_t& index) {
+            size_t slot = _entries[index].hash & _mask();
+            while (_slots[slot] != _empty_slot) slot = (slot + 1) & _mask();
+            _slots[slot] = index;
+        }
 
-        void _update_indexes(const size_t& from) {
-            for (size_t i = from; i != _ordered_elements.size(); ++i) {
-                _elements_map[_ordered_elements[i].first] = i;
+        // Drops dead entries and rebuilds the table with 'slots_count' slots (power of 2).
+        void _rebuild(const size_t& slots_count) {
+            if (_entries.size() != _size) {
+                std::erase_if(_entries, [](const _entry& entry) { return !entry.alive; });
             }
+
+            _slots.assign(slots_count, _empty_slot);
+            _dead_slots = 0;
+
+            for (size_t i = 0; i != _entries.size(); ++i) _place(i);
+        }
+
+        // Smallest power of 2 keeping 'count' elements at most 3/4 of the table. Never shrinks.
+        size_t _slots_for(const size_t& count) const {
+            size_t slots_count = _slots.size() < _min_slots ? _min_slots : _slots.size();
+            while (count * 4 > slots_count * 3) slots_count *= 2;
+            return slots_count;
+        }
+
+        // Keeps the table at most 3/4 full, counting tombstones.
+        void _reserve_slot() {
+            if ((_size + _dead_slots + 1) * 4 > _slots.size() * 3) _rebuild(_slots_for(_size + 1));
+        }
+
+        void _compact() {
+            if (_entries.size() != _size) _rebuild(_slots.size());
+        }
+
+        void _append(const std::pair<Key, T>& value, const size_t& hash) {
+            _reserve_slot();
+            _entries.push_back({ value, hash, true });
+            _place(_entries.size() - 1);
+            ++_size;
+        }
+
+        // Position of 'where' among live elements.
+        size_t _live_offset(const const_iterator& where) const {
+            if (_entries.size() == _size) return where._index;
+
+            size_t offset = 0;
+            for (size_t i = 0; i != where._index; ++i) offset += _entries[i].alive;
+            return offset;
         }
 
     public:
@@ -38,9 +180,8 @@ namespace mstd {
             insert(this->end(), init.begin(), init.end());
         }
 
-        ordered_map(const ordered_map& other) {
-            insert(this->end(), other.begin(), other.end());
-        }
+        ordered_map(const ordered_map& other) = default;
+        ordered_map& operator=(const ordered_map& other) = default;
 
         template<class _Iter>
         ordered_map(const _Iter& begin, const _Iter& end) {
@@ -48,61 +189,76 @@ namespace mstd {
         }
 
         void insert(const const_iterator& where, const std::pair<Key, T>& value) {
-            if (_elements_map.contains(value.first)) {
-                // move key to where and change value (after update iterators in map)
-                
-                size_t where_offset = where - _ordered_elements.begin();
-                const size_t& elem_offset = _elements_map[value.first];
+            const size_t hash = std::hash<Key>{}(value.first);
 
-                // remove elem
-                _ordered_elements.erase(_ordered_elements.begin() + elem_offset);
+            if (where._index == _entries.size() && _find_slot(value.first, hash) == _empty_slot) {
+                _append(value, hash);
+                return;
+            }
 
-                // insert new elem
-                _ordered_elements.insert(_ordered_elements.begin() + where_offset, value);
+            // Positional insert or move. Dense indexes have to match positions.
+            size_t where_offset = _live_offset(where);
+            _compact();
 
-                // update iterators in map
-                if (where_offset > elem_offset) _update_indexes(elem_offset);
-                else _update_indexes(where_offset);
+            const size_t slot = _find_slot(value.first, hash);
+            if (slot != _empty_slot) {
+                // move key to where and change value
+                _entries.erase(_entries.begin() + _slots[slot]);
+                if (where_offset > _entries.size()) where_offset = _entries.size();
+                _entries.insert(_entries.begin() + where_offset, { value, hash, true });
             }
             else {
-                // insert at where and set value (after update iterators in map)
-                size_t where_offset = where - _ordered_elements.begin();
-
-                _ordered_elements.insert(where, value);
-
-                _update_indexes(where_offset);
+                _entries.insert(_entries.begin() + where_offset, { value, hash, true });
+                ++_size;
             }
+
+            _rebuild(_slots_for(_size));
         }
 
         template<class _Iter>
         void insert(const const_iterator& where, const _Iter& begin, const _Iter& end) {
-            size_t curr_where_offset = where - _ordered_elements.begin();
+            size_t curr_where_offset = _live_offset(where);
+            const bool at_end = where._index == _entries.size();
+
             for (_Iter iter = begin; iter != end; ++iter, ++curr_where_offset) {
-                insert(_ordered_elements.begin() + curr_where_offset, *iter);
+                if (at_end) {
+                    insert(this->cend(), *iter);
+                }
+                else {
+                    _compact();
+                    insert(const_iterator(&_entries, curr_where_offset), *iter);
+                }
             }
         }
 
         void erase(const Key& key) {
-            if (_elements_map.contains(key)) {
-                size_t element_offset = _elements_map[key];
+            const size_t slot = _find_slot(key, std::hash<Key>{}(key));
+            if (slot == _empty_slot) return;
 
-                _ordered_elements.erase(_ordered_elements.begin() + element_offset);
-                _elements_map.erase(key);
+            _entries[_slots[slot]].alive = false;
+            _slots[slot] = _dead_slot;
+            ++_dead_slots;
+            --_size;
 
-                _update_indexes(element_offset);
-            }
+            if (_size == 0) clear();
+            else if (_entries.size() - _size > _size) _rebuild(_slots.size());
         }
 
         T& at(const Key& key) {
-            if (!_elements_map.contains(key)) {
-                insert(this->end(), { key, T() });
+            const size_t hash = std::hash<Key>{}(key);
+            size_t slot = _find_slot(key, hash);
+
+            if (slot == _empty_slot) {
+                _append({ key, T() }, hash);
+                return _entries.back().value.second;
             }
-            return _ordered_elements[_elements_map[key]].second;
+            return _entries[_slots[slot]].value.second;
         }
 
         const T& at(const Key& key) const {
-            if (_elements_map.contains(key)) {
-                return _ordered_elements.at(_elements_map.at(key)).second;
+            const size_t slot = _find_slot(key, std::hash<Key>{}(key));
+            if (slot != _empty_slot) {
+                return _entries[_slots[slot]].value.second;
             }
             else {
                 throw std::out_of_range("Key not found.");
@@ -110,44 +266,46 @@ namespace mstd {
         }
 
         size_t size() const {
-            return _elements_map.size();
+            return _size;
         }
 
         bool empty() const {
-            return _elements_map.empty();
+            return _size == 0;
         }
 
         bool contains(const Key& key) const {
-            return _elements_map.contains(key);
+            return _find_slot(key, std::hash<Key>{}(key)) != _empty_slot;
         }
 
         iterator find(const Key& key) {
-            auto it = _elements_map.find(key);
-            return it != _elements_map.end() ? _ordered_elements.begin() + it->second : _ordered_elements.end();
+            const size_t slot = _find_slot(key, std::hash<Key>{}(key));
+            return slot != _empty_slot ? iterator(&_entries, _slots[slot]) : end();
         }
 
         const_iterator find(const Key& key) const {
-            auto it = _elements_map.find(key);
-            return it != _elements_map.end() ? _ordered_elements.begin() + it->second : _ordered_elements.end();
+            const size_t slot = _find_slot(key, std::hash<Key>{}(key));
+            return slot != _empty_slot ? const_iterator(&_entries, _slots[slot]) : end();
         }
 
         void clear() {
-            _elements_map.clear();
-            _ordered_elements.clear();
-        }
-
-        iterator begin() { return _ordered_elements.begin(); }
-        iterator end() { return _ordered_elements.end(); }
-        const_iterator begin() const { return _ordered_elements.cbegin(); }
-        const_iterator end() const { return _ordered_elements.cend(); }
-        const_iterator cbegin() const { return _ordered_elements.cbegin(); }
-        const_iterator cend() const { return _ordered_elements.cend(); }
-        reverse_iterator rbegin() { return _ordered_elements.rbegin(); }
-        reverse_iterator rend() { return _ordered_elements.rend(); }
-        const_reverse_iterator rbegin() const { return _ordered_elements.crbegin(); }
-        const_reverse_iterator rend() const { return _ordered_elements.crend(); }
-        const_reverse_iterator crbegin() const { return _ordered_elements.crbegin(); }
-        const_reverse_iterator crend() const { return _ordered_elements.crend(); }
+            _entries.clear();
+            _slots.clear();
+            _size = 0;
+            _dead_slots = 0;
+        }
+
+        iterator begin() { return iterator(&_entries, 0); }
+        iterator end() { return iterator(&_entries, _entries.size()); }
+        const_iterator begin() const { return const_iterator(&_entries, 0); }
+        const_iterator end() const { return const_iterator(&_entries, _entries.size()); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const { return rbegin(); }
+        const_reverse_iterator crend() const { return rend(); }
 
         T& operator[](const Key& key) {
             return at(key);
@@ -158,23 +316,11 @@ namespace mstd {
         }
 
         bool operator==(const ordered_map<Key, T>& other) const {
-            /*if (this->size() != other.size()) {
-                return false;
-            }
-            for (const std::pair<Key, T>& element : *this) {
-                if (!other.contains(element.first)) {
-                    return false;
-                }
-                if (other[element.first] != element.second) {
-                    return false;
-                }
-            }
-            return true;*/
-            return _ordered_elements == other._ordered_elements && _elements_map == other._elements_map;
+            return _size == other._size && std::equal(begin(), end(), other.begin());
         }
 
         bool operator!=(const ordered_map<Key, T>& other) const {
-            return _ordered_elements != other._ordered_elements || _elements_map != other._elements_map;
+            return !(*this == other);
         }
     };
-}
\ No newline at end of file
+}
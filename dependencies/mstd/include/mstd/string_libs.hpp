@@ -9,4 +9,9 @@
 
 #pragma once
 #include <string>
-#include <algorithm>
\ No newline at end of file
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
\ No newline at end of file
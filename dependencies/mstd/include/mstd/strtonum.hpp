@@ -10,6 +10,7 @@
 #pragma once
 #include "string_types.hpp"
 #include "overflow_operations.hpp"
+#include "swar_digits.hpp"
 
 namespace mstd {
 	// 0x0F...
@@ -159,6 +160,28 @@ namespace mstd {
 		}
 
 		num = 0;
+
+		// 8 digits at a time. Smaller types overflow on 8 digits anyway, leave them to the loop below.
+		// So do unsigned types - the 'sign' doesn't wrap the same way per chunk as per digit.
+		if constexpr (std::is_signed_v<_SN> && sizeof(_SN) >= sizeof(uint32_t)) {
+			while (i + 8 <= str.size()) {
+				const uint64_t chunk = _swar_load8(str.data() + i);
+				if (!_swar_is_eight_digits(chunk)) break;
+
+				if (mul_overflow(num, static_cast<_SN>(100000000), num)) {
+					return false;
+				}
+				if (add_overflow(num, sign * static_cast<_SN>(_swar_parse_eight_digits(chunk)), num)) {
+					return false;
+				}
+
+				i += 8;
+				if (i == str.size()) {
+					return true;
+				}
+			}
+		}
+
 		while (str[i] >= '0' && str[i] <= '9') {
 			if (mul_overflow(num, 10, num)) {
 				return false;
@@ -202,6 +225,28 @@ namespace mstd {
 		}
 
 		num = 0;
+
+		// 8 digits at a time. Smaller types overflow on 8 digits anyway, leave them to the loop below.
+		// So do signed types - '10u' makes the per-digit checks unsigned and a chunk wouldn't fail the same way.
+		if constexpr (std::is_unsigned_v<_UN> && sizeof(_UN) >= sizeof(uint32_t)) {
+			while (i + 8 <= str.size()) {
+				const uint64_t chunk = _swar_load8(str.data() + i);
+				if (!_swar_is_eight_digits(chunk)) break;
+
+				if (mul_overflow(num, static_cast<_UN>(100000000u), num)) {
+					return false;
+				}
+				if (add_overflow(num, static_cast<_UN>(_swar_parse_eight_digits(chunk)), num)) {
+					return false;
+				}
+
+				i += 8;
+				if (i == str.size()) {
+					return true;
+				}
+			}
+		}
+
 		while (str[i] >= '0' && str[i] <= '9') {
 			if (mul_overflow(num, 10u, num)) {
 				return false;
@@ -219,45 +264,133 @@ namespace mstd {
 		return false;
 	}
 
+	// Digit by digit. Used in constant evaluation and when the value doesn't fit the type.
+	template<class _FP, std::enable_if_t<std::is_floating_point_v<_FP>, bool> = true>
+	static constexpr _FP _strtofp_slow(const std::string& str, size_t i) {
+		_FP num = 0;
+
+		while (str[i] >= '0' && str[i] <= '9') {
+			num *= 10;
+			num += str[i] - '0';
+
+			++i;
+			if (i == str.size()) return num;
+		}
+
+		++i; // '.'
+
+		_FP decimal = 0.1;
+		while (i != str.size()) {
+			num += decimal * (str[i] - '0');
+			decimal *= 0.1;
+			++i;
+		}
+
+		return num;
+	}
+
+	// Accumulates the digits starting at 'i' into 'mantissa' and counts them into 'digits'.
+	// Past 19 digits in total only counting continues ('mantissa' is no longer valid).
+	// Returns the index of the first non-digit.
+	static constexpr size_t _accumulate_digits(const std::string& str, size_t i, uint64_t& mantissa, size_t& digits) {
+		constexpr uint32_t powers[] { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+
+		while (digits + 8 <= 19) {
+			const uint64_t chunk = _swar_load_tail(str, i);
+			const size_t count = _swar_count_digits(chunk);
+			if (count == 0) return i;
+
+			mantissa = mantissa * powers[count] + _swar_parse_digits(chunk, count);
+			i += count;
+			digits += count;
+
+			if (count != 8) return i;
+		}
+
+		for (; i != str.size() && str[i] >= '0' && str[i] <= '9'; ++i, ++digits) {
+			if (digits < 19) mantissa = mantissa * 10 + (str[i] - '0');
+		}
+
+		return i;
+	}
+
 	// ((+|-)* 12.22)
+	// Up to 19 significant digits whose mantissa and power of 10 are exact in '_FP' are
+	// computed with a single division (correctly rounded), everything else goes to 'std::from_chars'.
 	template<class _FP, std::enable_if_t<std::is_floating_point_v<_FP>, bool> = true>
 	static constexpr bool strtofp(const std::string& str, _FP& num) {
 		if (str.size() == 0) return false;
 
 		size_t i = 0;
 
-		_FP sign = 1;
+		bool is_negative = false;
 		while (str[i] == '-' || str[i] == '+') {
-			if (str[i] == '-') sign *= -1;
-			
+			if (str[i] == '-') is_negative = !is_negative;
+
 			++i;
 			if (i == str.size()) return false;
 		}
 
-		num = 0;
-		
-		while (str[i] >= '0' && str[i] <= '9') {
-			num *= 10;
-			num += str[i] - '0';
+		const size_t integer_begin = i;
+		uint64_t mantissa = 0;
+		size_t digits = 0;
+		size_t exponent = 0;
 
-			++i;
-			if (i == str.size()) return true;
-		}
+		// Up to 7 digits on either side of the '.' - a chunk each, no loops. Longer runs are accumulated.
+		constexpr uint32_t chunk_powers[] { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
 
-		if (str[i] == '.') {
-			++i;
-			if (i == str.size()) return false;
+		const uint64_t integer_chunk = _swar_load_tail(str, i);
+		const size_t integer_count = _swar_count_digits(integer_chunk);
+		const size_t point = i + integer_count;
+		const uint64_t fraction_chunk = point + 1 < str.size() ? _swar_load_tail(str, point + 1) : 0;
+		const size_t fraction_count = _swar_count_digits(fraction_chunk);
 
-			_FP decimal = 0.1;
-			while (str[i] >= '0' && str[i] <= '9') {
-				num += decimal * (str[i] - '0');
-				decimal *= 0.1;
+		if (integer_count != 8 && fraction_count != 8) {
+			if (point != str.size()) {
+				if (str[point] != '.' || fraction_count == 0 || point + 1 + fraction_count != str.size()) return false;
+			}
+
+			mantissa = static_cast<uint64_t>(_swar_parse_digits(integer_chunk, integer_count)) * chunk_powers[fraction_count] +
+				_swar_parse_digits(fraction_chunk, fraction_count);
+			digits = integer_count + fraction_count;
+			exponent = fraction_count;
+		}
+		else {
+			i = _accumulate_digits(str, i, mantissa, digits);
+
+			if (i != str.size()) {
+				if (str[i] != '.') return false;
 
 				++i;
-				if (i == str.size()) return true;
+				if (i == str.size()) return false;
+
+				const size_t integer_digits = digits;
+				i = _accumulate_digits(str, i, mantissa, digits);
+				exponent = digits - integer_digits;
+
+				if (i != str.size() || exponent == 0) return false;
 			}
 		}
 
-		return false;
+		constexpr uint64_t max_mantissa = uint64_t(1) << std::numeric_limits<_FP>::digits;
+		constexpr size_t max_exponent = std::numeric_limits<_FP>::digits >= 53 ? 22 : 10;
+		constexpr double powers[] { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+		_FP value;
+
+		if (digits <= 19 && mantissa <= max_mantissa && exponent <= max_exponent) {
+			value = static_cast<_FP>(mantissa) / static_cast<_FP>(powers[exponent]);
+		}
+		else if (std::is_constant_evaluated()) {
+			value = _strtofp_slow<_FP>(str, integer_begin);
+		}
+		else {
+			const std::from_chars_result result = std::from_chars(str.data() + integer_begin, str.data() + str.size(), value);
+			if (result.ec != std::errc()) value = _strtofp_slow<_FP>(str, integer_begin);
+		}
+
+		num = is_negative ? -value : value;
+		return true;
 	}
-}
\ No newline at end of file
+}
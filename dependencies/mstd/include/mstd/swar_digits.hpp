@@ -0,0 +1,92 @@
+/*
+ * mstd - Maipa's Standard Library
+ *
+ * Licensed under the BSD 3-Clause License with Attribution Requirement.
+ * See the LICENSE file for details: https://github.com/MAIPA01/mstd/blob/main/LICENSE
+ *
+ * Copyright (c) 2025, Patryk Antosik (MAIPA01)
+ */
+
+#pragma once
+#include "string_libs.hpp"
+#include <bit>
+
+namespace mstd {
+	// SWAR (SIMD within a register) helpers working on 8 decimal digits packed in a uint64_t.
+	// Bytes are loaded little-endian. In constant evaluation (and on big-endian targets)
+	// they're assembled by hand.
+
+	static constexpr uint64_t _swar_load8(const char* str) {
+		uint64_t value = 0;
+
+		if (!std::is_constant_evaluated() && std::endian::native == std::endian::little) {
+			std::memcpy(&value, str, sizeof(value));
+			return value;
+		}
+
+		for (size_t i = 0; i != 8; ++i) {
+			value |= static_cast<uint64_t>(static_cast<unsigned char>(str[i])) << (i * 8);
+		}
+		return value;
+	}
+
+	// 8 bytes from 'i', zeros past the end of 'str'. Near the end the last 8 bytes are loaded and shifted down.
+	static constexpr uint64_t _swar_load_tail(const std::string& str, const size_t& i) {
+		const size_t left = str.size() - i;
+
+		if (left >= 8) return _swar_load8(str.data() + i);
+		if (left == 0) return 0;
+		if (str.size() >= 8) return _swar_load8(str.data() + str.size() - 8) >> ((8 - left) * 8);
+
+		uint64_t value = 0;
+		for (size_t j = 0; j != left; ++j) {
+			value |= static_cast<uint64_t>(static_cast<unsigned char>(str[i + j])) << (j * 8);
+		}
+		return value;
+	}
+
+	// Are all 8 bytes in '0'..'9'.
+	static constexpr bool _swar_is_eight_digits(const uint64_t& value) {
+		return ((value & 0xF0F0F0F0F0F0F0F0) |
+			(((value + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+	}
+
+	// Number of leading (lowest bytes) digits, 0..8.
+	static constexpr size_t _swar_count_digits(const uint64_t& value) {
+		const uint64_t non_digits = ((value & 0xF0F0F0F0F0F0F0F0) |
+			(((value + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ^ 0x3333333333333333;
+		return non_digits == 0 ? 8 : std::countr_zero(non_digits) / 8;
+	}
+
+	// Keeps the 'count' (1..8) leading digits, moved to the top and preceded with '0's.
+	static constexpr uint64_t _swar_keep_digits(const uint64_t& value, const size_t& count) {
+		const size_t shift = (8 - count) * 8;
+		return shift == 0 ? value : (value << shift) | (0x3030303030303030 >> (64 - shift));
+	}
+
+	// 8 digits (first digit in the lowest byte) -> 0..99999999.
+	static constexpr uint32_t _swar_parse_eight_digits(uint64_t value) {
+		const uint64_t mask = 0x000000FF000000FF;
+		const uint64_t mul1 = 0x000F424000000064; // 100 + (1000000ULL << 32)
+		const uint64_t mul2 = 0x0000271000000001; // 1 + (10000ULL << 32)
+
+		value -= 0x3030303030303030;
+		value = (value * 10) + (value >> 8);
+		value = (((value & mask) * mul1) + (((value >> 16) & mask) * mul2)) >> 32;
+		return static_cast<uint32_t>(value);
+	}
+
+	// The 'count' (0..8) leading digits -> 0..99999999.
+	static constexpr uint32_t _swar_parse_digits(const uint64_t& value, const size_t& count) {
+		return count == 0 ? 0 : _swar_parse_eight_digits(_swar_keep_digits(value, count));
+	}
+
+	// Index of the first non-digit at or after 'i'.
+	static constexpr size_t _skip_digits(const std::string& str, size_t i) {
+		for (; i + 8 <= str.size(); i += 8) {
+			const size_t count = _swar_count_digits(_swar_load8(str.data() + i));
+			if (count != 8) return i + count;
+		}
+		return i + _swar_count_digits(_swar_load_tail(str, i));
+	}
+}
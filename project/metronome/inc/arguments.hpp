@@ -5,329 +5,347 @@
 //
 #include <blue/error.hpp>
 //
-#include <string>
-//
-// WARN `margs` uses the following names. We have to undefine them.
-#undef max
-#undef min
-#undef near
-#undef far
-#undef str
-//
-#include <margs/margs.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cstdio>
 //
 #include "resources.hpp"
 
 
-#define METRONOME_ARGUMENT_NAME_FILENAME 			"filename"
-#define METRONOME_ARGUMENT_NAME_BPM 				"bpm"
-#define METRONOME_ARGUMENT_NAME_WAIT 				"wait"
-#define METRONOME_ARGUMENT_NAME_VOLUME 				"volume"
-#define METRONOME_ARGUMENT_NAME_PATTERN 			"pattern"
-
-#define METRONOME_ARGUMENT_SHORT_FILENAME 			'f'
-#define METRONOME_ARGUMENT_SHORT_BPM 				'b'
-#define METRONOME_ARGUMENT_SHORT_WAIT 				'w'
-#define METRONOME_ARGUMENT_SHORT_VOLUME 			'v'
-#define METRONOME_ARGUMENT_SHORT_PATTERN 			'p'
-
-#define METRONOME_ARGUMENT_DESCRIPTION_FILENAME 	"desc..."
-#define METRONOME_ARGUMENT_DESCRIPTION_BPM 			"desc..."
-#define METRONOME_ARGUMENT_DESCRIPTION_WAIT 		"desc..."
-#define METRONOME_ARGUMENT_DESCRIPTION_VOLUME 		"desc..."
-#define METRONOME_ARGUMENT_DESCRIPTION_PATTERN 		"desc..."
+#ifdef METRONOME_MINIMAL
+	#define METRONOME_ARGUMENT_DEFAULT_FILENAME		METRONOME_SYNTH_SINE
+#else
+	#define METRONOME_ARGUMENT_DEFAULT_FILENAME		METRONOME_TRACK_01_
+#endif
 
-#define METRONOME_ARGUMENT_DEFAULT_FILENAME			METRONOME_TRACK_01_
-#define METRONOME_ARGUMENT_DEFAULT_BPM 				120
-#define METRONOME_ARGUMENT_DEFAULT_WAIT 			1
-#define METRONOME_ARGUMENT_DEFAULT_VOLUME 			75
-#define METRONOME_ARGUMENT_DEFAULT_PATTERN 		    4
-
-#define METRONOME_ARGUMENT_TYPE_FILENAME			std::string
+#define METRONOME_ARGUMENT_TYPE_FILENAME			const c8*
+#define METRONOME_ARGUMENT_TYPE_SESSION				const c8*
+#define METRONOME_ARGUMENT_TYPE_COMPILED			const c8*
 #define METRONOME_ARGUMENT_TYPE_BPM 				u16
 #define METRONOME_ARGUMENT_TYPE_WAIT 			    u16
 #define METRONOME_ARGUMENT_TYPE_VOLUME 			    u16
 #define METRONOME_ARGUMENT_TYPE_PATTERN 		    u8
+#define METRONOME_ARGUMENT_TYPE_MIDI 			    u8
+#define METRONOME_ARGUMENT_TYPE_FOLLOW 			    u8
+#define METRONOME_ARGUMENT_TYPE_OSC 			    u16
+#define METRONOME_ARGUMENT_TYPE_LEAD 			    u16
+#define METRONOME_ARGUMENT_TYPE_JOIN 			    const c8*
+#define METRONOME_ARGUMENT_TYPE_PEERS 			    u16
+#define METRONOME_ARGUMENT_TYPE_LATENCY 		    u16
+#define METRONOME_ARGUMENT_TYPE_GRADE 			    const c8*
+
+#define METRONOME_ARGUMENT_HELP_NAME 				"help"
+#define METRONOME_ARGUMENT_HELP_SHORT 				'h'
+#define METRONOME_ARGUMENT_HELP_SIZE 				2048
+
+
+namespace ARGUMENTS {
+
+	struct MAINARGS {
+		METRONOME_ARGUMENT_TYPE_FILENAME 	filename; 	// Points into 'argv' or a literal. Never freed.
+		METRONOME_ARGUMENT_TYPE_SESSION 	session; 	// Points into 'argv' or nullptr.
+		METRONOME_ARGUMENT_TYPE_COMPILED 	compiled; 	// Points into 'argv' or nullptr.
+		METRONOME_ARGUMENT_TYPE_BPM 		bpm;
+		METRONOME_ARGUMENT_TYPE_WAIT 		wait;
+		METRONOME_ARGUMENT_TYPE_VOLUME 		volume;
+		METRONOME_ARGUMENT_TYPE_PATTERN 	pattern;
+		METRONOME_ARGUMENT_TYPE_MIDI 		midi; 		// 0 -> no MIDI output
+		METRONOME_ARGUMENT_TYPE_FOLLOW 		follow; 	// 0 -> session's tempo
+		METRONOME_ARGUMENT_TYPE_OSC 		osc; 		// 0 -> no OSC control
+		METRONOME_ARGUMENT_TYPE_LEAD 		lead; 		// 0 -> not leading
+		METRONOME_ARGUMENT_TYPE_JOIN 		join; 		// Points into 'argv' or nullptr.
+		METRONOME_ARGUMENT_TYPE_PEERS 		peers; 		// 0 -> no peers
+		METRONOME_ARGUMENT_TYPE_LATENCY 	latency; 	// ms, on top of what the output reports
+		METRONOME_ARGUMENT_TYPE_GRADE 		grade; 		// Points into 'argv' or nullptr.
+	};
 
+}
 
 
-namespace ARGUMENTS::ARGUMENT {
+namespace ARGUMENTS::OPTION {
+
+	//  ABOUT
+	// Every option is described once in 'OPTIONS'. The parser, range checks, defaults ('Defaults')
+	//  and the help text ('HELP') are all expanded from it at compile-time. Values are written
+	//  straight into their 'MAINARGS' field, strings point into 'argv'. No allocations and no
+	//  runtime type dispatch - each option's setter is instantiated for its own type.
+	//
+	//  Adding an option -> a 'MAINARGS' field and a line in 'OPTIONS'.
+	//  Accepted forms: '--name value', '--name=value', '-n value', '-nvalue', '--help', '-h'.
+	//
+
+	template <class T>
+	struct OPTION {
+		T MAINARGS::* 	field;
+		const c8* 		name;
+		c8 				letter;
+		const c8* 		description;
+		T 				fallback; 	// default
+		T 				min; 		// numbers only
+		T 				max; 		// numbers only
+	};
 
-	enum CONDITION: u8 {
-		CONDITION_FILENAME 	= 1,
-		CONDITION_BPM 		= 2,
-		CONDITION_WAIT 		= 4,
-		CONDITION_VOLUME 	= 8,
+	constexpr std::tuple OPTIONS {
+		OPTION<METRONOME_ARGUMENT_TYPE_FILENAME> 	{ &MAINARGS::filename, 	"filename", 	'f', "Sound - an '.opus' file or " METRONOME_SYNTH_SINE ", " METRONOME_SYNTH_SQUARE ", " METRONOME_SYNTH_NOISE ".", METRONOME_ARGUMENT_DEFAULT_FILENAME, nullptr, nullptr },
+		OPTION<METRONOME_ARGUMENT_TYPE_SESSION> 	{ &MAINARGS::session, 	"json", 		'j', "Session - a '.json' file with tempo sections.", nullptr, nullptr, nullptr },
+		OPTION<METRONOME_ARGUMENT_TYPE_COMPILED> 	{ &MAINARGS::compiled, 	"compiled", 	'c', "Compiled session - a '.mtb' file.", 		nullptr, nullptr, nullptr },
+		OPTION<METRONOME_ARGUMENT_TYPE_BPM> 		{ &MAINARGS::bpm, 		"bpm", 			'b', "Tempo in beats per minute.", 				120, 	40, 	440 },
+		OPTION<METRONOME_ARGUMENT_TYPE_WAIT> 		{ &MAINARGS::wait, 		"wait", 		'w', "Seconds to wait before the first beat.", 	1, 		0, 		10 	},
+		OPTION<METRONOME_ARGUMENT_TYPE_VOLUME> 		{ &MAINARGS::volume, 	"volume", 		'v', "Volume in percent.", 						75, 	1, 		100 },
+		OPTION<METRONOME_ARGUMENT_TYPE_PATTERN> 	{ &MAINARGS::pattern, 	"pattern", 		'p', "Every n-th beat is accented.", 			4, 		1, 		16 	},
+		OPTION<METRONOME_ARGUMENT_TYPE_MIDI> 		{ &MAINARGS::midi, 		"midi", 		'm', "MIDI clock output device, 0 is none.", 	0, 		0, 		32 	},
+		OPTION<METRONOME_ARGUMENT_TYPE_FOLLOW> 		{ &MAINARGS::follow, 	"follow", 		's', "MIDI clock input device to follow instead of bpm, 0 is none.", 0, 0, 32 },
+		OPTION<METRONOME_ARGUMENT_TYPE_OSC> 		{ &MAINARGS::osc, 		"osc", 			'o', "UDP port for OSC control on localhost, 0 is none.", 0, 0, 65535 },
+		OPTION<METRONOME_ARGUMENT_TYPE_LEAD> 		{ &MAINARGS::lead, 		"lead", 		'l', "UDP port followers join to play in step, 0 is none.", 0, 0, 65535 },
+		OPTION<METRONOME_ARGUMENT_TYPE_JOIN> 		{ &MAINARGS::join, 		"join", 		'n', "Leader to play in step with - 'host:port'.", nullptr, nullptr, nullptr },
+		OPTION<METRONOME_ARGUMENT_TYPE_PEERS> 		{ &MAINARGS::peers, 	"peers", 		'e', "UDP port shared with peers on the local network, 0 is none.", 0, 0, 65535 },
+		OPTION<METRONOME_ARGUMENT_TYPE_LATENCY> 	{ &MAINARGS::latency, 	"latency", 		'a', "Milliseconds of output latency the output doesn't report, see 'calibrate'.", 0, 0, 1000 },
+		OPTION<METRONOME_ARGUMENT_TYPE_GRADE> 		{ &MAINARGS::grade, 	"grade", 		'g', "Grades playing along - 'input' to record it or a '.wav' file.", nullptr, nullptr, nullptr },
 	};
 
-	void GetFilename (
-		IN 		const margs::args_map& map,
-		OUT 	c8*& value
+	constexpr u8 OPTIONS_COUNT = std::tuple_size_v<decltype (OPTIONS)>;
+
+	template <class T>
+	constexpr bool IsString = std::is_same_v<T, const c8*>;
+
+}
+
+
+namespace ARGUMENTS::OPTION {
+
+	// Calls 'function' with every option.
+	template <class Function>
+	constexpr void ForEach (
+		IN		Function 			function
 	) {
-		const auto& string = map.get_value (METRONOME_ARGUMENT_NAME_FILENAME)
-            .as<METRONOME_ARGUMENT_TYPE_FILENAME> ();
+		std::apply ([&] (const auto&... options) { (function (options), ...); }, OPTIONS);
+	}
 
-		// MEMORY ALLOCATION ! -> margs::args_map will deallocate at some point.
-		const auto& length = string.length () + 1; // + null-term
-		const auto&& buffer = string.c_str ();
+	// The option describing 'field'. Lets other parsers share its range.
+	template <auto field, u8 index = 0>
+	consteval const auto& Find () {
+		static_assert (index < OPTIONS_COUNT, "No option describes that field.");
+		constexpr const auto& option = std::get<index> (OPTIONS);
 
-		ALLOCATE (c8, value, length * sizeof (c8));
-		std::memcpy (value, buffer, length * sizeof (c8));
-		MEMORY::EXIT::PUSH (FREE, 1, value);
+		if constexpr (std::is_same_v<decltype (option.field), decltype (field)>) {
+			if constexpr (option.field == field) return option;
+			else return Find<field, index + 1> ();
+		} else {
+			return Find<field, index + 1> ();
+		}
+	}
 
-		// PARSING
-		// TODO
-		//
+	constexpr MAINARGS Defaults () {
+		MAINARGS args {};
+		ForEach ([&] (const auto& option) { args.*option.field = option.fallback; });
+		return args;
 	}
 
-	void GetBPM (
-		IN 		const margs::args_map& map,
-		OUT 	u16& value
+	constexpr bool IsEqual (
+		IN		const c8* const& 	a,
+		IN		const c8* const& 	b,
+		IN		const u32& 			length
 	) {
-		value = map.get_value (METRONOME_ARGUMENT_NAME_BPM)
-            .as<METRONOME_ARGUMENT_TYPE_BPM> ();
+		u32 i = 0;
+		for (; i < length && a[i] == b[i]; ++i);
+		return i == length && a[i] == '\0';
+	}
 
-		// PARSING
-		if (value > 440) 	{ LOGWARN ("'BPM' value exceeded MAX!\n"); value = 440; return; }
-		if (value < 40) 	{ LOGWARN ("'BPM' value exceeded MIN!\n"); value = 40;  }
+	// Returns 'OPTIONS_COUNT' when not found. 'length' is the name length ('--name=value').
+	constexpr u8 FindName (
+		IN		const c8* const& 	name,
+		IN		const u32& 			length
+	) {
+		u8 found = OPTIONS_COUNT, i = 0;
+		ForEach ([&] (const auto& option) { if (IsEqual (option.name, name, length)) found = i; ++i; });
+		return found;
 	}
 
-	void GetWait (
-		IN 		const margs::args_map& map,
-		OUT 	u16& value
+	constexpr u8 FindLetter (
+		IN		const c8& 			letter
 	) {
-		value = map.get_value (METRONOME_ARGUMENT_NAME_WAIT)
-            .as<METRONOME_ARGUMENT_TYPE_WAIT> ();
+		u8 found = OPTIONS_COUNT, i = 0;
+		ForEach ([&] (const auto& option) { if (option.letter == letter) found = i; ++i; });
+		return found;
+	}
+
+	consteval bool IsValid () {
+		bool isValid = FindLetter (METRONOME_ARGUMENT_HELP_SHORT) == OPTIONS_COUNT;
+		u8 i = 0;
 
-		// PARSING
-		if (value > 10) 	{ LOGWARN ("'Wait' value exceeded MAX!\n"); value = 10; }
+		ForEach ([&] (const auto& option) {
+			u32 length = 0;
+			for (; option.name[length] != '\0'; ++length);
+
+			isValid &= FindName (option.name, length) == i && FindLetter (option.letter) == i;
+			if constexpr (!IsString<std::remove_cvref_t<decltype (option.fallback)>>) {
+				isValid &= option.min <= option.fallback && option.fallback <= option.max;
+			}
+			++i;
+		});
+
+		return isValid;
 	}
 
-	void GetVolume (
-		IN 		const margs::args_map& map,
-		OUT 	u16& value
+	static_assert (IsValid (), "Option names and letters have to be unique and defaults within range.");
+
+
+	template <class T>
+	void Set (
+		INOUT	MAINARGS& 			args,
+		IN		const OPTION<T>& 	option,
+		IN		const c8* const& 	value
 	) {
-		value = map.get_value (METRONOME_ARGUMENT_NAME_VOLUME)
-            .as<METRONOME_ARGUMENT_TYPE_VOLUME> ();
+		if constexpr (IsString<T>) {
+			args.*option.field = value;
+		} else {
+			u32 number = 0;
+			u32 i = 0;
+
+			// Every digit is read, past 'UINT16_MAX' the number stops growing and is clamped below.
+			for (; value[i] >= '0' && value[i] <= '9'; ++i) {
+				if (number <= UINT16_MAX) number = number * 10 + (value[i] - '0');
+			}
+
+			if (i == 0 || value[i] != '\0') {
+				ERROR ("Invalid argument passed, '%s' expects a number, got '%s'\n", option.name, value);
+			}
 
-		// PARSING
-		if (value > 100) 	{ LOGWARN ("'Volume' value exceeded MAX!\n"); value = 100; return; }
-		if (value < 1) 		{ LOGWARN ("'Volume' value exceeded MIN!\n"); value = 1;  }
+			if (number > option.max) { LOGWARN ("'%s' value exceeded MAX!\n", option.name); number = option.max; }
+			if (number < option.min) { LOGWARN ("'%s' value exceeded MIN!\n", option.name); number = option.min; }
+
+			args.*option.field = (T)number;
+		}
 	}
 
-    void GetPattern (
-		IN 		const margs::args_map& map,
-		OUT 	u8& value
+	template <u8 index = 0>
+	void SetAt (
+		INOUT	MAINARGS& 			args,
+		IN		const u8& 			found,
+		IN		const c8* const& 	value
 	) {
-		value = map.get_value (METRONOME_ARGUMENT_NAME_PATTERN)
-            .as<METRONOME_ARGUMENT_TYPE_PATTERN> ();
-
-		// PARSING
-		if (value > 16) 	{ LOGWARN ("'Volume' value exceeded MAX!\n"); value = 16; return; }
-		if (value < 1) 		{ LOGWARN ("'Volume' value exceeded MIN!\n"); value = 1; }
+		if constexpr (index < OPTIONS_COUNT) {
+			if (found == index) return Set (args, std::get<index> (OPTIONS), value);
+			SetAt<index + 1> (args, found, value);
+		}
 	}
-	
+
 }
 
 
-namespace ARGUMENTS {
+namespace ARGUMENTS::OPTION {
 
-	struct MAINARGS {
-		c8* 	                        filename; 
-		METRONOME_ARGUMENT_TYPE_BPM 	bpm;
-		METRONOME_ARGUMENT_TYPE_WAIT 	wait;
-		METRONOME_ARGUMENT_TYPE_VOLUME 	volume;
-        METRONOME_ARGUMENT_TYPE_PATTERN pattern;
+	struct TEXT {
+		c8 data [METRONOME_ARGUMENT_HELP_SIZE];
+		u32 length;
+
+		constexpr void Append (IN const c8& character) { data[length++] = character; }
+		constexpr void Append (IN const c8* text) { for (; *text; ++text) Append (*text); }
+		constexpr void Append (IN const u32& number) {
+			if (number >= 10) Append (number / 10);
+			Append ((c8)('0' + number % 10));
+		}
+		constexpr void Pad (IN const u32& column, IN const u32& start) {
+			for (u32 i = length - start; i < column; ++i) Append (' ');
+		}
 	};
 
-	void Get (
-		IN		const s32& 	argumentsCount, 
-		IN		c8**		arguments,			// TODO
-		OUT		MAINARGS& 	args
-	) {
+	// "  -b, --bpm <40-440>        Tempo in beats per minute. (120)"
+	consteval TEXT MakeHelp () {
+		TEXT text {};
+
+		text.Append ("Usage: metronome [options]\n");
+		text.Append ("       metronome compile <session.json> [-o <session.mtb>] [--embed]\n");
+		text.Append ("       metronome daemon [socket]\n");
+		text.Append ("       metronome calibrate [clicks] [input ms]\n");
+
+		ForEach ([&] (const auto& option) {
+			using T = std::remove_cvref_t<decltype (option.fallback)>;
+			const u32 start = text.length;
+
+			text.Append ("  -"); text.Append (option.letter);
+			text.Append (", --"); text.Append (option.name);
+
+			if constexpr (IsString<T>) {
+				text.Append (" <name>");
+				text.Pad (28, start);
+				text.Append (option.description);
+				if (option.fallback) { text.Append (" ("); text.Append (option.fallback); text.Append (')'); }
+				text.Append ('\n');
+			} else {
+				text.Append (" <"); text.Append ((u32)option.min);
+				text.Append ('-'); text.Append ((u32)option.max); text.Append ('>');
+				text.Pad (28, start);
+				text.Append (option.description);
+				text.Append (" ("); text.Append ((u32)option.fallback); text.Append (")\n");
+			}
+		});
+
+		text.Append ("  -"); text.Append (METRONOME_ARGUMENT_HELP_SHORT);
+		text.Append (", --" METRONOME_ARGUMENT_HELP_NAME "                Prints this message.\n");
+
+		return text;
+	}
 
-		auto& filename 	= args.filename;
-		auto& bpm 		= args.bpm;
-		auto& wait 		= args.wait;
-		auto& volume 	= args.volume;
-        auto& pattern 	= args.pattern;
-
-		using namespace margs;
-		using namespace mstd;
-
-		args_analizer analizer = args_analizer (
-
-			help_data { .description = "Args analizer sample description" },
-
-			args_builder::makeValue (
-
-				METRONOME_ARGUMENT_NAME_FILENAME, METRONOME_ARGUMENT_SHORT_FILENAME, 1,  
-				help_data { .description = METRONOME_ARGUMENT_DESCRIPTION_FILENAME }
-
-			), 
-
-			args_builder::makeValue (
-
-				METRONOME_ARGUMENT_NAME_BPM, METRONOME_ARGUMENT_SHORT_BPM, 1,  
-				help_data { .description = METRONOME_ARGUMENT_DESCRIPTION_BPM }
-
-			), 
-
-			args_builder::makeValue (
-
-				METRONOME_ARGUMENT_NAME_WAIT, METRONOME_ARGUMENT_SHORT_WAIT, 1,  
-				help_data { .description = METRONOME_ARGUMENT_DESCRIPTION_WAIT }
-
-			), 
-
-			args_builder::makeValue (
-
-				METRONOME_ARGUMENT_NAME_VOLUME, METRONOME_ARGUMENT_SHORT_VOLUME, 1,  
-				help_data { .description = METRONOME_ARGUMENT_DESCRIPTION_VOLUME }
-
-			),
-
-            args_builder::makeValue (
-
-				METRONOME_ARGUMENT_NAME_PATTERN, METRONOME_ARGUMENT_SHORT_PATTERN, 1,  
-				help_data { .description = METRONOME_ARGUMENT_DESCRIPTION_PATTERN }
-
-			)
-
-		);
-
-		args_map values;
-		std::string value;
-
-		//  ABOUT
-		// Get program args.
-		//
-
-		try { values = analizer.analize (argumentsCount, arguments);
-		} catch (const args_exception& e) { ERROR ("Invalid argument passed, code: %s\n", e.what ()) }
-
-
-		//u8 condition = 0;
-		//condition += (values.contains_value (METRONOME_ARGUMENT_NAME_FILENAME) 	<< 0); // 1
-		//condition += (values.contains_value (METRONOME_ARGUMENT_NAME_BPM) 		<< 1); // 2
-		//condition += (values.contains_value (METRONOME_ARGUMENT_NAME_WAIT) 		<< 2); // 4
-		//condition += (values.contains_value (METRONOME_ARGUMENT_NAME_VOLUME) 	<< 3); // 8
-		//
-		//// TODO
-		//// 1. speed-test if fails do it normally.
-		//// 2. Preprocessor use ?
-		//switch (condition) {
-		//
-		//	case ARGUMENT::CONDITION_FILENAME: {
-		//		ARGUMENT::GetFilename (values, filename);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_BPM: {
-		//		ARGUMENT::GetBPM (values, bpm);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_BPM + ARGUMENT::CONDITION_FILENAME: {	
-		//		ARGUMENT::GetBPM (values, bpm);
-		//		ARGUMENT::GetFilename (values, filename);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_WAIT: {
-		//		ARGUMENT::GetWait (values, wait); 
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_WAIT + ARGUMENT::CONDITION_FILENAME: {	
-		//		ARGUMENT::GetWait (values, wait); 
-		//		ARGUMENT::GetFilename (values, filename);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_WAIT + ARGUMENT::CONDITION_BPM: {
-		//		ARGUMENT::GetWait (values, wait);  
-		//		ARGUMENT::GetBPM (values, bpm);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_WAIT + ARGUMENT::CONDITION_BPM + ARGUMENT::CONDITION_FILENAME: {
-		//		ARGUMENT::GetWait (values, wait);  
-		//		ARGUMENT::GetBPM (values, bpm);
-		//		ARGUMENT::GetFilename (values, filename);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_VOLUME: {
-		//		ARGUMENT::GetVolume (values, volume); 
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_VOLUME + ARGUMENT::CONDITION_FILENAME: {
-		//		ARGUMENT::GetVolume (values, volume); 
-		//		ARGUMENT::GetFilename (values, filename);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_VOLUME + ARGUMENT::CONDITION_BPM: {
-		//		ARGUMENT::GetVolume (values, volume); 
-		//		ARGUMENT::GetBPM (values, bpm);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_VOLUME + ARGUMENT::CONDITION_BPM + ARGUMENT::CONDITION_FILENAME: {
-		//		ARGUMENT::GetVolume (values, volume); 
-		//		ARGUMENT::GetBPM (values, bpm);
-		//		ARGUMENT::GetFilename (values, filename);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_VOLUME + ARGUMENT::CONDITION_WAIT: {
-		//		ARGUMENT::GetVolume (values, volume); 
-		//		ARGUMENT::GetWait (values, wait); 
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_VOLUME + ARGUMENT::CONDITION_WAIT + ARGUMENT::CONDITION_FILENAME: {
-		//		ARGUMENT::GetVolume (values, volume); 
-		//		ARGUMENT::GetWait (values, wait); 
-		//		ARGUMENT::GetFilename (values, filename);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_VOLUME + ARGUMENT::CONDITION_WAIT + ARGUMENT::CONDITION_BPM: {
-		//		ARGUMENT::GetVolume (values, volume); 
-		//		ARGUMENT::GetWait (values, wait); 
-		//		ARGUMENT::GetBPM (values, bpm);
-		//	} break;
-		//
-		//	case ARGUMENT::CONDITION_VOLUME + ARGUMENT::CONDITION_WAIT + ARGUMENT::CONDITION_BPM + ARGUMENT::CONDITION_FILENAME: {
-		//		ARGUMENT::GetVolume (values, volume);  
-		//		ARGUMENT::GetWait (values, wait); 
-		//		ARGUMENT::GetBPM (values, bpm);
-		//		ARGUMENT::GetFilename (values, filename);
-		//	} break;
-		//
-		//}
-
-		if (values.contains_value (METRONOME_ARGUMENT_NAME_FILENAME)) {
-			ARGUMENT::GetFilename (values, filename);
-		} else {
+	constexpr TEXT HELP = MakeHelp ();
 
-			// FILENAME -> SET DEFAULT
-			const auto& length = sizeof (METRONOME_ARGUMENT_DEFAULT_FILENAME); // + null-term
-			ALLOCATE (c8, filename, length * sizeof (c8));
-			std::memcpy (filename, METRONOME_ARGUMENT_DEFAULT_FILENAME, length * sizeof (c8));
-			MEMORY::EXIT::PUSH (FREE, 1, filename);
+	static_assert (HELP.length < METRONOME_ARGUMENT_HELP_SIZE, "Increase 'METRONOME_ARGUMENT_HELP_SIZE'.");
 
-		}
+}
 
-		if (values.contains_value (METRONOME_ARGUMENT_NAME_BPM)) {
-			ARGUMENT::GetBPM (values, bpm);
-		}
 
-		if (values.contains_value (METRONOME_ARGUMENT_NAME_WAIT)) {
-			ARGUMENT::GetWait (values, wait);
-		}
+namespace ARGUMENTS {
 
-		if (values.contains_value (METRONOME_ARGUMENT_NAME_VOLUME)) {
-			ARGUMENT::GetVolume (values, volume);
-		}
+	using OPTION::Defaults;
 
-        if (values.contains_value (METRONOME_ARGUMENT_NAME_PATTERN)) {
-			ARGUMENT::GetPattern (values, pattern);
+	void Get (
+		IN		const s32& 	argumentsCount,
+		IN		c8**		arguments,
+		OUT		MAINARGS& 	args
+	) {
+		using namespace OPTION;
+
+		for (s32 i = 1; i < argumentsCount; ++i) {
+			const c8* const argument = arguments[i];
+			const c8* value = nullptr;
+			u8 index = OPTIONS_COUNT;
+			bool isHelp = false;
+
+			if (argument[0] == '-' && argument[1] == '-') { // --name value | --name=value
+				const c8* const name = argument + 2;
+				u32 length = 0;
+
+				for (; name[length] != '\0' && name[length] != '='; ++length);
+				if (name[length] == '=') value = name + length + 1;
+
+				index = FindName (name, length);
+				isHelp = IsEqual (METRONOME_ARGUMENT_HELP_NAME, name, length);
+			} else if (argument[0] == '-' && argument[1] != '\0') { // -n value | -nvalue
+				if (argument[2] != '\0') value = argument + 2;
+
+				index = FindLetter (argument[1]);
+				isHelp = argument[1] == METRONOME_ARGUMENT_HELP_SHORT && value == nullptr;
+			}
+
+			if (isHelp) {
+				LOGSTOP ();
+				fwrite (HELP.data, sizeof (c8), HELP.length, stdout);
+				MEMORY::EXIT::ATEXIT ();
+				exit (0);
+			}
+
+			if (index == OPTIONS_COUNT) {
+				ERROR ("Invalid argument passed, code: Not recognized argument '%s'\n", argument);
+			}
+
+			if (value == nullptr) {
+				if (i + 1 == argumentsCount) ERROR ("Invalid argument passed, '%s' expects a value\n", argument);
+				value = arguments[++i];
+			}
+
+			SetAt (args, index, value);
 		}
-
-		
-
 	}
 
-
 }
@@ -15,6 +15,10 @@ namespace AL_WRAPPER {
 		alcCloseDevice ((ALCdevice*)data);
 	)
 
+	DEALLOC ( CloseCaptureDevice,
+		alcCaptureCloseDevice ((ALCdevice*)data);
+	)
+
 	DEALLOC ( DestroyContext,
 		alcDestroyContext ((ALCcontext*)data);
 	)
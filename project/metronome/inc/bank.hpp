@@ -0,0 +1,128 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+//
+#include <atomic>
+#include <threads.h>
+//
+#include "audio.hpp"
+#include "synth.hpp"
+#include "schedule.hpp"
+#include "compiled.hpp"
+#ifndef METRONOME_MINIMAL
+	#include "opus.hpp"
+#endif
+
+
+//  ABOUT
+// A plan together with the sounds it plays ('SOUNDS' - a regular and an accent source per
+//  sound). There are two slots. The player plays one, a reloaded plan is prepared in the
+//  other one and handed over through 'pending'. The player takes it at a bar boundary,
+//  the previous slot's sources keep ringing out - nothing is stopped or cut.
+//
+//  'pending' is only set while it's empty and 'playing' is updated before 'pending' is
+//  cleared, so the slot being prepared is never the one being played.
+//
+
+namespace BANK {
+
+	struct SOUNDS {
+		u8 count; 	// sources & buffers
+		ALuint buffers [METRONOME_SCHEDULE_SOUNDS * 2]; // regular, accent - per sound
+		ALuint sources [METRONOME_SCHEDULE_SOUNDS * 2]; // regular, accent - per sound
+	};
+
+	struct SLOT {
+		const SCHEDULE::PLAN* plan;
+		SOUNDS sounds;
+	};
+
+	SLOT slots [2];
+
+	std::atomic<const SLOT*> pending 	= nullptr;
+	std::atomic<const SLOT*> playing 	= nullptr;
+
+}
+
+
+namespace BANK {
+
+	void Create (
+		OUT		SOUNDS& 					sounds,
+		IN		const SCHEDULE::PLAN& 		plan,
+		IN		const COMPILED::LOADED& 	loaded
+	) {
+		sounds.count = plan.soundsCount * 2;
+
+		alGenBuffers (sounds.count, sounds.buffers);
+		alGenSources (sounds.count, sounds.sources);
+
+		for (u8 i = 0; i < sounds.count; i += 2) {
+			const c8* const sound = plan.sounds[i / 2];
+			ALuint* buffers = sounds.buffers;
+			ALuint* sources = sounds.sources;
+
+			SYNTH::CLICK click;
+			ALuint accentBuffer = buffers[i + 1];
+
+			if (COMPILED::Buffer (loaded, i / 2, buffers[i])) {
+				accentBuffer = buffers[i]; // Embedded PCM is always '.opus' decoded.
+			} else if (SYNTH::Find (sound, click)) {
+				SYNTH::Load (buffers[i], buffers[i + 1], click);
+			} else {
+				#ifndef METRONOME_MINIMAL
+					OPUS::Load (buffers[i], sound);
+					accentBuffer = buffers[i]; // Accent differs only by gain.
+				#else
+					ERROR ("Unknown sound '%s'. Minimal build supports synthesized clicks only.\n", sound);
+				#endif
+			}
+
+			AUDIO::SOURCE::SetBuffer (sources[i], buffers[i]);
+			AUDIO::SOURCE::SetPosition (sources[i], 0.0f, 0.0f, 0.0f);
+			AUDIO::SOURCE::SetGain (sources[i], 0.25f);
+
+			AUDIO::SOURCE::SetBuffer (sources[i + 1], accentBuffer);
+			AUDIO::SOURCE::SetPosition (sources[i + 1], 0.0f, 0.0f, 0.0f);
+			AUDIO::SOURCE::SetGain (sources[i + 1], 1.0f);
+		}
+	}
+
+	// Lets sources ring out before deleting them.
+	void Destroy (
+		INOUT	SOUNDS& 					sounds
+	) {
+		const timespec idle { 0, 1000000 }; // 1ms
+
+		for (u8 i = 0; i < sounds.count; ++i) {
+			ALint sourceState;
+			for (alGetSourcei (sounds.sources[i], AL_SOURCE_STATE, &sourceState); sourceState == AL_PLAYING;) {
+				thrd_sleep (&idle, nullptr);
+				alGetSourcei (sounds.sources[i], AL_SOURCE_STATE, &sourceState);
+			}
+		}
+
+		alDeleteSources (sounds.count, sounds.sources);
+		alDeleteBuffers (sounds.count, sounds.buffers);
+		sounds.count = 0;
+	}
+
+	// Player only. Returns the slot to switch to or nullptr.
+	const SLOT* Take () {
+		const SLOT* taken = pending.load (std::memory_order_acquire);
+		if (taken == nullptr) return nullptr;
+
+		playing.store (taken, std::memory_order_release);
+		pending.store (nullptr, std::memory_order_release);
+		return taken;
+	}
+
+	// Returns the slot that can be prepared or nullptr while the last one wasn't taken yet.
+	SLOT* GetSpare () {
+		if (pending.load (std::memory_order_acquire) != nullptr) return nullptr;
+		return playing.load (std::memory_order_acquire) == &slots[0] ? &slots[1] : &slots[0];
+	}
+
+}
@@ -3,7 +3,14 @@
 //
 #pragma once
 //
+#ifdef _WIN32
+	#include <winsock2.h> // HACK. Has to come before any 'windows.h'.
+#endif
+//
 #define CONSOLE_COLOR_ENABLED
 #define LOGGER_TIME_FORMAT "%f"
+#define LOGGER_ASYNC
 #define MEMORY_EXIT_SIZE 32
+#define MEMORY_ARENA
+#define MEMORY_ARENA_SIZE (4 * 1024 * 1024)
 #define MEMORY_TYPE u16
@@ -0,0 +1,352 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/io_map.hpp>
+#include <blue/timestamp.hpp>
+//
+#include <bit>
+#include <cstdio>
+#include <cinttypes>
+//
+#include "arguments.hpp"
+#include "schedule.hpp"
+#include "session.hpp"
+#include "audio.hpp"
+#include "synth.hpp"
+#ifndef METRONOME_MINIMAL
+	#include "opus.hpp"
+#endif
+
+
+//  ABOUT
+// Compiled sessions ('.mtb'). 'metronome compile <session.json> [-o <session.mtb>] [--embed]'
+//  parses a session once and writes its 'SCHEDULE::PLAN' byte for byte. The player maps
+//  the file ('--compiled') and plays the mapped plan in place - nothing is parsed or copied,
+//  the header and the plan are only validated.
+//
+//  FILE LAYOUT (little-endian, offsets aligned to 8 bytes)
+//   HEADER
+//   SCHEDULE::PLAN 					-> exactly the struct the player walks
+//   SOUND [plan.soundsCount] 			-> embedded PCM per sound, 'size == 0' when not embedded
+//   PCM 								-> s16 samples
+//
+//  With '--embed' '.opus' sounds are decoded at compile-time, playback then needs no decoding.
+//  Synthesized clicks are never embedded, they're rendered without any file I/O anyway.
+//  'planSize' changes with 'METRONOME_SCHEDULE_*' - such files are rejected, not converted.
+//
+
+#define METRONOME_COMPILED_MAGIC 		0x0042544D // "MTB\0"
+#define METRONOME_COMPILED_VERSION 		1
+#define METRONOME_COMPILED_EXTENSION 	".mtb"
+#define METRONOME_COMPILED_COMMAND 		"compile"
+
+static_assert (std::endian::native == std::endian::little, "Compiled sessions are stored little-endian.");
+
+
+namespace COMPILED {
+
+	struct HEADER {
+		u32 magic;
+		u16 version;
+		u16 headerSize;
+		u32 planSize;
+		u32 soundSize;
+		u64 planOffset;
+		u64 soundsOffset;
+		u64 fileSize;
+	};
+
+	struct SOUND {
+		u64 offset; 		// PCM
+		u32 size; 			// bytes
+		u32 frequency;
+		u8 channels;
+		u8 reserved [7];
+	};
+
+	struct LOADED {
+		IO::MAPPING mapping;
+		const SCHEDULE::PLAN* plan; 	// nullptr when nothing is loaded.
+		const SOUND* sounds;
+	};
+
+	constexpr u64 Align (
+		IN		const u64& 		offset
+	) {
+		return (offset + 7) & ~7ull;
+	}
+
+}
+
+
+namespace COMPILED {
+
+	void Fail (
+		IN		const c8* const& 	filename,
+		IN		const c8* const& 	message
+	) {
+		ERROR ("Compiled session '%s': %s\n", filename, message);
+	}
+
+	// Checks what the player relies on. Data is used in place afterwards.
+	void Validate (
+		IN		const c8* const& 	filename,
+		IN		const LOADED& 		loaded
+	) {
+		using ARGUMENTS::MAINARGS;
+
+		constexpr const auto& BPM 		= ARGUMENTS::OPTION::Find<&MAINARGS::bpm> ();
+		constexpr const auto& PATTERN 	= ARGUMENTS::OPTION::Find<&MAINARGS::pattern> ();
+		constexpr const auto& VOLUME 	= ARGUMENTS::OPTION::Find<&MAINARGS::volume> ();
+
+		const IO::MAPPING& mapping = loaded.mapping;
+		const SCHEDULE::PLAN& plan = *loaded.plan;
+
+		for (u8 i = 0; i < plan.soundsCount; ++i) {
+			if (memchr (plan.sounds[i], '\0', METRONOME_SCHEDULE_SOUND_LENGTH) == nullptr) Fail (filename, "a sound name is not terminated");
+
+			const SOUND& sound = loaded.sounds[i];
+			if (sound.size == 0) continue;
+
+			if (sound.offset % sizeof (s16) || sound.offset > mapping.size || sound.size > mapping.size - sound.offset) {
+				Fail (filename, "embedded PCM is out of the file");
+			}
+
+			if (sound.channels != 1 && sound.channels != 2) Fail (filename, "embedded PCM has an unsupported channel count");
+			if (sound.frequency == 0) Fail (filename, "embedded PCM has no frequency");
+		}
+
+		// The same ranges 'SESSION::ReadSections' enforces.
+		for (u32 i = 0; i < plan.sectionsCount; ++i) {
+			if (
+				plan.bpm[i] < BPM.min || plan.bpm[i] > BPM.max || plan.pattern[i] < PATTERN.min || plan.pattern[i] > PATTERN.max ||
+				plan.volume[i] < VOLUME.min || plan.volume[i] > VOLUME.max || plan.sound[i] >= plan.soundsCount
+			) {
+				Fail (filename, "a section is invalid");
+			}
+		}
+	}
+
+	void Load (
+		IN		const c8* const& 	filename,
+		OUT		LOADED& 			loaded
+	) {
+		const TIMESTAMP::Timestamp timestampBegin = TIMESTAMP::GetCurrent ();
+
+		IO::Map (filename, loaded.mapping);
+		MEMORY::EXIT::PUSH (IO::Unmap, 1, &loaded.mapping);
+
+		const IO::MAPPING& mapping = loaded.mapping;
+		const HEADER* header = (const HEADER*) mapping.data;
+
+		if (mapping.size < sizeof (HEADER) || header->magic != METRONOME_COMPILED_MAGIC) Fail (filename, "not a compiled session");
+		if (header->version != METRONOME_COMPILED_VERSION) Fail (filename, "unsupported version, compile it again");
+
+		if (
+			header->headerSize != sizeof (HEADER) || header->planSize != sizeof (SCHEDULE::PLAN) ||
+			header->soundSize != sizeof (SOUND) || header->fileSize != mapping.size
+		) {
+			Fail (filename, "compiled with different limits, compile it again");
+		}
+
+		if (
+			mapping.size < sizeof (SCHEDULE::PLAN) || header->planOffset % alignof (SCHEDULE::PLAN) ||
+			header->planOffset > mapping.size - sizeof (SCHEDULE::PLAN)
+		) {
+			Fail (filename, "the plan is out of the file");
+		}
+
+		loaded.plan = (const SCHEDULE::PLAN*)(mapping.data + header->planOffset);
+
+		const SCHEDULE::PLAN& plan = *loaded.plan;
+
+		if (plan.sectionsCount == 0 || plan.sectionsCount > METRONOME_SCHEDULE_SECTIONS) Fail (filename, "invalid sections count");
+		if (plan.soundsCount == 0 || plan.soundsCount > METRONOME_SCHEDULE_SOUNDS) Fail (filename, "invalid sounds count");
+
+		if (
+			mapping.size < plan.soundsCount * sizeof (SOUND) || header->soundsOffset % alignof (SOUND) ||
+			header->soundsOffset > mapping.size - plan.soundsCount * sizeof (SOUND)
+		) {
+			Fail (filename, "the sounds table is out of the file");
+		}
+
+		loaded.sounds = (const SOUND*)(mapping.data + header->soundsOffset);
+
+		Validate (filename, loaded);
+
+		LOGINFO (
+			"Compiled session '%s' loaded in %fs: %u sections, %u sounds.\n",
+			filename, TIMESTAMP::GetElapsed (timestampBegin), plan.sectionsCount, (u32)plan.soundsCount
+		);
+	}
+
+	// Returns false when the sound is not embedded.
+	bool Buffer (
+		IN		const LOADED& 		loaded,
+		IN		const u8& 			index,
+		INOUT	const ALuint& 		buffer
+	) {
+		if (loaded.plan == nullptr || loaded.sounds[index].size == 0) return false;
+
+		const SOUND& sound = loaded.sounds[index];
+		const ALenum format = sound.channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+
+		alBufferData (buffer, format, loaded.mapping.data + sound.offset, sound.size, sound.frequency);
+
+		if (alGetError () != AL_NO_ERROR) ERROR (METRONOME_MESSAGE_AUDIO "Failed to buffer embedded '%s'!\n", loaded.plan->sounds[index]);
+		return true;
+	}
+
+}
+
+
+namespace COMPILED {
+
+	void Write (
+		INOUT	FILE* const& 		file,
+		IN		const void* const& 	data,
+		IN		const u64& 			size,
+		IN		const c8* const& 	filename
+	) {
+		if (size && fwrite (data, size, 1, file) != 1) {
+			fclose (file);
+			ERROR ("Could not write to '%s'.\n", filename);
+		}
+	}
+
+	void Pad (
+		INOUT	FILE* const& 		file,
+		IN		const u64& 			from,
+		IN		const c8* const& 	filename
+	) {
+		const u8 zeros [8] {};
+		Write (file, zeros, Align (from) - from, filename);
+	}
+
+	void Compile (
+		IN		const c8* const& 				input,
+		IN		const c8* const& 				output,
+		IN		const bool& 					isEmbedding
+	) {
+		const ARGUMENTS::MAINARGS defaults = ARGUMENTS::Defaults ();
+		SCHEDULE::PLAN& plan = SCHEDULE::plan;
+
+		// Written as a whole. Being static it's zero-initialized, so are its unused entries.
+		SESSION::Load (input, defaults, plan);
+
+		HEADER header {};
+		header.magic 		= METRONOME_COMPILED_MAGIC;
+		header.version 		= METRONOME_COMPILED_VERSION;
+		header.headerSize 	= sizeof (HEADER);
+		header.planSize 	= sizeof (SCHEDULE::PLAN);
+		header.soundSize 	= sizeof (SOUND);
+		header.planOffset 	= Align (sizeof (HEADER));
+		header.soundsOffset = Align (header.planOffset + sizeof (SCHEDULE::PLAN));
+
+		SOUND sounds [METRONOME_SCHEDULE_SOUNDS] {};
+		s16* pcms [METRONOME_SCHEDULE_SOUNDS] {};
+		u64 offset = Align (header.soundsOffset + plan.soundsCount * sizeof (SOUND));
+
+		for (u8 i = 0; i < plan.soundsCount && isEmbedding; ++i) {
+			SYNTH::CLICK click;
+			if (SYNTH::Find (plan.sounds[i], click)) continue;
+
+			#ifndef METRONOME_MINIMAL
+				u32 samples;
+				OPUS::Decode (plan.sounds[i], pcms[i], samples, sounds[i].channels);
+
+				sounds[i].offset 	= offset;
+				sounds[i].size 		= samples * sounds[i].channels * sizeof (s16);
+				sounds[i].frequency = OPUS::SAMPLING_RATE;
+				offset = Align (offset + sounds[i].size);
+			#else
+				ERROR ("Unknown sound '%s'. Minimal build supports synthesized clicks only.\n", plan.sounds[i]);
+			#endif
+		}
+
+		header.fileSize = offset;
+
+		FILE* file = fopen (output, "wb");
+		if (file == nullptr) ERROR ("File could not be opened - '%s'.\n", output);
+
+		Write (file, &header, sizeof (HEADER), output);
+		Pad (file, sizeof (HEADER), output);
+		Write (file, &plan, sizeof (SCHEDULE::PLAN), output);
+		Pad (file, header.planOffset + sizeof (SCHEDULE::PLAN), output);
+		Write (file, sounds, plan.soundsCount * sizeof (SOUND), output);
+		Pad (file, header.soundsOffset + plan.soundsCount * sizeof (SOUND), output);
+
+		for (u8 i = 0; i < plan.soundsCount; ++i) {
+			if (sounds[i].size == 0) continue;
+			Write (file, pcms[i], sounds[i].size, output);
+			Pad (file, sounds[i].offset + sounds[i].size, output);
+		}
+
+		fclose (file);
+
+		for (u8 i = plan.soundsCount; i != 0; --i) { // Decoded PCM was pushed in order.
+			if (pcms[i - 1] == nullptr) continue;
+			MEMORY::EXIT::POP ();
+			FREE (1, pcms[i - 1]);
+		}
+
+		LOGINFO ("Compiled '%s' into '%s' (%" PRIu64 " bytes).\n", input, output, header.fileSize);
+	}
+
+	bool IsCommand (
+		IN		const s32& 			argumentsCount,
+		IN		c8** 				arguments
+	) {
+		return argumentsCount > 1 && strcmp (arguments[1], METRONOME_COMPILED_COMMAND) == 0;
+	}
+
+	// 'metronome compile <session.json> [-o <session.mtb>] [--embed]'. Exits when done.
+	void Command (
+		IN		const s32& 			argumentsCount,
+		IN		c8** 				arguments
+	) {
+		const c8* input = nullptr;
+		const c8* output = nullptr;
+		bool isEmbedding = false;
+
+		for (s32 i = 2; i < argumentsCount; ++i) {
+			const c8* const argument = arguments[i];
+
+			if (strcmp (argument, "-o") == 0 || strcmp (argument, "--output") == 0) {
+				if (i + 1 == argumentsCount) ERROR ("Invalid argument passed, '%s' expects a value\n", argument);
+				output = arguments[++i];
+			} else if (strcmp (argument, "-e") == 0 || strcmp (argument, "--embed") == 0) {
+				isEmbedding = true;
+			} else if (argument[0] != '-' && input == nullptr) {
+				input = argument;
+			} else {
+				ERROR ("Invalid argument passed, code: Not recognized argument '%s'\n", argument);
+			}
+		}
+
+		if (input == nullptr) ERROR ("Usage: metronome " METRONOME_COMPILED_COMMAND " <session.json> [-o <session.mtb>] [--embed]\n");
+
+		c8 replaced [METRONOME_SCHEDULE_SOUND_LENGTH];
+
+		if (output == nullptr) { // 'session.json' -> 'session.mtb'
+			const c8* const dot = strrchr (input, '.');
+			const u32 length = dot && !strpbrk (dot, "\\/") ? dot - input : strlen (input);
+
+			if (length + sizeof (METRONOME_COMPILED_EXTENSION) > sizeof (replaced)) ERROR ("Filename is too long - '%s'\n", input);
+
+			memcpy (replaced, input, length);
+			memcpy (replaced + length, METRONOME_COMPILED_EXTENSION, sizeof (METRONOME_COMPILED_EXTENSION));
+			output = replaced;
+		}
+
+		Compile (input, output, isEmbedding);
+
+		LOGSTOP ();
+		MEMORY::EXIT::ATEXIT ();
+		LOGMEMORY ();
+		exit (0);
+	}
+
+}
@@ -0,0 +1,580 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/timestamp.hpp>
+#include <blue/trace.hpp>
+#include <blue/timer_wheel.hpp>
+//
+#include <atomic>
+#include <threads.h>
+//
+#ifdef _WIN32
+	#include <winsock2.h> // Included before 'windows.h' in 'bluelib.hpp'.
+	#include <afunix.h>
+	#include <blue/windows/types.hpp>
+	#include <mmsystem.h>
+#else
+	#include <sys/socket.h>
+	#include <sys/select.h>
+	#include <sys/un.h>
+	#include <unistd.h>
+#endif
+//
+#include "arguments.hpp"
+#include "events.hpp"
+#include "audio.hpp"
+#include "synth.hpp"
+#include "latency.hpp"
+
+
+//  ABOUT
+// 'metronome daemon [socket]' - one process playing many independent click streams
+//  (sessions), each with its own tempo, pattern, volume and click. All of them are played by
+//  one scheduler thread that keeps sessions in a timer wheel by their next deadline - O(1)
+//  per beat however many sessions play. It sleeps until 'METRONOME_DAEMON_SPIN' before the
+//  earliest one and only spins for the rest, so an idle daemon doesn't keep a core busy.
+//  Clicks are played by a pool of OpenAL sources ('METRONOME_DAEMON_VOICES') taken in turn,
+//  OpenAL mixes them into the one output device. A click lasts 30ms, so a voice is reused
+//  long after its click ended unless more than ~8000 beats per second are played.
+//  Deadlines are when a beat is heard, clicks start the output's reported latency earlier.
+//
+//  Control is a line protocol over a unix domain socket (AF_UNIX, on windows too):
+//
+//  start <id> [bpm] [pattern] [volume] [click]    -> starts or replaces a session, click is
+//                                                    'synth-sine', 'synth-square' or 'synth-noise'
+//  set <id> <bpm|pattern|volume|click> <value>
+//  stop <id>
+//  list                                           -> "<id> <bpm> <pattern> <volume> <click>" lines
+//  shutdown
+//
+//  Every command is answered with "ok" or "error: <reason>". The control thread keeps what
+//  was asked for ('CONFIG') and hands every change to the scheduler through a single
+//  producer, single consumer ring ('REQUEST'). Only the scheduler touches sessions and AL.
+//
+//  Sessions play synthesized clicks only, '.opus' decoding per session isn't worth it here.
+//
+
+#define METRONOME_DAEMON_COMMAND 		"daemon"
+#define METRONOME_DAEMON_SOCKET 		"metronome.sock"
+#define METRONOME_DAEMON_SESSIONS 		4096
+#define METRONOME_DAEMON_VOICES 		256 		// OpenAL Soft mixes 256 sources by default.
+#define METRONOME_DAEMON_REQUESTS 		256 		// Power of two.
+#define METRONOME_DAEMON_CLIENTS 		8
+#define METRONOME_DAEMON_LINE 			256
+#define METRONOME_DAEMON_SPIN 			1000000 	// ns, spinning before a deadline - windows sleeps within 1ms.
+#define METRONOME_DAEMON_POLL 			5000000 	// ns, longest sleep - requests wait at most this.
+
+
+namespace DAEMON {
+
+	#ifndef _WIN32
+		using SOCKET = s32;
+		constexpr SOCKET INVALID_SOCKET = -1;
+	#endif
+
+	struct CONFIG {
+		bool isActive;
+		METRONOME_ARGUMENT_TYPE_BPM 		bpm;
+		METRONOME_ARGUMENT_TYPE_PATTERN 	pattern;
+		METRONOME_ARGUMENT_TYPE_VOLUME 		volume;
+		SYNTH::CLICK click;
+	};
+
+	struct REQUEST {
+		u16 id;
+		CONFIG config;
+	};
+
+	struct SESSION {
+		u64 deadline; 	// nanoseconds, in 'wheel' while playing
+		u64 spbNs;
+		u8 pattern;
+		u8 beat; 		// In the bar, 0 is accented.
+		r32 gain;
+		SYNTH::CLICK click;
+	};
+
+	std::atomic<bool> isRunning = true;
+
+	// Control thread.
+	CONFIG configs [METRONOME_DAEMON_SESSIONS];
+
+	// Control thread -> scheduler.
+	REQUEST requests [METRONOME_DAEMON_REQUESTS];
+	std::atomic<u32> requestsHead = 0; 	// Next to take.
+	std::atomic<u32> requestsTail = 0; 	// Next to fill.
+
+	// Scheduler thread.
+	SESSION sessions [METRONOME_DAEMON_SESSIONS];
+	TIMER::WHEEL<METRONOME_DAEMON_SESSIONS> wheel;
+	u16 voice = 0; 									// Next source to play.
+
+	ALuint buffers [SYNTH::CLICK_COUNT * 2]; 		// regular, accent - per click
+	ALuint sources [METRONOME_DAEMON_VOICES];
+
+	// Control thread. The longest reply is 'list'.
+	c8 reply [METRONOME_DAEMON_SESSIONS * 32 + 16];
+
+	static_assert ((METRONOME_DAEMON_REQUESTS & (METRONOME_DAEMON_REQUESTS - 1)) == 0, "Requests have to be a power of two.");
+
+}
+
+
+namespace DAEMON {
+
+	// Control thread only. False when the scheduler is behind by a whole ring.
+	bool Push (
+		IN		const REQUEST& 	request
+	) {
+		const u32 tail = requestsTail.load (std::memory_order_relaxed);
+		if (tail - requestsHead.load (std::memory_order_acquire) == METRONOME_DAEMON_REQUESTS) return false;
+
+		requests[tail & (METRONOME_DAEMON_REQUESTS - 1)] = request;
+		requestsTail.store (tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Scheduler thread only.
+	bool Pop (
+		OUT		REQUEST& 		request
+	) {
+		const u32 head = requestsHead.load (std::memory_order_relaxed);
+		if (head == requestsTail.load (std::memory_order_acquire)) return false;
+
+		request = requests[head & (METRONOME_DAEMON_REQUESTS - 1)];
+		requestsHead.store (head + 1, std::memory_order_release);
+		return true;
+	}
+
+	void Apply (
+		IN		const REQUEST& 	request,
+		IN		const u64& 		now
+	) {
+		const u16& id = request.id;
+		const CONFIG& config = request.config;
+		SESSION& session = sessions[id];
+		const bool isScheduled = wheel.IsScheduled (id);
+
+		if (!config.isActive) {
+			wheel.Remove (id);
+			return;
+		}
+
+		const u64 spbNs = 60000000000ull / config.bpm;
+
+		session.pattern = config.pattern;
+		session.gain 	= config.volume / 100.0f;
+		session.click 	= config.click;
+		if (session.beat >= session.pattern) session.beat = 0;
+
+		if (!isScheduled) { // First beat right away.
+			session.deadline 	= now;
+			session.spbNs 		= spbNs;
+			session.beat 		= 0;
+			wheel.Insert (id, session.deadline);
+		} else if (session.spbNs != spbNs) { // A new tempo counts from the last beat.
+			session.deadline 	= session.deadline - session.spbNs + spbNs;
+			session.spbNs 		= spbNs;
+			if (session.deadline < now) session.deadline = now; // Faster and already due.
+			wheel.Insert (id, session.deadline);
+		}
+	}
+
+	void Beat (
+		IN		const u16& 		id,
+		IN		const u64& 		now
+	) {
+		SESSION& session = sessions[id];
+		const ALuint& source = sources[voice];
+		const bool isAccent = session.beat == 0;
+
+		voice = (voice + 1) % METRONOME_DAEMON_VOICES;
+
+		TRACEEVENTAT (session.deadline - LATENCY::offset, EVENTS::BEAT_SCHEDULED, id);
+
+		alSourceStop (source); // Its previous click ended long ago, 'AL_BUFFER' needs it stopped.
+		alSourcei (source, AL_BUFFER, buffers[session.click * 2 + isAccent]);
+		alSourcef (source, AL_GAIN, isAccent ? session.gain : session.gain * 0.25f);
+		alSourcePlay (source);
+
+		TRACEEVENT (EVENTS::BEAT_PLAYED, id);
+
+		if (++session.beat == session.pattern) session.beat = 0;
+
+		// After a stall longer than a beat the missed beats are skipped, not played at once.
+		session.deadline += session.spbNs;
+		if (session.deadline <= now) session.deadline = now + session.spbNs;
+
+		wheel.Insert (id, session.deadline);
+	}
+
+	s32 Schedule (
+		INOUT	void* 			anyargs
+	) {
+
+		DEBUG (DEBUG_FLAG_LOGGING) {
+			if (anyargs != nullptr) LOGWARN ("Arguments passed to 'Schedule'!");
+		}
+
+		while (isRunning.load (std::memory_order_relaxed)) {
+			const u64 now = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+
+			for (REQUEST request; Pop (request);) Apply (request, now);
+
+			wheel.Expire (now + LATENCY::offset, [&] (const u32& id) { Beat (id, now); });
+
+			// A click started now is heard then.
+			const u64 heard = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ()) + LATENCY::offset;
+			const u64 next = wheel.GetNext (); // UINT64_MAX when nothing plays.
+
+			u64 wait = next <= heard + METRONOME_DAEMON_SPIN ? 0 : next - heard - METRONOME_DAEMON_SPIN;
+			if (wait > METRONOME_DAEMON_POLL) wait = METRONOME_DAEMON_POLL;
+
+			if (wait) {
+				const timespec duration { 0, (s64)wait };
+				thrd_sleep (&duration, nullptr);
+			}
+		}
+
+		return 0;
+	}
+
+}
+
+
+namespace DAEMON {
+
+	// Splits 'line' on spaces in place. Returns the tokens count.
+	u8 Split (
+		INOUT	c8* 				line,
+		OUT		c8** const& 		tokens,
+		IN		const u8& 			tokensMax
+	) {
+		u8 count = 0;
+
+		while (*line != '\0') {
+			for (; *line == ' ' || *line == '\t' || *line == '\r'; ++line) *line = '\0';
+			if (*line == '\0') break;
+			if (count == tokensMax) return tokensMax + 1;
+
+			tokens[count++] = line;
+			for (; *line != '\0' && *line != ' ' && *line != '\t' && *line != '\r'; ++line);
+		}
+
+		return count;
+	}
+
+	// False when 'text' isn't a number within 'min' and 'max'.
+	template <class T>
+	bool ReadNumber (
+		IN		const c8* const& 	text,
+		IN		const T& 			min,
+		IN		const T& 			max,
+		OUT		T& 					value
+	) {
+		u32 number = 0;
+		u8 i = 0;
+
+		for (; text[i] >= '0' && text[i] <= '9' && number <= UINT16_MAX; ++i) number = number * 10 + (text[i] - '0');
+		if (i == 0 || text[i] != '\0' || number < min || number > max) return false;
+
+		value = (T)number;
+		return true;
+	}
+
+	// Writes the answer into 'reply'. Returns false on 'shutdown'.
+	bool Handle (
+		INOUT	c8* const& 			line,
+		OUT		c8* const& 			reply,
+		IN		const u32& 			replySize
+	) {
+		using ARGUMENTS::MAINARGS;
+
+		constexpr const auto& BPM 		= ARGUMENTS::OPTION::Find<&MAINARGS::bpm> ();
+		constexpr const auto& PATTERN 	= ARGUMENTS::OPTION::Find<&MAINARGS::pattern> ();
+		constexpr const auto& VOLUME 	= ARGUMENTS::OPTION::Find<&MAINARGS::volume> ();
+
+		c8* tokens [6];
+		const u8 count = Split (line, tokens, 6);
+		u16 id;
+
+		#define FAIL(reason) { snprintf (reply, replySize, "error: " reason "\n"); return true; }
+
+		if (count == 0) FAIL ("empty command");
+		if (count > 6) FAIL ("too many arguments");
+
+		const c8* const name = tokens[0];
+
+		if (strcmp (name, "shutdown") == 0) {
+			snprintf (reply, replySize, "ok\n");
+			return false;
+		}
+
+		if (strcmp (name, "list") == 0) {
+			u32 length = 0;
+
+			for (u16 i = 0; i < METRONOME_DAEMON_SESSIONS && length < replySize; ++i) {
+				const CONFIG& config = configs[i];
+				if (!config.isActive) continue;
+
+				length += snprintf (
+					reply + length, replySize - length, "%u %u %u %u %s\n",
+					i, config.bpm, config.pattern, config.volume, SYNTH::NAMES[config.click]
+				);
+			}
+
+			if (length < replySize) snprintf (reply + length, replySize - length, "ok\n");
+			return true;
+		}
+
+		const bool isStart 	= strcmp (name, "start") == 0;
+		const bool isSet 	= strcmp (name, "set") == 0;
+		const bool isStop 	= strcmp (name, "stop") == 0;
+
+		if (!isStart && !isSet && !isStop) FAIL ("unknown command");
+		if (count < 2) FAIL ("expected a session id");
+
+		if (!ReadNumber<u16> (tokens[1], 0, METRONOME_DAEMON_SESSIONS - 1, id)) FAIL ("invalid session id");
+
+		CONFIG config = configs[id];
+
+		if (isStart) {
+			config = CONFIG { true, BPM.fallback, PATTERN.fallback, VOLUME.fallback, SYNTH::CLICK_SINE };
+
+			if (count > 2 && !ReadNumber (tokens[2], BPM.min, BPM.max, config.bpm)) 			FAIL ("invalid bpm");
+			if (count > 3 && !ReadNumber (tokens[3], PATTERN.min, PATTERN.max, config.pattern)) 	FAIL ("invalid pattern");
+			if (count > 4 && !ReadNumber (tokens[4], VOLUME.min, VOLUME.max, config.volume)) 	FAIL ("invalid volume");
+			if (count > 5 && !SYNTH::Find (tokens[5], config.click)) 			FAIL ("unknown click");
+		} else if (isSet) {
+			if (!config.isActive) FAIL ("session is not playing");
+			if (count != 4) FAIL ("expected 'set <id> <bpm|pattern|volume|click> <value>'");
+
+			const c8* const field = tokens[2];
+			const c8* const value = tokens[3];
+
+			if (strcmp (field, "bpm") == 0) 			{ if (!ReadNumber (value, BPM.min, BPM.max, config.bpm)) 			FAIL ("invalid bpm"); }
+			else if (strcmp (field, "pattern") == 0) 	{ if (!ReadNumber (value, PATTERN.min, PATTERN.max, config.pattern)) 	FAIL ("invalid pattern"); }
+			else if (strcmp (field, "volume") == 0) 	{ if (!ReadNumber (value, VOLUME.min, VOLUME.max, config.volume)) 		FAIL ("invalid volume"); }
+			else if (strcmp (field, "click") == 0) 		{ if (!SYNTH::Find (value, config.click)) 				FAIL ("unknown click"); }
+			else FAIL ("unknown field");
+		} else {
+			config.isActive = false;
+		}
+
+		{ // The scheduler drains the ring at least every 'METRONOME_DAEMON_POLL', a burst waits.
+			const timespec idle { 0, 1000000 }; // 1ms
+			bool isPushed = Push (REQUEST { id, config });
+
+			for (u8 i = 0; !isPushed && i < 2 * METRONOME_DAEMON_POLL / 1000000; ++i) {
+				thrd_sleep (&idle, nullptr);
+				isPushed = Push (REQUEST { id, config });
+			}
+
+			if (!isPushed) FAIL ("busy, try again");
+		}
+
+		#undef FAIL
+
+		configs[id] = config;
+		snprintf (reply, replySize, "ok\n");
+		return true;
+	}
+
+}
+
+
+namespace DAEMON {
+
+	void CloseSocket (
+		IN		const SOCKET& 		handle
+	) {
+		#ifdef _WIN32
+			closesocket (handle);
+		#else
+			close (handle);
+		#endif
+	}
+
+	SOCKET Listen (
+		IN		const c8* const& 	pathname
+	) {
+		#ifdef _WIN32
+			WSADATA wsa;
+			if (WSAStartup (MAKEWORD (2, 2), &wsa) != 0) ERROR ("Winsock could not be started.\n");
+		#endif
+
+		sockaddr_un address {};
+		address.sun_family = AF_UNIX;
+
+		if (strlen (pathname) >= sizeof (address.sun_path)) ERROR ("Socket path is too long - '%s'\n", pathname);
+		strcpy (address.sun_path, pathname);
+
+		const SOCKET listener = socket (AF_UNIX, SOCK_STREAM, 0);
+		if (listener == INVALID_SOCKET) ERROR ("Control socket could not be created.\n");
+
+		remove (pathname); // Left by a previous run.
+
+		if (bind (listener, (const sockaddr*)&address, sizeof (address)) != 0 || listen (listener, METRONOME_DAEMON_CLIENTS) != 0) {
+			ERROR ("Control socket '%s' could not be bound.\n", pathname);
+		}
+
+		return listener;
+	}
+
+	// Control thread. Serves clients until 'shutdown'.
+	void Serve (
+		IN		const SOCKET& 		listener
+	) {
+		SOCKET clients [METRONOME_DAEMON_CLIENTS];
+		c8 lines [METRONOME_DAEMON_CLIENTS][METRONOME_DAEMON_LINE];
+		u32 lengths [METRONOME_DAEMON_CLIENTS];
+		u8 clientsCount = 0;
+
+		while (isRunning.load (std::memory_order_relaxed)) {
+			fd_set readable;
+			FD_ZERO (&readable);
+			FD_SET (listener, &readable);
+
+			SOCKET highest = listener;
+			for (u8 i = 0; i < clientsCount; ++i) {
+				FD_SET (clients[i], &readable);
+				if (clients[i] > highest) highest = clients[i];
+			}
+
+			timeval timeout { 0, 250000 };
+			if (select (highest + 1, &readable, nullptr, nullptr, &timeout) <= 0) continue;
+
+			if (FD_ISSET (listener, &readable)) {
+				const SOCKET client = accept (listener, nullptr, nullptr);
+
+				if (client == INVALID_SOCKET) {
+				} else if (clientsCount == METRONOME_DAEMON_CLIENTS) {
+					send (client, "error: too many clients\n", 24, 0);
+					CloseSocket (client);
+				} else {
+					lengths[clientsCount] = 0;
+					clients[clientsCount++] = client;
+				}
+			}
+
+			for (u8 i = 0; i < clientsCount; ++i) {
+				if (!FD_ISSET (clients[i], &readable)) continue;
+
+				c8* const line = lines[i];
+				u32& length = lengths[i];
+
+				const s32 received = recv (clients[i], line + length, METRONOME_DAEMON_LINE - 1 - length, 0);
+
+				if (received <= 0) { // Disconnected.
+					CloseSocket (clients[i]);
+					--clientsCount;
+
+					if (i != clientsCount) { // The last client takes its place.
+						clients[i] = clients[clientsCount];
+						lengths[i] = lengths[clientsCount];
+						memcpy (lines[i], lines[clientsCount], lengths[i]);
+					}
+
+					--i;
+					continue;
+				}
+
+				length += received;
+
+				for (c8* end; (end = (c8*)memchr (line, '\n', length)) != nullptr;) {
+					*end = '\0';
+					const u32 used = end - line + 1;
+
+					if (!Handle (line, reply, sizeof (reply))) isRunning.store (false, std::memory_order_relaxed);
+					send (clients[i], reply, strlen (reply), 0);
+
+					length -= used;
+					memmove (line, line + used, length);
+				}
+
+				if (length == METRONOME_DAEMON_LINE - 1) { // No new-line in a whole line.
+					send (clients[i], "error: line too long\n", 21, 0);
+					length = 0;
+				}
+			}
+		}
+
+		for (u8 i = 0; i < clientsCount; ++i) CloseSocket (clients[i]);
+	}
+
+	bool IsCommand (
+		IN		const s32& 			argumentsCount,
+		IN		c8** 				arguments
+	) {
+		return argumentsCount > 1 && strcmp (arguments[1], METRONOME_DAEMON_COMMAND) == 0;
+	}
+
+	// 'metronome daemon [socket]'. Exits on 'shutdown'.
+	void Command (
+		IN		const s32& 			argumentsCount,
+		IN		c8** 				arguments
+	) {
+		if (argumentsCount > 3) ERROR ("Usage: metronome " METRONOME_DAEMON_COMMAND " [socket]\n");
+
+		const c8* const pathname = argumentsCount == 3 ? arguments[2] : METRONOME_DAEMON_SOCKET;
+
+		ALCdevice* device;
+		ALCcontext* context;
+
+		{ // OPENAL INIT
+			AUDIO::LISTENER::Create (device, context);
+			AUDIO::LISTENER::SetPosition (0.0f, 0.0f, 0.0f);
+			AUDIO::LISTENER::SetGain (1.0f);
+			LATENCY::Set (device, 0);
+
+			alGenBuffers (SYNTH::CLICK_COUNT * 2, buffers);
+			MEMORY::EXIT::PUSH (AL_WRAPPER::DestroyBuffers, SYNTH::CLICK_COUNT * 2, buffers);
+
+			for (u8 i = 0; i < SYNTH::CLICK_COUNT; ++i) SYNTH::Load (buffers[i * 2], buffers[i * 2 + 1], (SYNTH::CLICK)i);
+
+			alGenSources (METRONOME_DAEMON_VOICES, sources);
+			if (alGetError () != AL_NO_ERROR) ERROR (METRONOME_MESSAGE_AUDIO "Couldn't create %u OpenAL sources.", METRONOME_DAEMON_VOICES);
+			MEMORY::EXIT::PUSH (AL_WRAPPER::DestroySources, METRONOME_DAEMON_VOICES, sources);
+		}
+
+		const SOCKET listener = Listen (pathname);
+		printf ("Daemon listening on '%s'.\n", pathname);
+
+		#ifdef _WIN32
+			timeBeginPeriod (1); // 'thrd_sleep' wakes up within a millisecond.
+		#endif
+
+		wheel.Create (TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ()));
+
+		thrd_t scheduler;
+		thrd_create (&scheduler, Schedule, nullptr);
+
+		Serve (listener);
+
+		thrd_join (scheduler, nullptr);
+
+		#ifdef _WIN32
+			timeEndPeriod (1);
+		#endif
+
+		CloseSocket (listener);
+		remove (pathname);
+
+		#ifdef _WIN32
+			WSACleanup ();
+		#endif
+
+		alSourceStopv (METRONOME_DAEMON_VOICES, sources);
+
+		LOGINFO ("Daemon stopped.\n");
+
+		TRACEDUMP (METRONOME_TRACE_FILENAME);
+		LOGSTOP ();
+		MEMORY::EXIT::ATEXIT (); // Sources, buffers, context and device - in that order.
+		LOGMEMORY ();
+		exit (0);
+	}
+
+}
@@ -0,0 +1,34 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/types.hpp>
+
+//  ABOUT
+// Trace event types recorded via 'TRACEEVENT'. Shared with 'tracedump'.
+//
+
+namespace EVENTS {
+
+	enum TYPE: u16 {
+		BEAT_SCHEDULED 	= 0, // value: beat index, time: deadline
+		BEAT_PLAYED 	= 1, // value: beat index
+		SOURCE_STATE 	= 2, // value: AL_SOURCE_STATE
+		COMMAND 		= 3, // value: first character received, time: when received
+		SECTION 		= 4, // value: section index, at its first beat
+		CLOCK_SCHEDULED = 5, // value: MIDI clock index, time: deadline
+		CLOCK_SENT 		= 6, // value: MIDI clock index
+		COUNT 			= 7,
+	};
+
+	const c8* NAMES [COUNT] {
+		"beat scheduled",
+		"beat played",
+		"source state",
+		"command received",
+		"section entered",
+		"midi clock scheduled",
+		"midi clock sent",
+	};
+
+}
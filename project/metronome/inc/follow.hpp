@@ -0,0 +1,320 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/timestamp.hpp>
+//
+#include <atomic>
+#include <cmath>
+//
+#ifdef _WIN32
+	#include <blue/windows/types.hpp>
+	#include <mmsystem.h>
+#endif
+#ifdef __linux__
+	#include <threads.h>
+	#include <poll.h>
+	#include <unistd.h>
+#endif
+//
+#include "midi.hpp"
+
+
+//  ABOUT
+// Following an external MIDI clock. Every received clock is timestamped on arrival and fed
+//  to a phase-locked loop ('LOOP') - a second order (alpha-beta) tracker that predicts when
+//  the next clock is due and corrects its phase and period by a fraction of the error.
+//  Gains are larger until the averaged error settles (fast acquisition, tempo changes),
+//  then small gains average the arrival jitter out.
+//
+//  Clocks are counted from Start, every 24th one (the first included) is a beat. The player
+//  asks for the deadline of the next beat ('GetBeat') instead of using the session's tempo.
+//  Until the loop locks nothing is played. Stop pauses - nothing is played until Start or
+//  Continue, the tempo is kept. Continue resumes at the last Song Position Pointer (at the
+//  song's start without one), its first clock only sets the phase.
+//
+//  Input comes from a 'midiIn' device (winmm) or on linux from an ALSA raw MIDI device (see
+//  'midi.hpp'), read on a thread of its own. Elsewhere asking for a device is an error.
+//  The loop is written by the input callback (thread) and read by the player - through a
+//  sequence counter, odd while it's being written, the reader retries on a change.
+//
+
+#define METRONOME_FOLLOW_ALPHA 			0.05 	// Phase correction per clock.
+#define METRONOME_FOLLOW_BETA 			0.0013 	// Period correction per clock, ~ alpha^2 / 2.
+#define METRONOME_FOLLOW_ACQUIRE 		4 		// Gains are this many times larger until settled.
+#define METRONOME_FOLLOW_DRIFT 			0.1 	// Weight of a new error in the averaged one.
+#define METRONOME_FOLLOW_TOLERANCE 		0.02 	// Averaged error allowed to settle, of a period.
+#define METRONOME_FOLLOW_RELEASE 		0.08 	// Averaged error that unsettles, of a period.
+#define METRONOME_FOLLOW_SETTLED 		48 		// Settled clocks to lock, 2 beats.
+#define METRONOME_FOLLOW_POLL 			100 	// ms, how long the linux input waits before checking 'Close'.
+
+
+namespace FOLLOW {
+
+	struct LOOP {
+		u32 clocks; 	// Received since Start.
+		u64 phase; 		// Estimated time of the last clock, nanoseconds.
+		r64 period; 	// Estimated nanoseconds per clock.
+		r64 drift; 		// Averaged error. Jitter averages out, a wrong estimate doesn't.
+		u8 settled; 	// Consecutive clocks within tolerance.
+		bool isLocked; 	// Once locked it stays locked until Start.
+		bool isPaused; 	// After Stop, until Start or Continue.
+		bool isResumed; // After Continue, until its first clock.
+		u32 position; 	// Clock a Continue resumes at, from the last Song Position Pointer.
+	};
+
+	#ifdef _WIN32
+		HMIDIIN input = nullptr;
+	#else
+		FILE* input = nullptr; 	// Read through its descriptor, not buffered.
+	#endif
+
+	#ifdef __linux__
+		thrd_t receiver;
+		std::atomic<bool> isReceiving = false;
+	#endif
+
+	LOOP loop;
+	std::atomic<u32> sequence = 0;
+
+}
+
+
+namespace FOLLOW {
+
+	void Reset (
+		OUT		LOOP& 			loop
+	) {
+		loop = LOOP {};
+	}
+
+	void Feed (
+		INOUT	LOOP& 			loop,
+		IN		const u64& 		time
+	) {
+		if (loop.clocks++ == 0 || loop.isResumed) {
+			loop.phase = time;
+			loop.isResumed = false;
+			return;
+		}
+
+		if (loop.period == 0) {
+			loop.period = (r64)(time - loop.phase);
+			loop.phase = time;
+			return;
+		}
+
+		const r64 predicted = (r64)loop.phase + loop.period;
+		const r64 error = (r64)time - predicted;
+
+		if (std::fabs (error) > loop.period * 0.5) { // A lost clock or a jump. Acquire again.
+			const r64 missed = std::round (error / loop.period); // Lost clocks still count to a beat.
+			if (missed > 0) loop.clocks += (u32)missed;
+
+			loop.phase = time;
+			loop.settled = 0;
+			return;
+		}
+
+		const bool isSettled = loop.settled == METRONOME_FOLLOW_SETTLED;
+		const r64 gain = isSettled ? 1 : METRONOME_FOLLOW_ACQUIRE;
+		const r64 tolerance = isSettled ? METRONOME_FOLLOW_RELEASE : METRONOME_FOLLOW_TOLERANCE;
+
+		loop.phase = (u64)(predicted + gain * METRONOME_FOLLOW_ALPHA * error);
+		loop.period += gain * gain * METRONOME_FOLLOW_BETA * error;
+		loop.drift += (error - loop.drift) * METRONOME_FOLLOW_DRIFT;
+
+		if (std::fabs (loop.drift) > loop.period * tolerance) loop.settled = 0;
+		else if (loop.settled < METRONOME_FOLLOW_SETTLED) ++loop.settled;
+
+		loop.isLocked |= loop.settled == METRONOME_FOLLOW_SETTLED;
+	}
+
+	// Stop. The tempo is kept.
+	void Pause (
+		INOUT	LOOP& 			loop
+	) {
+		loop.isPaused = true;
+	}
+
+	// Continue. The next clock is the one at 'position'.
+	void Resume (
+		INOUT	LOOP& 			loop
+	) {
+		loop.clocks = loop.position;
+		loop.isPaused = false;
+		loop.isResumed = true;
+	}
+
+	// Song Position Pointer, 'sixteenths' since the song's start (6 clocks each).
+	void Position (
+		INOUT	LOOP& 			loop,
+		IN		const u16& 		sixteenths
+	) {
+		loop.position = sixteenths * (METRONOME_MIDI_PPQN / 4);
+	}
+
+	// Input callback only.
+	template <class Function>
+	void Write (
+		IN		Function 		function
+	) {
+		sequence.fetch_add (1, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_release);
+		function (loop);
+		sequence.fetch_add (1, std::memory_order_release);
+	}
+
+	LOOP Read () {
+		LOOP copy;
+		u32 before;
+
+		do {
+			before = sequence.load (std::memory_order_acquire);
+			copy = loop;
+			std::atomic_thread_fence (std::memory_order_acquire);
+		} while ((before & 1) || before != sequence.load (std::memory_order_relaxed));
+
+		return copy;
+	}
+
+	// Deadline of the first beat due after 'after' and the beat's length. False until locked.
+	bool GetBeat (
+		IN		const LOOP& 	loop,
+		IN		const u64& 		after,
+		OUT		u64& 			deadline,
+		OUT		u64& 			spbNs
+	) {
+		if (!loop.isLocked || loop.isPaused || loop.isResumed) return false;
+
+		const s64 last = loop.clocks - 1;
+		const s64 next = last + (s64)std::floor (((r64)after - (r64)loop.phase) / loop.period) + 1;
+		const s64 beat = (next + METRONOME_MIDI_PPQN - 1) / METRONOME_MIDI_PPQN * METRONOME_MIDI_PPQN;
+
+		deadline 	= loop.phase + (u64)((beat - last) * loop.period);
+		spbNs 		= (u64)(loop.period * METRONOME_MIDI_PPQN);
+		return true;
+	}
+
+	// A message received at 'time'. 'value' is a Song Position Pointer's.
+	void Dispatch (
+		IN		const u8& 		status,
+		IN		const u16& 		value,
+		IN		const u64& 		time
+	) {
+		switch (status) {
+			case METRONOME_MIDI_CLOCK: Write ([&] (LOOP& loop) { Feed (loop, time); }); break;
+			case METRONOME_MIDI_START: Write ([] (LOOP& loop) { Reset (loop); }); break;
+			case METRONOME_MIDI_CONTINUE: Write ([] (LOOP& loop) { Resume (loop); }); break;
+			case METRONOME_MIDI_STOP: Write ([] (LOOP& loop) { Pause (loop); }); break;
+			case METRONOME_MIDI_SONG_POSITION: Write ([&] (LOOP& loop) { Position (loop, value); }); break;
+		}
+	}
+
+	#ifdef _WIN32
+		void CALLBACK Receive (
+			IN		HMIDIIN 		handle,
+			IN		UINT 			message,
+			IN		DWORD_PTR 		instance,
+			IN		DWORD_PTR 		first,
+			IN		DWORD_PTR 		second
+		) {
+			if (message != MIM_DATA) return;
+
+			const u64 time = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+			Dispatch (first & 0xFF, (first >> 8 & 0x7F) | (first >> 16 & 0x7F) << 7, time);
+		}
+	#elif defined (__linux__)
+		// Reads the device until 'Close'. Real-time messages are single bytes and can come
+		//  between any others, the data of everything but a Song Position Pointer is skipped.
+		s32 Receive (
+			INOUT	void* 			anyargs
+		) {
+
+			DEBUG (DEBUG_FLAG_LOGGING) {
+				if (anyargs != nullptr) LOGWARN ("Arguments passed to 'FOLLOW::Receive'!");
+			}
+
+			pollfd readable { fileno (input), POLLIN, 0 };
+			u8 bytes [64], data [2];
+			u8 status = 0, count = 0;
+
+			while (isReceiving.load (std::memory_order_relaxed)) {
+				if (poll (&readable, 1, METRONOME_FOLLOW_POLL) <= 0) continue;
+
+				const u64 time = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+				const ssize_t size = read (readable.fd, bytes, sizeof (bytes));
+
+				if (size <= 0) {
+					LOGWARN ("MIDI input stopped, the last tempo is kept.\n");
+					break;
+				}
+
+				for (ssize_t i = 0; i < size; ++i) {
+					const u8& byte = bytes[i];
+
+					if (byte >= METRONOME_MIDI_CLOCK) Dispatch (byte, 0, time); // Real-time.
+					else if (byte & 0x80) { status = byte; count = 0; }
+					else if (status == METRONOME_MIDI_SONG_POSITION) {
+						data[count++] = byte;
+						if (count == 2) { Dispatch (status, data[0] | data[1] << 7, time); status = 0; }
+					}
+				}
+			}
+
+			return 0;
+		}
+	#endif
+
+	// 'device' counts from 1, 0 means the session's tempo is used.
+	void Open (
+		IN		const u8& 		device
+	) {
+		if (device == 0) return;
+
+		#ifdef _WIN32
+			const u32 devicesCount = midiInGetNumDevs ();
+			if (device > devicesCount) ERROR ("MIDI input %u does not exist, there are %u.\n", device, devicesCount);
+
+			MIDIINCAPSA capabilities;
+			if (midiInGetDevCapsA (device - 1, &capabilities, sizeof (capabilities)) == MMSYSERR_NOERROR) {
+				LOGINFO ("Following MIDI clock from: '%s'\n", capabilities.szPname);
+			}
+
+			if (midiInOpen (&input, device - 1, (DWORD_PTR)Receive, 0, CALLBACK_FUNCTION) != MMSYSERR_NOERROR) {
+				ERROR ("MIDI input %u could not be opened.\n", device);
+			}
+
+			midiInStart (input);
+		#elif defined (__linux__)
+			c8 pathname [METRONOME_MIDI_PATH];
+			const u32 devicesCount = MIDI::GetDevices (device, pathname);
+			if (device > devicesCount) ERROR ("MIDI input %u does not exist, there are %u.\n", device, devicesCount);
+
+			input = fopen (pathname, "rb");
+			if (input == nullptr) ERROR ("MIDI input %u ('%s') could not be opened.\n", device, pathname);
+
+			LOGINFO ("Following MIDI clock from: '%s'\n", pathname);
+
+			isReceiving = true;
+			thrd_create (&receiver, Receive, nullptr);
+		#else
+			ERROR ("MIDI input is only available on windows and linux.\n");
+		#endif
+	}
+
+	void Close () {
+		#ifdef _WIN32
+			if (input) { midiInStop (input); midiInClose (input); }
+		#elif defined (__linux__)
+			if (input) {
+				isReceiving = false;
+				thrd_join (receiver, nullptr);
+				fclose (input);
+			}
+		#endif
+		input = nullptr;
+	}
+
+}
@@ -2,59 +2,365 @@
 //  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
 //
 #pragma once
+#include <blue/trace.hpp>
+#include <blue/pool.hpp>
 //
 #include "resources.hpp"
+#include "events.hpp"
 #include "audio.hpp"
-#include "opus.hpp"
+#include "synth.hpp"
+#include "latency.hpp"
+#include "schedule.hpp"
+#include "bank.hpp"
+#include "midi.hpp"
+#include "follow.hpp"
+#include "sync.hpp"
+#include "peers.hpp"
+#include "onset.hpp"
+#ifndef METRONOME_MINIMAL
+	#include "opus.hpp"
+#endif
 
 
 namespace GLOBAL {
 
 	u8 isStopPlayback = true;
 
+	//  ABOUT
+	// Commands are created by 'INPUT' and 'OSC' while playing. They come from a pool so that
+	//  neither the producers nor the playback thread ever call 'malloc' after playback started.
+	//  Commands are pushed onto 'command' (a lock-free stack), the playback thread takes all of
+	//  them at once and applies them in the order they were pushed. When the pool is exhausted
+	//  a command is dropped and counted, a flood doesn't reach the log.
+	//
+	struct COMMAND {
+		c8 code;
+		u16 value;
+		u64 time; 	// nanoseconds
+		COMMAND* next;
+	};
+
+	#define METRONOME_COMMAND_BPM 			'b'
+	#define METRONOME_COMMAND_PATTERN 		'p'
+	#define METRONOME_COMMAND_VOLUME 		'v'
+	#define METRONOME_COMMAND_START 		's'
+	#define METRONOME_COMMAND_STOP 			'x'
+
+	using COMMANDS = MEMORY::POOL<COMMAND, 64>;
+
+	std::atomic<COMMAND*> command = nullptr;
+	std::atomic<u64> commandsDropped = 0;
+
 }
 
 
 namespace GLOBAL {
 
-	void PlayBPM (
-		IN 		const u16 bpm,
-        IN 		const u8 pattern,
-		IN		const ALuint source
+	void PushCommand (
+		IN		const c8& 		code,
+		IN		const u16& 		value = 0
 	) {
-		const r32 spb = 60.0 / bpm; // Seconds per beat
+		COMMAND* created = COMMANDS::Allocate (COMMAND { code, value, TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ()), nullptr });
+		if (created == nullptr) { commandsDropped.fetch_add (1, std::memory_order_relaxed); return; }
+
+		created->next = command.load (std::memory_order_relaxed);
+		while (!command.compare_exchange_weak (created->next, created, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// Returns taken commands oldest first or nullptr. Each has to be given back with 'COMMANDS::Free'.
+	COMMAND* TakeCommands () {
+		COMMAND* taken = command.exchange (nullptr, std::memory_order_acquire);
+		COMMAND* ordered = nullptr;
+
+		while (taken) {
+			COMMAND* next = taken->next;
+			taken->next = ordered;
+			ordered = taken;
+			taken = next;
+		}
+
+		return ordered;
+	}
+
+}
+
+
+namespace GLOBAL {
+
+	struct SECTION {
+		u64 spbNs; 			// Nanoseconds per beat
+		u8 pattern; 		// Beats before an accent.
+		u32 beats; 			// UINT32_MAX -> until stopped
+		u32 beatsLeft;
+		ALuint source;
+		ALuint accentSource;
+	};
+
+	// Called at the first beat of a section, before it's played.
+	void EnterSection (
+		OUT		SECTION& 					current,
+		IN		const SCHEDULE::PLAN& 		plan,
+		IN		const u32& 					index,
+		IN		const ALuint* const& 		sources // regular, accent - per sound
+	) {
+		const u16 bpm = plan.bpm[index];
+		const u8 sound = plan.sound[index];
+
+		current.spbNs 			= 60000000000ull / bpm;
+		current.pattern 		= plan.pattern[index] - 1; // 1 means every beat is an accent.
+		current.beats 			= plan.bars[index] ? plan.bars[index] * plan.pattern[index] : UINT32_MAX;
+		current.beatsLeft 		= current.beats;
+		current.source 			= sources[sound * 2];
+		current.accentSource 	= sources[sound * 2 + 1];
+
+		AUDIO::LISTENER::SetGain (plan.volume[index] / 100.0f);
+
+		TRACEEVENT (EVENTS::SECTION, index);
+	}
+
+	// A reloaded session continues at the same section and beat of that section.
+	void Swap (
+		INOUT	SECTION& 					current,
+		INOUT	const BANK::SLOT*& 			slot,
+		INOUT	u32& 						section,
+		IN		const BANK::SLOT* const& 	swapped
+	) {
+		const u32 played = current.beats - current.beatsLeft;
+		const SCHEDULE::PLAN& plan = *swapped->plan;
+
+		slot = swapped;
+		if (section >= plan.sectionsCount) section = plan.sectionsCount - 1;
+
+		EnterSection (current, plan, section, slot->sounds.sources);
+		current.beatsLeft = current.beats > played ? current.beats - played : 0;
+	}
+
+	// Tempo, pattern and volume change the current section until the next one. Values out of
+	//  the options' range are ignored (keyboard commands have none). Returns the last transport
+	//  command - 'START', 'STOP' or 0.
+	c8 ApplyCommands (
+		INOUT	SECTION& 					current
+	) {
+		using ARGUMENTS::MAINARGS;
+
+		constexpr const auto& BPM 		= ARGUMENTS::OPTION::Find<&MAINARGS::bpm> ();
+		constexpr const auto& PATTERN 	= ARGUMENTS::OPTION::Find<&MAINARGS::pattern> ();
+		constexpr const auto& VOLUME 	= ARGUMENTS::OPTION::Find<&MAINARGS::volume> ();
+
+		c8 transport = 0;
+
+		for (COMMAND* taken = TakeCommands (); taken != nullptr;) {
+			COMMAND* const next = taken->next;
+			const u16 value = taken->value;
+
+			TRACEEVENTAT (taken->time, EVENTS::COMMAND, taken->code);
+
+			switch (taken->code) {
+				case METRONOME_COMMAND_BPM: {
+					if (value >= BPM.min && value <= BPM.max) current.spbNs = 60000000000ull / value;
+				} break;
+
+				case METRONOME_COMMAND_PATTERN: {
+					if (value >= PATTERN.min && value <= PATTERN.max) current.pattern = value - 1;
+				} break;
+
+				case METRONOME_COMMAND_VOLUME: {
+					if (value >= VOLUME.min && value <= VOLUME.max) AUDIO::LISTENER::SetGain (value / 100.0f);
+				} break;
+
+				case METRONOME_COMMAND_START:
+				case METRONOME_COMMAND_STOP: transport = taken->code; break;
+			}
+
+			COMMANDS::Free (taken);
+			taken = next;
+		}
+
+		return transport;
+	}
+
+	bool IsFollowing () {
+		return FOLLOW::input || SYNC::IsFollowing () || PEERS::IsOpen ();
+	}
+
+	// Next beat after 'after' from a MIDI clock, a leader or the peers' session. The last two
+	//  set the bar too. False until there's one to follow.
+	bool GetFollowedBeat (
+		IN		const u64& 					after,
+		OUT		u64& 						deadline,
+		INOUT	SECTION& 					current,
+		INOUT	u8& 						patternIterator
+	) {
+		if (FOLLOW::input) return FOLLOW::GetBeat (FOLLOW::Read (), after, deadline, current.spbNs);
+		if (PEERS::IsOpen ()) return SYNC::GetBeat (PEERS::Read ().estimate, after, deadline, current.spbNs, current.pattern, patternIterator);
+		return SYNC::GetBeat (SYNC::Read (SYNC::estimate, SYNC::estimateSequence), after, deadline, current.spbNs, current.pattern, patternIterator);
+	}
+
+	void PlaySchedule (
+		IN		const BANK::SLOT* 			slot
+	) {
+		SECTION current;
+		u32 section = 0;
         u8 patternIterator = 0;
+		u32 beat = 0;
+		bool isPaused = false;
+
+		#if DDEBUG (DEBUG_FLAG_MEMORY)
+			const u64 allocationsBefore = allocationsTotal;
+		#endif
+
+		EnterSection (current, *slot->plan, section, slot->sounds.sources);
+
+		// Deadlines are absolute (nanoseconds), each beat is due one beat after the previous
+		//  deadline - not after the moment it was played - so late beats don't push the rest.
+		//  MIDI clocks are spread evenly between a beat's deadline and the next one.
+		//  When following a MIDI clock or a leader both come from its estimate, 'UINT64_MAX'
+		//  until it locks. A leader publishes every beat it plays, a peer only its tempo changes.
+		//  A deadline is when the beat is heard - its click starts 'LATENCY::offset' earlier,
+		//  its MIDI clock goes out on time.
+		u64 deadline = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ()) + current.spbNs;
+		u64 beatDeadline = deadline;
+		u64 clockBeat = 0; 				// Deadline the clocks count from.
+		u8 clock = METRONOME_MIDI_PPQN; // None before the first beat.
+
+		if (IsFollowing ()) {
+			printf (FOLLOW::input ? "Waiting for MIDI clock.\n" : PEERS::IsOpen () ? "Waiting for peers.\n" : "Waiting for the leader.\n");
+			deadline = UINT64_MAX;
+		}
 
 		// TODO
 		// Due to underneeth implementation this might be quite slow.
 		// TEST if it's actually fast or if it can be written as faster. 
-		TIMESTAMP::Timestamp timestampCurrent = TIMESTAMP::GetCurrent ();
 		while (isStopPlayback) {
 
-			r32 timePassed = TIMESTAMP::GetElapsed (timestampCurrent);
+			const u64 now = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+
+			if (command.load (std::memory_order_relaxed)) {
+				const u64 spbNs = current.spbNs;
+				const c8 transport = ApplyCommands (current);
+
+				// A new tempo counts from the last beat.
+				if (current.spbNs != spbNs && beat && deadline != UINT64_MAX) {
+					const u8 bar = (patternIterator + current.pattern) % (current.pattern + 1);
+					deadline = beatDeadline + current.spbNs;
+					SYNC::Publish (beatDeadline, current.spbNs, bar, current.pattern);
+					PEERS::Change (beatDeadline, current.spbNs, bar, current.pattern);
+					ONSET::Publish (beatDeadline, current.spbNs, beat - 1); // 'beatDeadline' is the last played beat's.
+				}
+
+				if (transport == METRONOME_COMMAND_STOP && !isPaused) {
+					isPaused = true;
+					clock = METRONOME_MIDI_PPQN;
+					clockBeat = beatDeadline;
+					MIDI::Stop ();
+					SYNC::Publish (0, 0, 0, 0);
+				} else if (transport == METRONOME_COMMAND_START && isPaused) { // From a bar start, right away.
+					const u32 beatsToBar = patternIterator == 0 ? 0 : patternIterator > current.pattern ? 1 : current.pattern + 1 - patternIterator;
+					if (beat) MIDI::Continue (beatsToBar); // Nothing to continue before the first beat, it sends Start.
+					isPaused = false;
+					patternIterator = 0;
+					deadline = IsFollowing () ? UINT64_MAX : now;
+					if (deadline != UINT64_MAX) ONSET::Publish (deadline, current.spbNs, beat); // Not the grid from before the pause.
+				}
+			}
+
+			if (isPaused) continue;
+
+			if (clock < METRONOME_MIDI_PPQN) {
+				const u64 clockDeadline = clockBeat + current.spbNs * clock / METRONOME_MIDI_PPQN;
+				if (now >= clockDeadline) { MIDI::Clock (clockDeadline); ++clock; }
+			} else if (beat && clockBeat != beatDeadline && now >= beatDeadline) { // A played beat is heard.
+				clockBeat = beatDeadline;
+				MIDI::Clock (clockBeat);
+				clock = 1;
+			}
+
+			if (deadline == UINT64_MAX && !GetFollowedBeat (now, deadline, current, patternIterator)) continue;
+
+			// A MIDI clock stopped since the beat was found - it isn't played, the next is found on Continue.
+			if (FOLLOW::input && now + LATENCY::offset >= deadline) {
+				const FOLLOW::LOOP loop = FOLLOW::Read ();
+				if (loop.isPaused || loop.isResumed) { deadline = UINT64_MAX; continue; }
+			}
+
+			if (now + LATENCY::offset >= deadline) {
+				TRACEEVENTAT (deadline - LATENCY::offset, EVENTS::BEAT_SCHEDULED, beat);
 
-			if (timePassed >= spb) {
-				timestampCurrent = TIMESTAMP::GetCurrent ();
-				//LOGINFO ("time: %f, spb: %f\n", timePassed, spb);
+				if (patternIterator == 0) { // Bar boundary. A reloaded session takes over here.
+					const BANK::SLOT* swapped = BANK::Take ();
+					if (swapped) Swap (current, slot, section, swapped);
+				}
+
+				if (current.beatsLeft == 0) { // Next section starts at this beat.
+					if (++section == slot->plan->sectionsCount) {
+						printf ("Session finished. Press enter to exit.\n");
+						break;
+					}
+
+					EnterSection (current, *slot->plan, section, slot->sounds.sources);
+					patternIterator = 0;
+				}
+
+                const u8 bar = patternIterator;
 
                 // Every pattern note is louder.
-                if (patternIterator < pattern) {
-                    AUDIO::SOURCE::SetGain (source, 0.25f);
+                if (patternIterator < current.pattern) {
+                    AUDIO::SOURCE::Play (current.source);
                     ++patternIterator;
                 } else {
-                    AUDIO::SOURCE::SetGain (source, 1.0f);
+                    AUDIO::SOURCE::Play (current.accentSource);
                     patternIterator = 0;
                 }
-                
-				AUDIO::SOURCE::Play (source);
+
+				TRACEEVENT (EVENTS::BEAT_PLAYED, beat);
+
+				if (beat == 0) MIDI::Start ();
+				beatDeadline = deadline;
+
+				SYNC::Publish (beatDeadline, current.spbNs, bar, current.pattern);
+				ONSET::Publish (beatDeadline, current.spbNs, beat);
+
+				DEBUG (DEBUG_FLAG_TRACING) {
+					ALint sourceState;
+					alGetSourcei (patternIterator ? current.source : current.accentSource, AL_SOURCE_STATE, &sourceState);
+					TRACEEVENT (EVENTS::SOURCE_STATE, sourceState);
+				}
+
+				--current.beatsLeft;
+				++beat;
+
+				// After a stall longer than a beat the missed beats are skipped, not played at once.
+				deadline += current.spbNs;
+				if (deadline <= now) deadline = now + current.spbNs;
+
+				if (IsFollowing ()) { // Half a beat on, so the beat just played isn't found again.
+					const u64 after = beatDeadline + current.spbNs / 2;
+					if (!GetFollowedBeat (after, deadline, current, patternIterator)) deadline = UINT64_MAX;
+				}
 			}
 
 		}
 
+		ApplyCommands (current);
+		COMMANDS::Detach (); // The player's thread exits next.
+		MIDI::Stop ();
+
+		if (commandsDropped.load (std::memory_order_relaxed)) {
+			LOGWARN ("%" PRIu64 " commands dropped. No free commands.\n", commandsDropped.load (std::memory_order_relaxed));
+		}
+
+		#if DDEBUG (DEBUG_FLAG_MEMORY)
+			if (allocationsTotal != allocationsBefore) {
+				LOGWARN ("Playback called 'ALLOCATE' %" PRIu64 " times.\n", allocationsTotal - allocationsBefore);
+			}
+		#endif
+
 		{ // Wait for source to stop playing. 
 			ALint sourceState;
 			do {
-				alGetSourcei (source, AL_SOURCE_STATE, &sourceState);
+				alGetSourcei (current.source, AL_SOURCE_STATE, &sourceState);
+				if (sourceState == AL_PLAYING) continue;
+				alGetSourcei (current.accentSource, AL_SOURCE_STATE, &sourceState);
 			} while (sourceState == AL_PLAYING);
 		}
 	}
@@ -0,0 +1,247 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/timestamp.hpp>
+//
+#include <threads.h>
+#include <algorithm>
+//
+#include <AL/alext.h>
+//
+#include "audio.hpp"
+#include "synth.hpp"
+
+
+//  ABOUT
+// A click is heard later than 'alSourcePlay' is called - the mixer, the system and the
+//  device each buffer some of it. Beat deadlines are when a beat is heard, MIDI clocks and
+//  peers go by them, so the player starts a click 'offset' before its deadline.
+//
+//  'offset' is what the output reports for itself (OpenAL Soft's 'ALC_SOFT_device_clock',
+//  0 elsewhere) and '--latency' on top of it for what it doesn't know about - converters,
+//  wireless speakers. 'metronome calibrate' measures the whole way: it plays clicks, records
+//  them through an input looped back from the output (or a microphone at the speaker) and
+//  finds each one's onset. What the input reports for itself is taken off, the rest beyond
+//  the output's own report is the '--latency' to pass for that output. Input latency nobody
+//  reports (its converter, an interface's own buffer) can't be told from the output's - it
+//  would make the '--latency' too long by as much, so it's passed as '[input ms]' if known.
+//
+//  Captured samples are placed on the clock by how many had arrived when they were taken -
+//  the earliest arrival seen is the closest to the truth.
+//
+
+#define METRONOME_LATENCY_COMMAND 		"calibrate"
+#define METRONOME_LATENCY_CLICKS 		8 			// Default.
+#define METRONOME_LATENCY_CLICKS_MAX 	32
+#define METRONOME_LATENCY_INTERVAL 		500 		// ms, between clicks
+#define METRONOME_LATENCY_WINDOW 		400 		// ms after a click its onset is looked for.
+#define METRONOME_LATENCY_NOISE 		50 			// ms before a click the noise is measured over.
+#define METRONOME_LATENCY_THRESHOLD 	8 			// Onset - that many times louder than the noise,
+#define METRONOME_LATENCY_FLOOR 		655 		//  and at least 2% of the full scale.
+#define METRONOME_LATENCY_RATE 			48000
+
+
+namespace LATENCY {
+
+	u64 reported = 0; 	// ns, by the output itself
+	u64 offset = 0; 	// ns, clicks start that much before their deadlines
+
+	// Every click and a quiet interval before the first one.
+	s16 captured [(METRONOME_LATENCY_CLICKS_MAX + 1) * METRONOME_LATENCY_INTERVAL * (METRONOME_LATENCY_RATE / 1000)];
+
+}
+
+
+namespace LATENCY {
+
+	// Nanoseconds between a sample being mixed and it leaving the device (or arriving in the
+	//  capture buffer). 0 when the implementation doesn't tell.
+	u64 GetReported (
+		IN		ALCdevice* const& 	device
+	) {
+		if (!alcIsExtensionPresent (device, "ALC_SOFT_device_clock")) return 0;
+
+		const auto getInteger64 = (LPALCGETINTEGER64VSOFT)alcGetProcAddress (device, "alcGetInteger64vSOFT");
+		if (getInteger64 == nullptr) return 0;
+
+		ALCint64SOFT latency = 0;
+		getInteger64 (device, ALC_DEVICE_LATENCY_SOFT, 1, &latency);
+		return latency > 0 ? (u64)latency : 0;
+	}
+
+	// 'extra' milliseconds on top of what 'device' reports.
+	void Set (
+		IN		ALCdevice* const& 	device,
+		IN		const u16& 			extra
+	) {
+		reported 	= GetReported (device);
+		offset 		= reported + extra * 1000000ull;
+
+		LOGINFO ("Output latency: %.2f ms reported, %u ms added.\n", reported / 1e6, extra);
+		if (offset) printf ("Clicks start %.2f ms before their beats.\n", offset / 1e6);
+	}
+
+	// First sample past 'begin' louder than the noise before it or UINT32_MAX.
+	u32 FindOnset (
+		IN		const s16* const& 	samples,
+		IN		const u32& 			count,
+		IN		const u32& 			begin
+	) {
+		constexpr u32 NOISE 	= METRONOME_LATENCY_NOISE * (METRONOME_LATENCY_RATE / 1000);
+		constexpr u32 WINDOW 	= METRONOME_LATENCY_WINDOW * (METRONOME_LATENCY_RATE / 1000);
+
+		if (begin < NOISE || begin >= count) return UINT32_MAX;
+
+		r64 energy = 0;
+		for (u32 i = begin - NOISE; i < begin; ++i) energy += (r64)samples[i] * samples[i];
+
+		const r64 noise = sqrt (energy / NOISE) * METRONOME_LATENCY_THRESHOLD;
+		const s32 threshold = noise > METRONOME_LATENCY_FLOOR ? (s32)noise : METRONOME_LATENCY_FLOOR;
+		const u32 end = begin + WINDOW < count ? begin + WINDOW : count;
+
+		for (u32 i = begin; i < end; ++i) if (abs (samples[i]) > threshold) return i;
+		return UINT32_MAX;
+	}
+
+	bool IsCommand (
+		IN		const s32& 			argumentsCount,
+		IN		c8** 				arguments
+	) {
+		return argumentsCount > 1 && strcmp (arguments[1], METRONOME_LATENCY_COMMAND) == 0;
+	}
+
+	// 'metronome calibrate [clicks] [input ms]'. Reports the latency and exits.
+	void Command (
+		IN		const s32& 			argumentsCount,
+		IN		c8** 				arguments
+	) {
+		u32 clicks = METRONOME_LATENCY_CLICKS;
+		s32 unreported = 0; // ms, input's
+
+		if (argumentsCount > 2) clicks = atoi (arguments[2]);
+		if (argumentsCount > 3) unreported = atoi (arguments[3]);
+		if (argumentsCount > 4 || clicks == 0 || clicks > METRONOME_LATENCY_CLICKS_MAX || unreported < 0) {
+			ERROR ("Usage: metronome " METRONOME_LATENCY_COMMAND " [clicks] [input ms], 1-%u clicks\n", METRONOME_LATENCY_CLICKS_MAX);
+		}
+
+		ALCdevice* device;
+		ALCcontext* context;
+		ALuint buffers [2];
+		ALuint source;
+
+		{ // OPENAL INIT
+			AUDIO::LISTENER::Create (device, context);
+			AUDIO::LISTENER::SetPosition (0.0f, 0.0f, 0.0f);
+			AUDIO::LISTENER::SetGain (1.0f);
+
+			alGenBuffers (2, buffers);
+			MEMORY::EXIT::PUSH (AL_WRAPPER::DestroyBuffers, 2, buffers);
+			SYNTH::Load (buffers[0], buffers[1], SYNTH::CLICK_SQUARE);
+
+			alGenSources (1, &source);
+			MEMORY::EXIT::PUSH (AL_WRAPPER::DestroySources, 1, &source);
+			AUDIO::SOURCE::SetBuffer (source, buffers[1]);
+		}
+
+		ALCdevice* const input = alcCaptureOpenDevice (nullptr, METRONOME_LATENCY_RATE, AL_FORMAT_MONO16, METRONOME_LATENCY_RATE / 2);
+		if (input == nullptr) ERROR (METRONOME_MESSAGE_AUDIO "Couldn't open a capture device. Loop the output back into an input or use a microphone.\n");
+		MEMORY::EXIT::PUSH (AL_WRAPPER::CloseCaptureDevice, 1, input);
+
+		const c8* const name = alcGetString (device, ALC_DEVICE_SPECIFIER);
+		printf ("Calibrating '%s' with %u clicks.\n", name, clicks);
+
+		#ifdef _WIN32
+			timeBeginPeriod (1); // 'thrd_sleep' wakes up within a millisecond.
+		#endif
+
+		const timespec poll { 0, 1000000 };
+		u64 played [METRONOME_LATENCY_CLICKS_MAX];
+		u64 origin = UINT64_MAX; 	// Time of the first sample.
+		u32 count = 0;
+		u32 click = 0;
+
+		alcCaptureStart (input);
+
+		const u64 start = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+		const u64 end = start + (clicks + 1) * METRONOME_LATENCY_INTERVAL * 1000000ull;
+
+		for (u64 now = start; now < end; now = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ())) {
+			const u64 deadline = start + (click + 1) * METRONOME_LATENCY_INTERVAL * 1000000ull;
+
+			if (click < clicks && now >= deadline) {
+				AUDIO::SOURCE::Play (source);
+				played[click++] = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+			}
+
+			ALCint available = 0;
+			alcGetIntegerv (input, ALC_CAPTURE_SAMPLES, 1, &available);
+
+			const u32 room = sizeof (captured) / sizeof (*captured) - count;
+			if ((u32)available > room) available = room;
+
+			if (available > 0) {
+				alcCaptureSamples (input, captured + count, available);
+				count += available;
+
+				const u64 arrived = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ()) - count * 1000000000ull / METRONOME_LATENCY_RATE;
+				if (arrived < origin) origin = arrived;
+			}
+
+			thrd_sleep (&poll, nullptr);
+		}
+
+		alcCaptureStop (input);
+
+		#ifdef _WIN32
+			timeEndPeriod (1);
+		#endif
+
+		const u64 output = GetReported (device);
+		const u64 capture = GetReported (input);
+
+		r64 latencies [METRONOME_LATENCY_CLICKS_MAX];
+		u32 heard = 0;
+
+		for (u32 i = 0; i < click && origin != UINT64_MAX; ++i) {
+			const u32 begin = played[i] < origin ? 0 : (u32)((played[i] - origin) * METRONOME_LATENCY_RATE / 1000000000ull);
+			const u32 onset = FindOnset (captured, count, begin);
+
+			if (onset == UINT32_MAX) {
+				printf ("  click %2u: not heard\n", i + 1);
+				continue;
+			}
+
+			const u64 at = origin + onset * 1000000000ull / METRONOME_LATENCY_RATE;
+			latencies[heard] = ((r64)(s64)(at - played[i]) - (r64)capture) / 1e6 - unreported;
+			printf ("  click %2u: %.2f ms\n", i + 1, latencies[heard]);
+			++heard;
+		}
+
+		if (heard == 0) ERROR ("No click was heard. Turn the output up or bring the input closer.\n");
+
+		std::sort (latencies, latencies + heard);
+
+		const r64 median = heard % 2 ? latencies[heard / 2] : (latencies[heard / 2 - 1] + latencies[heard / 2]) / 2;
+		const r64 extra = median - output / 1e6;
+
+		printf (
+			"Output latency %.2f ms (median of %u, %.2f - %.2f ms), input's %.2f ms reported and %d ms given taken off.\n",
+			median, heard, latencies[0], latencies[heard - 1], capture / 1e6, unreported
+		);
+		printf ("The output reports %.2f ms itself. Pass '--latency %u' for this output.\n", output / 1e6, extra > 0 ? (u32)(extra + 0.5) : 0);
+
+		if (unreported == 0) printf (
+			"Warning: input latency the input doesn't report (%s) is counted as the output's and makes\n"
+			"  '--latency' too long by as much. Pass it as 'metronome " METRONOME_LATENCY_COMMAND " %u <input ms>' if known.\n",
+			capture ? "its converter, an interface's own buffer" : "it reports none", clicks
+		);
+
+		LOGSTOP ();
+		MEMORY::EXIT::ATEXIT (); // Capture device, source, buffers, context and device - in that order.
+		LOGMEMORY ();
+		exit (0);
+	}
+
+}
@@ -0,0 +1,196 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/trace.hpp>
+//
+#ifdef _WIN32
+	#include <blue/windows/types.hpp>
+	#include <mmsystem.h>
+#endif
+#ifdef __linux__
+	#include <algorithm>
+	#include <dirent.h>
+	#include <stdio.h>
+#endif
+//
+#include "events.hpp"
+
+
+//  ABOUT
+// MIDI clock output. The player sends a Timing Clock 24 times per beat, Start at the first
+//  beat, Stop when playback ends or is stopped and Continue when it's started again. Playback
+//  starts again from a bar start, so Continue is preceded by a Song Position Pointer to the
+//  beat that bar starts at - receivers skip the rest of the bar with it.
+//  Clocks are sent from the playback loop at deadlines taken from the same timeline as the
+//  beats, so they can't drift apart.
+//
+//  Output goes to a 'midiOut' device (winmm). Windows has no virtual ports, to reach a DAW on
+//  the same machine use a loopback port driver (e.g. loopMIDI) as the device. On linux it goes
+//  to an ALSA raw MIDI device ('/dev/snd/midiC<card>D<device>', numbered by card then device),
+//  written to directly - no 'libasound'. The 'snd-virmidi' module adds ones a DAW can read.
+//  Elsewhere asking for a device is an error.
+//
+//  Every clock is traced as scheduled and sent, 'tracedump' prints their jitter.
+//
+
+#define METRONOME_MIDI_PPQN 				24
+
+#define METRONOME_MIDI_CLOCK 				0xF8
+#define METRONOME_MIDI_START 				0xFA
+#define METRONOME_MIDI_CONTINUE 			0xFB
+#define METRONOME_MIDI_STOP 				0xFC
+#define METRONOME_MIDI_SONG_POSITION 		0xF2
+
+#define METRONOME_MIDI_DEVICES 				64 		// Raw MIDI devices looked through (linux).
+#define METRONOME_MIDI_PATH 				32
+
+
+namespace MIDI {
+
+	#ifdef _WIN32
+		HMIDIOUT output = nullptr;
+	#else
+		FILE* output = nullptr; 	// Unbuffered, every message is written as it's sent.
+	#endif
+
+	u32 clock = 0; 		// Clocks sent. Traced with each one.
+	u32 position = 0; 	// Receiver's position in clocks, from Start or a Song Position Pointer.
+
+}
+
+
+namespace MIDI {
+
+	#ifdef __linux__
+		// Raw MIDI devices by card then device. Writes the pathname of 'device' (from 1) when
+		//  there's one, returns how many there are.
+		u32 GetDevices (
+			IN		const u8& 		device,
+			OUT		c8* const& 		pathname
+		) {
+			u16 found [METRONOME_MIDI_DEVICES];
+			u32 count = 0;
+
+			if (DIR* directory = opendir ("/dev/snd")) {
+				while (const dirent* entry = readdir (directory)) {
+					u32 card, number;
+					if (count == METRONOME_MIDI_DEVICES || sscanf (entry->d_name, "midiC%uD%u", &card, &number) != 2) continue;
+					found[count++] = card << 8 | number;
+				}
+
+				closedir (directory);
+			}
+
+			std::sort (found, found + count);
+			if (device != 0 && device <= count) {
+				snprintf (pathname, METRONOME_MIDI_PATH, "/dev/snd/midiC%uD%u", found[device - 1] >> 8, found[device - 1] & 0xFF);
+			}
+
+			return count;
+		}
+	#endif
+
+	// 'device' counts from 1, 0 means no output.
+	void Open (
+		IN		const u8& 		device
+	) {
+		if (device == 0) return;
+
+		#ifdef _WIN32
+			const u32 devicesCount = midiOutGetNumDevs ();
+			if (device > devicesCount) ERROR ("MIDI device %u does not exist, there are %u.\n", device, devicesCount);
+
+			MIDIOUTCAPSA capabilities;
+			if (midiOutGetDevCapsA (device - 1, &capabilities, sizeof (capabilities)) == MMSYSERR_NOERROR) {
+				LOGINFO ("MIDI clock output: '%s'\n", capabilities.szPname);
+			}
+
+			if (midiOutOpen (&output, device - 1, 0, 0, CALLBACK_NULL) != MMSYSERR_NOERROR) {
+				ERROR ("MIDI device %u could not be opened.\n", device);
+			}
+		#elif defined (__linux__)
+			c8 pathname [METRONOME_MIDI_PATH];
+			const u32 devicesCount = GetDevices (device, pathname);
+			if (device > devicesCount) ERROR ("MIDI device %u does not exist, there are %u.\n", device, devicesCount);
+
+			output = fopen (pathname, "wb");
+			if (output == nullptr) ERROR ("MIDI device %u ('%s') could not be opened.\n", device, pathname);
+
+			setvbuf (output, nullptr, _IONBF, 0);
+			LOGINFO ("MIDI clock output: '%s'\n", pathname);
+		#else
+			ERROR ("MIDI output is only available on windows and linux.\n");
+		#endif
+	}
+
+	void Close () {
+		#ifdef _WIN32
+			if (output) midiOutClose (output);
+		#else
+			if (output) fclose (output);
+		#endif
+		output = nullptr;
+	}
+
+	void Send (
+		IN		const u8& 		status,
+		IN		const u8& 		first 	= 0,
+		IN		const u8& 		second 	= 0
+	) {
+		#ifdef _WIN32
+			midiOutShortMsg (output, status | first << 8 | second << 16);
+		#else
+			// Real-time messages are their status byte alone, a Song Position Pointer has 2 data bytes.
+			const u8 message [3] { status, first, second };
+			fwrite (message, 1, status == METRONOME_MIDI_SONG_POSITION ? 3 : 1, output);
+		#endif
+	}
+
+	// 'deadline' in nanoseconds, when the clock was due. Only traced.
+	void Clock (
+		[[maybe_unused]] IN		const u64& 		deadline
+	) {
+		if (output == nullptr) return;
+
+		TRACEEVENTAT (deadline, EVENTS::CLOCK_SCHEDULED, clock);
+		Send (METRONOME_MIDI_CLOCK);
+		TRACEEVENT (EVENTS::CLOCK_SENT, clock);
+		++clock;
+		++position;
+	}
+
+	// From the beginning. Song Position Pointer goes first for devices that keep their position.
+	void Start () {
+		if (output == nullptr) return;
+
+		Send (METRONOME_MIDI_SONG_POSITION, 0, 0);
+		Send (METRONOME_MIDI_START);
+		position = 0;
+	}
+
+	// 'beatsToBar' - beats the stopped bar had left, the next beat played is a bar start.
+	//  A Song Position Pointer counts 16ths (6 clocks) in 14 bits, past that it's Start again.
+	void Continue (
+		IN		const u32& 		beatsToBar
+	) {
+		if (output == nullptr) return;
+
+		const u32 beat = (position + METRONOME_MIDI_PPQN - 1) / METRONOME_MIDI_PPQN + beatsToBar;
+		const u32 sixteenths = beat * 4;
+
+		if (sixteenths > 0x3FFF) return Start ();
+
+		Send (METRONOME_MIDI_SONG_POSITION, sixteenths & 0x7F, sixteenths >> 7);
+		Send (METRONOME_MIDI_CONTINUE);
+		position = beat * METRONOME_MIDI_PPQN;
+	}
+
+	void Stop () {
+		if (output == nullptr) return;
+
+		Send (METRONOME_MIDI_STOP);
+	}
+
+}
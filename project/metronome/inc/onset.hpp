@@ -0,0 +1,406 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/timestamp.hpp>
+#include <blue/io_map.hpp>
+//
+#include <atomic>
+#include <cmath>
+#include <threads.h>
+//
+#if defined (__SSE2__) || defined (_M_X64) || defined (_M_AMD64)
+	#define METRONOME_ONSET_SSE2
+	#include <emmintrin.h>
+#endif
+//
+#include "audio.hpp"
+#include "latency.hpp"
+#include "sync.hpp"
+
+
+//  ABOUT
+// Grading how closely someone plays along ('--grade <input|file.wav>'). Sound comes from
+//  the default capture device or from a 16-bit '.wav' file, whose first sample is taken as
+//  the first beat's deadline and which is fed as fast as it would be recorded. Clicks belong
+//  in headphones - a microphone hearing them grades the metronome.
+//
+//  Onsets are found on the energy envelope. Every 'METRONOME_ONSET_HOP' samples the mean
+//  energy is summed (SSE2 where there is one), a hop 'METRONOME_ONSET_RATIO' times above
+//  the slowly following background (and above 'METRONOME_ONSET_FLOOR') is an onset. Its
+//  time is the first sample that loud, looked for in the hop before too - so onsets are
+//  sample accurate, not hop accurate. Nothing follows one for 'METRONOME_ONSET_REFRACTORY'.
+//
+//  Each onset goes to the nearest beat of the timeline the player publishes after every
+//  beat it plays, every tempo change and every restart after a pause. The first onset of a
+//  beat is graded and printed, the others are counted as extra. A summary is printed when
+//  playback stops.
+//
+//  The detector runs on its own thread, polling every 'METRONOME_ONSET_POLL'. Captured
+//  samples are placed on the clock the way 'LATENCY' places them.
+//
+
+#define METRONOME_ONSET_INPUT 			"input" 	// '--grade' value for the capture device.
+#define METRONOME_ONSET_RATE 			48000
+#define METRONOME_ONSET_HOP 			64 			// samples, 1.33 ms at 48 kHz
+#define METRONOME_ONSET_RATIO 			8.0 		// Onset - that many times the background energy,
+#define METRONOME_ONSET_FLOOR 			107374.0 	//  and over 1% of the full scale (squared).
+#define METRONOME_ONSET_BACKGROUND 		100 		// ms, time constant the background follows with.
+#define METRONOME_ONSET_REFRACTORY 		60 			// ms, after an onset
+#define METRONOME_ONSET_CHUNK 			4800 		// samples taken at once
+#define METRONOME_ONSET_POLL 			5 			// ms
+#define METRONOME_ONSET_FOUND 			64 			// Onsets in one chunk.
+
+
+namespace ONSET {
+
+	struct DETECTOR {
+		u64 position; 		// Samples fed so far.
+		u64 quiet; 			// Position the next onset may start at.
+		u32 refractory; 	// samples
+		u32 pendingCount;
+		r64 background; 	// Energy per sample, slowly following.
+		r64 decay; 			// Background's weight per hop.
+		alignas (16) s16 pending [METRONOME_ONSET_HOP]; 	// Hop being filled.
+		alignas (16) s16 previous [METRONOME_ONSET_HOP]; 	// Hop before, onsets may start in it.
+	};
+
+	// Written by the player, read by the detector thread.
+	struct BEATS {
+		u64 deadline; 		// Of beat 'beat'.
+		u64 spbNs; 			// 0 -> nothing played yet
+		u64 first; 			// Deadline of beat 0, a file's first sample.
+		u32 beat;
+	};
+
+	struct GRADES {
+		u32 next; 			// Beat the next onset may be graded for.
+		u32 graded;
+		u32 missed;
+		u32 extra;
+		r64 sum; 			// ms
+		r64 sumSquares;
+		r64 sumAbsolute;
+	};
+
+	ALCdevice* input = nullptr;
+	IO::MAPPING file {};
+
+	// File.
+	const c8* samples = nullptr; 	// First channel of the first frame.
+	u32 frameSize;
+	u64 framesCount;
+
+	u32 rate;
+	u64 origin; 		// Time of the first sample.
+	u64 fed; 			// Samples taken so far.
+	u64 inputLatency;
+
+	DETECTOR detector;
+	GRADES grades;
+
+	BEATS beats {};
+	std::atomic<u32> beatsSequence = 0;
+
+	alignas (16) s16 chunk [METRONOME_ONSET_CHUNK];
+
+}
+
+
+namespace ONSET {
+
+	void Create (
+		OUT		DETECTOR& 		detector,
+		IN		const u32& 		rate
+	) {
+		detector = DETECTOR {};
+		detector.refractory 	= METRONOME_ONSET_REFRACTORY * rate / 1000;
+		detector.decay 			= exp (-(r64)METRONOME_ONSET_HOP / (METRONOME_ONSET_BACKGROUND * rate / 1000.0));
+		detector.background 	= METRONOME_ONSET_FLOOR;
+	}
+
+	// Sum of squares of a hop.
+	u64 GetEnergy (
+		IN		const s16* const& 	hop
+	) {
+		#ifdef METRONOME_ONSET_SSE2
+			// Pairs of squares fit u32 (2 * 2^30), they're widened to u64 before adding up.
+			const __m128i zero = _mm_setzero_si128 ();
+			__m128i sum = zero;
+
+			for (u32 i = 0; i < METRONOME_ONSET_HOP; i += 8) {
+				const __m128i values = _mm_loadu_si128 ((const __m128i*)(hop + i));
+				const __m128i squares = _mm_madd_epi16 (values, values);
+				sum = _mm_add_epi64 (sum, _mm_unpacklo_epi32 (squares, zero));
+				sum = _mm_add_epi64 (sum, _mm_unpackhi_epi32 (squares, zero));
+			}
+
+			u64 halves [2];
+			_mm_storeu_si128 ((__m128i*)halves, sum);
+			return halves[0] + halves[1];
+		#else
+			u64 sum = 0;
+			for (u32 i = 0; i < METRONOME_ONSET_HOP; ++i) sum += (u64)((s32)hop[i] * hop[i]);
+			return sum;
+		#endif
+	}
+
+	// Returns the position of an onset starting in 'hop' (or the one before it) or UINT64_MAX.
+	u64 Detect (
+		INOUT	DETECTOR& 			detector,
+		IN		const s16* const& 	hop
+	) {
+		const r64 energy = (r64)GetEnergy (hop) / METRONOME_ONSET_HOP;
+		const r64 threshold = detector.background * METRONOME_ONSET_RATIO + METRONOME_ONSET_FLOOR;
+		const u64 position = detector.position;
+
+		u64 onset = UINT64_MAX;
+
+		if (energy > threshold && position >= detector.quiet) {
+			onset = position;
+
+			// The first sample that loud, the hop before may already have some.
+			const bool isPrevious = position >= METRONOME_ONSET_HOP && position - METRONOME_ONSET_HOP >= detector.quiet;
+
+			for (u32 i = isPrevious ? 0 : METRONOME_ONSET_HOP; i < METRONOME_ONSET_HOP * 2; ++i) {
+				const s32 sample = i < METRONOME_ONSET_HOP ? detector.previous[i] : hop[i - METRONOME_ONSET_HOP];
+				if ((r64)(sample * sample) <= threshold) continue;
+
+				onset = position + i - METRONOME_ONSET_HOP;
+				break;
+			}
+
+			detector.quiet = onset + detector.refractory;
+		}
+
+		detector.background = detector.background * detector.decay + energy * (1 - detector.decay);
+		detector.position += METRONOME_ONSET_HOP;
+		memcpy (detector.previous, hop, sizeof (detector.previous));
+
+		return onset;
+	}
+
+	// Feeds 'count' samples, writes positions of the onsets found to 'onsets' - at most
+	//  'capacity', the rest are dropped. Returns how many were written.
+	u32 Feed (
+		INOUT	DETECTOR& 			detector,
+		IN		const s16* 			samples,
+		IN		u32 				count,
+		OUT		u64* const& 		onsets,
+		IN		const u32& 			capacity
+	) {
+		u32 found = 0;
+
+		while (count) {
+			const s16* hop;
+
+			if (detector.pendingCount == 0 && count >= METRONOME_ONSET_HOP) { // Whole hops straight from 'samples'.
+				hop = samples;
+				samples += METRONOME_ONSET_HOP;
+				count -= METRONOME_ONSET_HOP;
+			} else {
+				const u32 taken = METRONOME_ONSET_HOP - detector.pendingCount < count ? METRONOME_ONSET_HOP - detector.pendingCount : count;
+				memcpy (detector.pending + detector.pendingCount, samples, taken * sizeof (s16));
+				detector.pendingCount += taken;
+				samples += taken;
+				count -= taken;
+
+				if (detector.pendingCount < METRONOME_ONSET_HOP) break;
+
+				detector.pendingCount = 0;
+				hop = detector.pending;
+			}
+
+			const u64 onset = Detect (detector, hop);
+			if (onset != UINT64_MAX && found < capacity) onsets[found++] = onset;
+		}
+
+		return found;
+	}
+
+	// Player.
+	void Publish (
+		IN		const u64& 		deadline,
+		IN		const u64& 		spbNs,
+		IN		const u32& 		beat
+	) {
+		if (input == nullptr && samples == nullptr) return;
+
+		SYNC::Write (beats, beatsSequence, [&] (BEATS& beats) {
+			if (beat == 0 || beats.spbNs == 0) beats.first = deadline - beat * spbNs;
+			beats = BEATS { deadline, spbNs, beats.first, beat };
+		});
+	}
+
+	void Grade (
+		INOUT	GRADES& 		grades,
+		IN		const BEATS& 	beats,
+		IN		const u64& 		time
+	) {
+		const s64 length = beats.spbNs;
+		const s64 since = (s64)(time - beats.deadline);
+		const s64 nearest = since >= 0 ? (since + length / 2) / length : -((-since + length / 2) / length);
+		const s64 beat = (s64)beats.beat + nearest;
+
+		if (beat < 0) return;
+		if (beat < grades.next) { ++grades.extra; return; }
+
+		const r64 deviation = (since - nearest * length) / 1e6;
+
+		grades.missed 		+= beat - grades.next;
+		grades.next 		= beat + 1;
+		grades.graded 		+= 1;
+		grades.sum 			+= deviation;
+		grades.sumSquares 	+= deviation * deviation;
+		grades.sumAbsolute 	+= fabs (deviation);
+
+		printf ("Beat %4u: %+7.2f ms%s\n", (u32)(beat + 1), deviation, deviation < 0 ? " early" : deviation > 0 ? " late" : "");
+	}
+
+}
+
+
+namespace ONSET {
+
+	bool IsOpen () {
+		return input != nullptr || samples != nullptr;
+	}
+
+	// 'source' is 'METRONOME_ONSET_INPUT' or a '.wav' file.
+	void Open (
+		IN		const c8* const& 	source
+	) {
+		if (source == nullptr) return;
+
+		if (strcmp (source, METRONOME_ONSET_INPUT) == 0) {
+			rate = METRONOME_ONSET_RATE;
+			input = alcCaptureOpenDevice (nullptr, rate, AL_FORMAT_MONO16, rate);
+			if (input == nullptr) ERROR (METRONOME_MESSAGE_AUDIO "Couldn't open a capture device to grade.\n");
+
+			inputLatency = LATENCY::GetReported (input);
+			origin = UINT64_MAX;
+			LOGINFO ("Grading '%s'\n", alcGetString (input, ALC_CAPTURE_DEVICE_SPECIFIER));
+		} else {
+			IO::Map (source, file);
+
+			// RIFF header, then chunks - 'fmt ' before 'data'.
+			const c8* const data = file.data;
+			const u64 size = file.size;
+			u16 format = 0, channels = 0, bits = 0;
+
+			if (size < 12 || memcmp (data, "RIFF", 4) || memcmp (data + 8, "WAVE", 4)) ERROR ("'%s' isn't a '.wav' file.\n", source);
+
+			for (u64 at = 12; at + 8 <= size;) {
+				u32 length;
+				memcpy (&length, data + at + 4, 4);
+
+				if (memcmp (data + at, "fmt ", 4) == 0 && length >= 16) {
+					memcpy (&format, data + at + 8, 2);
+					memcpy (&channels, data + at + 10, 2);
+					memcpy (&rate, data + at + 12, 4);
+					memcpy (&bits, data + at + 22, 2);
+				} else if (memcmp (data + at, "data", 4) == 0) {
+					if (length > size - at - 8) length = (u32)(size - at - 8); // Cut short.
+					samples = data + at + 8;
+					frameSize = channels * 2;
+					framesCount = channels ? length / frameSize : 0;
+					break;
+				}
+
+				at += 8 + length + (length & 1);
+			}
+
+			// 0xFFFE is 'WAVE_FORMAT_EXTENSIBLE', taken as PCM.
+			if ((format != 1 && format != 0xFFFE) || bits != 16 || channels == 0 || rate == 0 || samples == nullptr) {
+				ERROR ("'%s' isn't a 16-bit PCM '.wav' file.\n", source);
+			}
+
+			LOGINFO ("Grading '%s', %u Hz, %u channels\n", source, rate, channels);
+		}
+
+		Create (detector, rate);
+		grades = GRADES {};
+		fed = 0;
+
+		if (input) alcCaptureStart (input);
+	}
+
+	void Close () {
+		if (!IsOpen ()) return;
+
+		if (input) {
+			alcCaptureStop (input);
+			alcCaptureCloseDevice (input);
+			input = nullptr;
+		}
+
+		if (samples) {
+			IO::Unmap (file);
+			samples = nullptr;
+		}
+
+		if (grades.graded == 0) {
+			printf ("No beat was graded.\n");
+			return;
+		}
+
+		const r64 mean = grades.sum / grades.graded;
+		const r64 variance = grades.sumSquares / grades.graded - mean * mean;
+
+		printf (
+			"Graded %u beats, %u missed, %u extra onsets. Mean %+.2f ms, spread %.2f ms, off by %.2f ms on average.\n",
+			grades.graded, grades.missed, grades.extra, mean, sqrt (variance > 0 ? variance : 0), grades.sumAbsolute / grades.graded
+		);
+	}
+
+	// Takes what was recorded since the last poll and grades its onsets. Writes their times
+	//  to 'times' (at most 'METRONOME_ONSET_FOUND') and returns how many there were.
+	u32 Listen (
+		OUT		u64* const& 	times
+	) {
+		const timespec poll { 0, METRONOME_ONSET_POLL * 1000000l };
+		thrd_sleep (&poll, nullptr);
+
+		const BEATS current = SYNC::Read (beats, beatsSequence);
+		u32 count = 0;
+
+		if (input) {
+			ALCint available = 0;
+			alcGetIntegerv (input, ALC_CAPTURE_SAMPLES, 1, &available);
+			if (available <= 0) return 0;
+
+			count = available < METRONOME_ONSET_CHUNK ? available : METRONOME_ONSET_CHUNK;
+			alcCaptureSamples (input, chunk, count);
+
+			const u64 arrived = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ()) - (fed + count) * 1000000000ull / rate;
+			if (arrived < origin) origin = arrived;
+		} else {
+			if (current.spbNs == 0 || fed == framesCount) return 0; // Starts with the first beat.
+
+			origin = current.first;
+			const u64 now = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+			if (now < origin) return 0;
+
+			u64 due = (now - origin) * rate / 1000000000ull;
+			if (due > framesCount) due = framesCount;
+			if (due <= fed) return 0;
+
+			count = due - fed < METRONOME_ONSET_CHUNK ? (u32)(due - fed) : METRONOME_ONSET_CHUNK;
+			for (u32 i = 0; i < count; ++i) memcpy (chunk + i, samples + (fed + i) * frameSize, 2);
+
+			if (fed + count == framesCount) printf ("Recording ended.\n");
+		}
+
+		const u32 found = Feed (detector, chunk, count, times, METRONOME_ONSET_FOUND);
+		fed += count;
+
+		for (u32 i = 0; i < found; ++i) {
+			times[i] = origin + times[i] * 1000000000ull / rate - inputLatency;
+			if (current.spbNs) Grade (grades, current, times[i]); // Nothing to grade against before.
+		}
+
+		return found;
+	}
+
+}
@@ -39,19 +39,18 @@ namespace OPUS {
 	}
 
 
-	// Load an ogg opus file into the given AL buffer
-	void Load (
-		INOUT 	const ALuint& 			buffer, 
-		IN 		const c8* const& 		filename
-	) {
+	const u16 SAMPLING_RATE = 48000;
 
-		const u16 SAMPLING_RATE = 48000;
 
-		ALenum format;
-		int16_t* buf;
-		s32 channels;
+	// Decode a whole ogg opus file into 16-bit PCM at 'SAMPLING_RATE'.
+	//  'pcm' is allocated and pushed onto 'MEMORY::EXIT'. Caller pops and frees it.
+	void Decode (
+		IN 		const c8* const& 		filename,
+		OUT		s16*& 					pcm,
+		OUT		u32& 					samples, 	// per channel
+		OUT		u8& 					channels
+	) {
 		s32 pcmSize;
-
 		int totalSamplesRead = 0;
 		int samplesRead = 0;
 		s32 error = 0;
@@ -76,24 +75,20 @@ namespace OPUS {
 			filename, channels, pcmSize, pcmSize / SAMPLING_RATE
 		);
 
-		// We only support stereo and mono, set the openAL format based on channels.
+		// We only support stereo and mono.
 		// opus always uses signed 16-bit integers, unless the _float functions are called.
-		
-		switch (channels) {
-			case 1: format = AL_FORMAT_MONO16; 		break;
-			case 2: format = AL_FORMAT_STEREO16; 	break;
-			default: ERROR (METRONOME_MESSAGE_OPUS "File contained more channels than we support (%d)", channels);
-		}
+		if (channels != 1 && channels != 2) ERROR (METRONOME_MESSAGE_OPUS "File contained more channels than we support (%d)", channels);
 
 		// Allocate a buffer big enough to store the entire uncompressed file.
-		buf = new int16_t[pcmSize * channels];
+		ALLOCATE (s16, pcm, pcmSize * channels * sizeof (s16));
+		MEMORY::EXIT::PUSH (FREE, 1, pcm);
 
 		// Keep reading samples until we have them all.
 		while (totalSamplesRead < pcmSize) {
 
 			// 'op_read' returns number of samples read (per channel), and accepts 
 			//  a number of samples which fit in the buffer, not number of bytes.
-			samplesRead = op_read (file, buf + totalSamplesRead * channels, pcmSize * channels, 0);
+			samplesRead = op_read (file, pcm + totalSamplesRead * channels, pcmSize * channels, 0);
 			
 			if (samplesRead < 0) ERROR (
 				METRONOME_MESSAGE_OPUS "Couldn't decode at offset %d: Error %d (%s)", 
@@ -108,8 +103,29 @@ namespace OPUS {
 		// Close the opus file.
 		op_free (file);
 
+		samples = totalSamplesRead;
+	}
+
+
+	// Load an ogg opus file into the given AL buffer
+	void Load (
+		INOUT 	const ALuint& 			buffer, 
+		IN 		const c8* const& 		filename
+	) {
+		s16* pcm;
+		u32 samples;
+		u8 channels;
+
+		Decode (filename, pcm, samples, channels);
+
 		// Send it to OpenAL (which takes bytes).
-		alBufferData (buffer, format, buf, totalSamplesRead * channels * 2, SAMPLING_RATE);
+		const ALenum format = channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+		alBufferData (buffer, format, pcm, samples * channels * sizeof (s16), SAMPLING_RATE);
+
+		{ // OpenAL keeps its own copy.
+			MEMORY::EXIT::POP ();
+			FREE (1, pcm);
+		}
 
 		if (alGetError() == AL_NO_ERROR) { LOGINFO (METRONOME_MESSAGE_OPUS "Buffered data!\n"); }
 		else { ERROR (METRONOME_MESSAGE_OPUS "Failed to buffer data!"); }
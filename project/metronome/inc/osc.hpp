@@ -0,0 +1,254 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/comparesearch.hpp>
+//
+#include <threads.h>
+//
+#ifdef _WIN32
+	#include <winsock2.h> // Included before 'windows.h' in 'bluelib.hpp'.
+	#include <ws2tcpip.h>
+#else
+	#include <sys/socket.h>
+	#include <sys/select.h>
+	#include <netinet/in.h>
+	#include <arpa/inet.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+//
+#include "global.hpp"
+
+
+//  ABOUT
+// OSC control over UDP on localhost. Messages become 'GLOBAL' commands - the same ones the
+//  keyboard pushes - and are applied by the playback thread:
+//
+//  /metronome/bpm <i|f>, /metronome/pattern <i|f>, /metronome/volume <i|f>,
+//  /metronome/start, /metronome/stop. Bundles are unpacked, their time tags are ignored.
+//
+//  The socket is non-blocking, 'Receive' waits for it with 'select' (so the thread notices
+//  a stop) and then reads up to 'METRONOME_OSC_BATCH' queued datagrams into the one static
+//  'packet'. When more are queued it's a flood and the thread sleeps 'METRONOME_OSC_PAUSE'
+//  before the next batch, so it can't take the core from the playback thread - what doesn't
+//  fit the socket's buffer meanwhile is dropped by the system. Only the last value of every
+//  address is kept ('received') and pushed as a command once the playback thread took the
+//  previous ones - a flood costs it at most one command per address per loop, never a
+//  dropped one. Nothing is allocated per packet. Malformed and unknown messages are skipped
+//  silently - whoever floods the port shouldn't flood the log too.
+//
+
+#define METRONOME_OSC_PACKET 	1024 	// Longer datagrams are cut.
+#define METRONOME_OSC_POLL 		250 	// ms, longest wait in 'Receive'.
+#define METRONOME_OSC_DEPTH 	4 		// Nested bundles allowed.
+#define METRONOME_OSC_BATCH 	64 		// Datagrams read at once.
+#define METRONOME_OSC_PAUSE 	1 		// ms, between batches of a flood.
+
+
+namespace OSC {
+
+	#ifndef _WIN32
+		using SOCKET = s32;
+		constexpr SOCKET INVALID_SOCKET = -1;
+	#endif
+
+	enum ADDRESS: u8 {
+		ADDRESS_BPM 		= 0,
+		ADDRESS_PATTERN 	= 1,
+		ADDRESS_VOLUME 		= 2,
+		ADDRESS_START 		= 3,
+		ADDRESS_STOP 		= 4,
+		ADDRESS_COUNT 		= 5,
+	};
+
+	constexpr const c8* ADDRESSES [ADDRESS_COUNT] {
+		"/metronome/bpm",
+		"/metronome/pattern",
+		"/metronome/volume",
+		"/metronome/start",
+		"/metronome/stop",
+	};
+
+	constexpr c8 CODES [ADDRESS_COUNT] {
+		METRONOME_COMMAND_BPM,
+		METRONOME_COMMAND_PATTERN,
+		METRONOME_COMMAND_VOLUME,
+		METRONOME_COMMAND_START,
+		METRONOME_COMMAND_STOP,
+	};
+
+	constexpr auto ADDRESSES_TABLE = COMPARESEARCH::MakePerfect (ADDRESSES);
+
+	struct RECEIVED {
+		u16 values [ADDRESS_COUNT];
+		bool isReceived [ADDRESS_COUNT];
+		u8 transport; 	// ADDRESS_START, ADDRESS_STOP or ADDRESS_COUNT
+	};
+
+	SOCKET listener = INVALID_SOCKET;
+	RECEIVED received { {}, {}, ADDRESS_COUNT };
+
+	// 16 more bytes - 'COMPARESEARCH' compares 16 bytes at once.
+	c8 packet [METRONOME_OSC_PACKET + 16];
+
+}
+
+
+namespace OSC {
+
+	u32 ReadBig (
+		IN		const c8* const& 	data
+	) {
+		const u8* bytes = (const u8*)data;
+		return (u32)bytes[0] << 24 | (u32)bytes[1] << 16 | (u32)bytes[2] << 8 | bytes[3];
+	}
+
+	// Returns the offset after the zero padding or UINT32_MAX when the string isn't terminated.
+	u32 SkipString (
+		IN		const c8* const& 	data,
+		IN		const u32& 			size,
+		IN		u32 				at
+	) {
+		for (; at < size && data[at] != '\0'; ++at);
+		if (at == size) return UINT32_MAX;
+		return (at + 4) & ~3u;
+	}
+
+	void Dispatch (
+		INOUT	RECEIVED& 			received,
+		IN		const c8* const& 	data,
+		IN		const u32& 			size,
+		IN		const u8& 			depth
+	) {
+		if (size >= 16 && memcmp (data, "#bundle", 8) == 0) { // #bundle, time tag, (size, element)...
+			if (depth == METRONOME_OSC_DEPTH) return;
+
+			for (u32 at = 16; at + 4 <= size;) {
+				const u32 length = ReadBig (data + at);
+				if (length > size - at - 4) return;
+
+				Dispatch (received, data + at + 4, length, depth + 1);
+				at += 4 + length;
+			}
+
+			return;
+		}
+
+		const u32 tags = SkipString (data, size, 0);
+		if (tags == UINT32_MAX) return;
+
+		const u32 index = ADDRESSES_TABLE.Find (data);
+		if (index == ADDRESS_COUNT) return;
+
+		u16 value = 0;
+
+		if (tags < size && data[tags] == ',' && data[tags + 1] != '\0') { // The first argument only.
+			const u32 arguments = SkipString (data, size, tags);
+			if (arguments == UINT32_MAX || arguments + 4 > size) return;
+
+			const u32 raw = ReadBig (data + arguments);
+
+			if (data[tags + 1] == 'i') {
+				const s32 number = (s32)raw;
+				value = number < 0 ? 0 : number > UINT16_MAX ? UINT16_MAX : number;
+			} else if (data[tags + 1] == 'f') {
+				r32 number;
+				memcpy (&number, &raw, sizeof (number));
+				value = !(number >= 0) ? 0 : number >= UINT16_MAX ? UINT16_MAX : (u16)(number + 0.5f);
+			} else {
+				return;
+			}
+		}
+
+		received.values[index] = value;
+		received.isReceived[index] = true;
+		if (index == ADDRESS_START || index == ADDRESS_STOP) received.transport = index;
+	}
+
+	// Binds 'port' on 127.0.0.1.
+	void Open (
+		IN		const u16& 			port
+	) {
+		#ifdef _WIN32
+			WSADATA wsa;
+			if (WSAStartup (MAKEWORD (2, 2), &wsa) != 0) ERROR ("Winsock could not be started.\n");
+		#endif
+
+		listener = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		if (listener == INVALID_SOCKET) ERROR ("OSC socket could not be created.\n");
+
+		sockaddr_in address {};
+		address.sin_family 		= AF_INET;
+		address.sin_port 		= htons (port);
+		address.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+
+		if (bind (listener, (const sockaddr*)&address, sizeof (address)) != 0) {
+			ERROR ("OSC port %u could not be bound.\n", port);
+		}
+
+		#ifdef _WIN32
+			u_long isNonBlocking = 1;
+			ioctlsocket (listener, FIONBIO, &isNonBlocking);
+		#else
+			fcntl (listener, F_SETFL, fcntl (listener, F_GETFL) | O_NONBLOCK);
+		#endif
+
+		LOGINFO ("OSC listening on 127.0.0.1:%u\n", port);
+	}
+
+	void Close () {
+		if (listener == INVALID_SOCKET) return;
+
+		#ifdef _WIN32
+			closesocket (listener);
+			WSACleanup ();
+		#else
+			close (listener);
+		#endif
+
+		listener = INVALID_SOCKET;
+	}
+
+	// Waits up to 'METRONOME_OSC_POLL' for datagrams, dispatches a batch of them and pushes
+	//  what was received when the playback thread is ready for it.
+	void Receive () {
+		fd_set readable;
+		FD_ZERO (&readable);
+		FD_SET (listener, &readable);
+
+		bool isFlooded = false;
+
+		timeval timeout { 0, METRONOME_OSC_POLL * 1000 };
+		if (select (listener + 1, &readable, nullptr, nullptr, &timeout) > 0) {
+			u32 count = 0;
+
+			for (; count < METRONOME_OSC_BATCH; ++count) {
+				const s32 size = recvfrom (listener, packet, METRONOME_OSC_PACKET, 0, nullptr, nullptr);
+				if (size < 0) break; // Drained.
+
+				memset (packet + size, 0, 16);
+				if (size % 4 == 0) Dispatch (received, packet, size, 0);
+			}
+
+			isFlooded = count == METRONOME_OSC_BATCH;
+		}
+
+		if (isFlooded) {
+			const timespec pause { 0, METRONOME_OSC_PAUSE * 1000000l };
+			thrd_sleep (&pause, nullptr);
+		}
+
+		if (GLOBAL::command.load (std::memory_order_relaxed) != nullptr) return; // Not taken yet.
+
+		for (u8 i = ADDRESS_BPM; i < ADDRESS_START; ++i) {
+			if (received.isReceived[i]) GLOBAL::PushCommand (CODES[i], received.values[i]);
+		}
+
+		if (received.transport != ADDRESS_COUNT) GLOBAL::PushCommand (CODES[received.transport]);
+
+		received = RECEIVED { {}, {}, ADDRESS_COUNT };
+	}
+
+}
@@ -0,0 +1,441 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/timestamp.hpp>
+//
+#include <atomic>
+//
+#ifdef _WIN32
+	#include <winsock2.h> // Included before 'windows.h' in 'bluelib.hpp'.
+	#include <ws2tcpip.h>
+#else
+	#include <sys/socket.h>
+	#include <sys/select.h>
+	#include <netinet/in.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+//
+#include "sync.hpp"
+
+
+//  ABOUT
+// Tempo and beat phase shared between equals ('--peers <port>'). There's no leader - any
+//  peer may change the tempo and every other one plays the change from then on.
+//
+//  Everything goes to one multicast group on the local network, so peers find each other
+//  without being told where to look, and many of them may share a port on one machine. Every
+//  'METRONOME_PEERS_INTERVAL' each peer announces the session it plays and asks everyone for
+//  their time. The answers are fitted per peer the way 'SYNC' fits a leader's, so each peer
+//  knows every other peer's clock.
+//
+//  The session is a timeline with a version - a counter and its author. The anchor is in the
+//  author's clock. A change raises the counter over the highest one seen, the higher version
+//  wins everywhere and equal counters go to the higher author - so after concurrent changes
+//  all peers still end up on the same one. A newcomer listens 'METRONOME_PEERS_DISCOVER'
+//  before it founds a session of its own. When an author goes silent the lowest remaining
+//  peer moves the timeline into its clock under a new version.
+//
+//  The session is written by the peers thread and by the player's own changes, read by the
+//  player - through a sequence counter that also keeps the two writers apart.
+//
+
+#define METRONOME_PEERS_MAGIC 		0x5250544D 	// "MTPR"
+#define METRONOME_PEERS_GROUP 		0xEFFF4D4D 	// 239.255.77.77, administratively scoped.
+#define METRONOME_PEERS_MAX 		16
+#define METRONOME_PEERS_INTERVAL 	100 		// ms, between announcements
+#define METRONOME_PEERS_POLL 		10 			// ms, longest wait - own changes leave within it.
+#define METRONOME_PEERS_TIMEOUT 	1000 		// ms, silence before a peer is gone.
+#define METRONOME_PEERS_DISCOVER 	300 		// ms, listening before founding a session.
+
+
+namespace PEERS {
+
+	#ifndef _WIN32
+		using SOCKET = s32;
+		constexpr SOCKET INVALID_SOCKET = -1;
+	#endif
+
+	enum TYPE: u8 {
+		TYPE_STATE 	= 0, 	// Session, to everyone.
+		TYPE_PING 	= 1, 	// Time request, to everyone.
+		TYPE_PONG 	= 2, 	// Time reply, to the one who asked.
+	};
+
+	struct MESSAGE {
+		u32 magic;
+		TYPE type;
+		u8 bar;
+		u8 pattern;
+		u8 reserved;
+		u32 from;
+		u32 to; 		// 0 -> everyone
+		u32 author;
+		u32 padding;
+		u64 counter;
+		u64 anchor; 	// Author's clock.
+		u64 spbNs;
+		u64 originate; 	// t1, asker's clock
+		u64 receive; 	// t2, answerer's clock
+		u64 transmit; 	// t3, answerer's clock
+	};
+
+	static_assert (sizeof (MESSAGE) == 72, "Peer messages have no padding.");
+
+	struct SESSION {
+		u64 counter; 				// 0 -> none yet
+		u32 author;
+		SYNC::ESTIMATE estimate; 	// Author's clock and the timeline in it.
+	};
+
+	struct PEER {
+		u32 id;
+		u64 seen;
+		SYNC::ESTIMATE estimate;
+		SYNC::SAMPLE samples [METRONOME_SYNC_SAMPLES];
+	};
+
+	SOCKET connection = INVALID_SOCKET;
+	sockaddr_in group {};
+	u32 self = 0;
+
+	u64 founding; 		// Own timeline's beat length - till another session is heard.
+	u8 foundingPattern;
+	u64 opened;
+	u64 announced;
+
+	// Peers thread only.
+	PEER peers [METRONOME_PEERS_MAX];
+	u8 peersCount = 0;
+
+	// Written by the peers thread and the player, read by the player.
+	SESSION session {};
+	std::atomic<u32> sessionSequence = 0;
+	std::atomic<bool> isChanged = false; 	// Player's change waits to be announced.
+
+}
+
+
+namespace PEERS {
+
+	bool IsOpen () {
+		return connection != INVALID_SOCKET;
+	}
+
+	// As 'SYNC::Write', but waits for the other writer.
+	template <class Function>
+	void Write (
+		IN		Function 		function
+	) {
+		u32 sequence = sessionSequence.load (std::memory_order_relaxed) & ~1u;
+		while (!sessionSequence.compare_exchange_weak (sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed)) sequence &= ~1u;
+
+		std::atomic_thread_fence (std::memory_order_release);
+		function (session);
+		sessionSequence.store (sequence + 2, std::memory_order_release);
+	}
+
+	SESSION Read () {
+		return SYNC::Read (session, sessionSequence);
+	}
+
+	bool IsNewer (
+		IN		const u64& 		counter,
+		IN		const u32& 		author,
+		IN		const SESSION& 	than
+	) {
+		return counter > than.counter || (counter == than.counter && author > than.author);
+	}
+
+	// Own clock - no offset, no drift, trusted right away.
+	SYNC::ESTIMATE GetOwnClock (
+		IN		const SYNC::TIMELINE& 	timeline
+	) {
+		return SYNC::ESTIMATE { 0, 0, 0, METRONOME_SYNC_SYNCED, timeline };
+	}
+
+	// Player. A new tempo from 'anchor' on, announced to every peer.
+	void Change (
+		IN		const u64& 		anchor,
+		IN		const u64& 		spbNs,
+		IN		const u8& 		bar,
+		IN		const u8& 		pattern
+	) {
+		if (!IsOpen ()) return;
+
+		Write ([&] (SESSION& session) {
+			session = SESSION { session.counter + 1, self, GetOwnClock (SYNC::TIMELINE { anchor, spbNs, bar, pattern }) };
+		});
+
+		isChanged.store (true, std::memory_order_release);
+	}
+
+}
+
+
+namespace PEERS {
+
+	void Close () {
+		if (connection == INVALID_SOCKET) return;
+
+		#ifdef _WIN32
+			closesocket (connection);
+			WSACleanup ();
+		#else
+			close (connection);
+		#endif
+
+		connection = INVALID_SOCKET;
+	}
+
+	// Joins the group on 'port'. Until another session is heard the own one plays 'spbNs'
+	//  long beats in bars of 'pattern' + 1.
+	void Open (
+		IN		const u16& 		port,
+		IN		const u64& 		spbNs,
+		IN		const u8& 		pattern
+	) {
+		SYNC::Start ();
+
+		connection = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		if (connection == INVALID_SOCKET) ERROR ("Peers socket could not be created.\n");
+
+		{ // Every peer on this machine binds the same port.
+			const s32 isReused = 1;
+			setsockopt (connection, SOL_SOCKET, SO_REUSEADDR, (const c8*)&isReused, sizeof (isReused));
+		}
+
+		sockaddr_in address {};
+		address.sin_family 		= AF_INET;
+		address.sin_port 		= htons (port);
+		address.sin_addr.s_addr = htonl (INADDR_ANY);
+
+		if (bind (connection, (const sockaddr*)&address, sizeof (address)) != 0) {
+			ERROR ("Peers port %u could not be bound.\n", port);
+		}
+
+		{ // Own messages come back too - other peers on this machine need them.
+			ip_mreq membership {};
+			membership.imr_multiaddr.s_addr = htonl (METRONOME_PEERS_GROUP);
+			membership.imr_interface.s_addr = htonl (INADDR_ANY);
+
+			if (setsockopt (connection, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const c8*)&membership, sizeof (membership)) != 0) {
+				ERROR ("Peers group could not be joined.\n");
+			}
+
+			const s32 isLooped = 1, hops = 1;
+			setsockopt (connection, IPPROTO_IP, IP_MULTICAST_LOOP, (const c8*)&isLooped, sizeof (isLooped));
+			setsockopt (connection, IPPROTO_IP, IP_MULTICAST_TTL, (const c8*)&hops, sizeof (hops));
+		}
+
+		#ifdef _WIN32
+			u_long isNonBlocking = 1;
+			ioctlsocket (connection, FIONBIO, &isNonBlocking);
+		#else
+			fcntl (connection, F_SETFL, fcntl (connection, F_GETFL) | O_NONBLOCK);
+		#endif
+
+		group.sin_family 		= AF_INET;
+		group.sin_port 			= htons (port);
+		group.sin_addr.s_addr 	= htonl (METRONOME_PEERS_GROUP);
+
+		const u64 now = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+
+		// Random enough - two peers starting in the same nanosecond is the only collision.
+		self = (u32)((now * 0x9E3779B97F4A7C15ull) >> 32) | 1;
+
+		founding 		= spbNs;
+		foundingPattern = pattern;
+		opened 			= now;
+		announced 		= now;
+
+		LOGINFO ("Peer %08x on port %u\n", self, port);
+	}
+
+	bool Wait (
+		IN		const u32& 		milliseconds
+	) {
+		fd_set readable;
+		FD_ZERO (&readable);
+		FD_SET (connection, &readable);
+
+		timeval timeout { 0, (s32)milliseconds * 1000 };
+		return select (connection + 1, &readable, nullptr, nullptr, &timeout) > 0;
+	}
+
+	void Send (
+		IN		MESSAGE& 		message
+	) {
+		message.magic 	= METRONOME_PEERS_MAGIC;
+		message.from 	= self;
+		sendto (connection, (const c8*)&message, sizeof (message), 0, (const sockaddr*)&group, sizeof (group));
+	}
+
+	// nullptr when unknown and there's no room for it.
+	PEER* Find (
+		IN		const u32& 		id,
+		IN		const u64& 		now
+	) {
+		for (u8 i = 0; i < peersCount; ++i) if (peers[i].id == id) return &peers[i];
+		if (peersCount == METRONOME_PEERS_MAX) return nullptr;
+
+		PEER& peer = peers[peersCount++];
+		peer.id 		= id;
+		peer.seen 		= now;
+		peer.estimate 	= SYNC::ESTIMATE {};
+		return &peer;
+	}
+
+	void Announce () {
+		const SESSION current = Read ();
+		if (current.counter == 0) return;
+
+		const SYNC::TIMELINE& timeline = current.estimate.timeline;
+
+		MESSAGE message {};
+		message.type 	= TYPE_STATE;
+		message.bar 	= timeline.bar;
+		message.pattern = timeline.pattern;
+		message.author 	= current.author;
+		message.counter = current.counter;
+		message.anchor 	= timeline.anchor;
+		message.spbNs 	= timeline.spbNs;
+
+		Send (message);
+	}
+
+	// Forgets silent peers, founds a session or takes over one whose author is gone.
+	void Tend (
+		IN		const u64& 		now
+	) {
+		for (u8 i = 0; i < peersCount;) {
+			if (now - peers[i].seen > METRONOME_PEERS_TIMEOUT * 1000000ull) peers[i] = peers[--peersCount];
+			else ++i;
+		}
+
+		const SESSION current = Read ();
+
+		if (current.counter == 0) {
+			if (now - opened < METRONOME_PEERS_DISCOVER * 1000000ull) return;
+
+			Write ([&] (SESSION& session) {
+				if (session.counter) return; // Heard one meanwhile.
+				session = SESSION { 1, self, GetOwnClock (SYNC::TIMELINE { now, founding, 0, foundingPattern }) };
+			});
+
+			LOGINFO ("Founded a session.\n");
+			return;
+		}
+
+		if (current.author == self) return;
+
+		u32 lowest = self;
+		for (u8 i = 0; i < peersCount; ++i) {
+			if (peers[i].id == current.author) return; // Still there.
+			if (peers[i].id < lowest) lowest = peers[i].id;
+		}
+
+		if (lowest != self) return; // Whoever is lowest takes over.
+
+		SYNC::TIMELINE timeline = current.estimate.timeline; // The author's last clock estimate still holds.
+		timeline.anchor = SYNC::ToFollower (current.estimate, timeline.anchor);
+		timeline.spbNs 	= (u64)(timeline.spbNs / (1 + current.estimate.drift));
+
+		Write ([&] (SESSION& session) {
+			if (session.counter != current.counter || session.author != current.author) return; // Changed meanwhile.
+			session = SESSION { current.counter + 1, self, GetOwnClock (timeline) };
+		});
+
+		LOGINFO ("Took over the session of a gone peer %08x.\n", current.author);
+	}
+
+	void Receive (
+		IN		const MESSAGE& 	message,
+		IN		const u64& 		arrival
+	) {
+		if (message.magic != METRONOME_PEERS_MAGIC || message.from == self) return;
+		if (message.to != 0 && message.to != self) return;
+
+		PEER* const peer = Find (message.from, arrival);
+		if (peer == nullptr) return;
+
+		peer->seen = arrival;
+
+		switch (message.type) {
+
+			case TYPE_STATE: {
+				if (message.author == self || !IsNewer (message.counter, message.author, Read ())) return;
+
+				const PEER* const author = Find (message.author, arrival);
+				if (author == nullptr) return;
+
+				SYNC::ESTIMATE estimate = author->estimate; // Not synced yet when only relayed so far.
+				estimate.timeline = SYNC::TIMELINE { message.anchor, message.spbNs, message.bar, message.pattern };
+
+				Write ([&] (SESSION& session) {
+					if (IsNewer (message.counter, message.author, session)) session = SESSION { message.counter, message.author, estimate };
+				});
+			} return;
+
+			case TYPE_PING: {
+				MESSAGE reply {};
+				reply.type 		= TYPE_PONG;
+				reply.to 		= message.from;
+				reply.originate = message.originate;
+				reply.receive 	= arrival;
+				reply.transmit 	= TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+
+				Send (reply);
+			} return;
+
+			case TYPE_PONG: {
+				if (message.originate > arrival || message.transmit < message.receive) return;
+
+				SYNC::Feed (peer->estimate, peer->samples, message.originate, message.receive, message.transmit, arrival);
+
+				Write ([&] (SESSION& session) { // Author's clock is the session's clock.
+					if (session.author != message.from) return;
+
+					const SYNC::TIMELINE timeline = session.estimate.timeline;
+					session.estimate = peer->estimate;
+					session.estimate.timeline = timeline;
+				});
+			} return;
+
+			default: return;
+		}
+	}
+
+	// One poll - announces a change, every 'METRONOME_PEERS_INTERVAL' the session and a time
+	//  request, then takes whatever came within 'METRONOME_PEERS_POLL'.
+	void Exchange () {
+		const u64 now = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+
+		if (isChanged.exchange (false, std::memory_order_acquire)) Announce ();
+
+		if (now - announced >= METRONOME_PEERS_INTERVAL * 1000000ull) {
+			announced = now;
+			Tend (now);
+			Announce ();
+
+			MESSAGE request {};
+			request.type 		= TYPE_PING;
+			request.originate 	= TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+			Send (request);
+		}
+
+		if (!Wait (METRONOME_PEERS_POLL)) return;
+
+		for (;;) {
+			MESSAGE message;
+			const s32 size = recvfrom (connection, (c8*)&message, sizeof (message), 0, nullptr, nullptr);
+			if (size < 0) break; // Drained.
+
+			const u64 arrival = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+			if (size == sizeof (message)) Receive (message, arrival);
+		}
+	}
+
+}
@@ -0,0 +1,96 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/io_watch.hpp>
+//
+#include "arguments.hpp"
+#include "schedule.hpp"
+#include "session.hpp"
+#include "bank.hpp"
+#include "synth.hpp"
+
+
+//  ABOUT
+// Reloading a '--json' session while it plays. The session file and the sound files it
+//  names are watched, on a change the session is parsed into the spare 'BANK' slot, its
+//  sounds are loaded and the slot is handed to the player, which switches at the next bar.
+//
+//  Slot 0 plays 'SCHEDULE::plan', slot 1 plays 'spare'. A session that doesn't parse or
+//  names a missing sound is reported and ignored - the current one keeps playing.
+//
+//  While playing this is the only thread that allocates ('ALLOCATE' is thread-safe) and the
+//  only one that pushes to 'MEMORY::EXIT' (which isn't) - the player and listeners do neither.
+//
+
+#define METRONOME_RELOAD_POLL 		250 	// ms, longest wait without a change notification
+#define METRONOME_RELOAD_SETTLE 	100 	// ms, editors often write a file in a few steps
+
+
+namespace RELOAD {
+
+	SCHEDULE::PLAN spare;
+	IO::WATCH::WATCH watch;
+
+}
+
+
+namespace RELOAD {
+
+	SCHEDULE::PLAN& GetPlan (
+		IN		const BANK::SLOT* const& 		slot
+	) {
+		return slot == &BANK::slots[0] ? SCHEDULE::plan : spare;
+	}
+
+	// Session file first, then every sound that isn't synthesized.
+	void Watch (
+		IN		const c8* const& 				session,
+		IN		const SCHEDULE::PLAN& 			plan
+	) {
+		IO::WATCH::Destroy (watch);
+		IO::WATCH::Add (watch, session);
+
+		for (u8 i = 0; i < plan.soundsCount; ++i) {
+			SYNTH::CLICK click;
+			if (SYNTH::Find (plan.sounds[i], click)) continue;
+
+			if (!IO::WATCH::Add (watch, plan.sounds[i])) {
+				LOGWARN ("Sound '%s' can't be watched.\n", plan.sounds[i]);
+			}
+		}
+	}
+
+	// Returns false when the session can't be played.
+	bool Prepare (
+		INOUT	BANK::SLOT& 					slot,
+		IN		const c8* const& 				session,
+		IN		const ARGUMENTS::MAINARGS& 		args
+	) {
+		SCHEDULE::PLAN& plan = GetPlan (&slot);
+
+		if (!SESSION::Reload (session, args, plan)) return false;
+
+		for (u8 i = 0; i < plan.soundsCount; ++i) {
+			SYNTH::CLICK click;
+			if (SYNTH::Find (plan.sounds[i], click)) continue;
+
+			#ifndef METRONOME_MINIMAL
+				if (IO::WATCH::GetModified (plan.sounds[i]) == 0) {
+					LOGWARN ("Session '%s' was not reloaded. Sound '%s' is missing.\n", session, plan.sounds[i]);
+					return false;
+				}
+			#else
+				LOGWARN ("Session '%s' was not reloaded. Unknown sound '%s'.\n", session, plan.sounds[i]);
+				return false;
+			#endif
+		}
+
+		BANK::Destroy (slot.sounds);
+		BANK::Create (slot.sounds, plan, COMPILED::LOADED {});
+		slot.plan = &plan;
+
+		return true;
+	}
+
+}
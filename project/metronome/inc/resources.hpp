@@ -14,3 +14,9 @@
 #define METRONOME_TRACK_07_	"res\\base\\07_.opus"
 #define METRONOME_TRACK_08_	"res\\base\\08_.opus"
 #define METRONOME_TRACK_09_	"res\\base\\09_.opus"
+
+#define METRONOME_SYNTH_SINE	"synth-sine"
+#define METRONOME_SYNTH_SQUARE	"synth-square"
+#define METRONOME_SYNTH_NOISE	"synth-noise"
+
+#define METRONOME_TRACE_FILENAME "metronome.trace"
@@ -0,0 +1,77 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+//
+#include "arguments.hpp"
+
+
+//  ABOUT
+// What the player plays - a list of tempo sections. Sections are stored as flat arrays
+//  (one per field) so that loaders write them directly and the player reads them by index.
+//  Storage is static, a plan is never allocated.
+//
+//  A section plays 'bars' bars of 'pattern' beats. 'bars == 0' plays until stopped.
+//  'sound' indexes 'sounds' - a synthesized click name or an '.opus' filename.
+//
+
+#define METRONOME_SCHEDULE_SECTIONS 		16384
+#define METRONOME_SCHEDULE_SOUNDS 			8
+#define METRONOME_SCHEDULE_SOUND_LENGTH 	260 // MAX_PATH
+
+
+namespace SCHEDULE {
+
+	struct PLAN {
+		u32 sectionsCount;
+		u8 soundsCount;
+		c8 sounds [METRONOME_SCHEDULE_SOUNDS][METRONOME_SCHEDULE_SOUND_LENGTH];
+
+		METRONOME_ARGUMENT_TYPE_BPM 		bpm 	[METRONOME_SCHEDULE_SECTIONS];
+		u16 								bars 	[METRONOME_SCHEDULE_SECTIONS];
+		METRONOME_ARGUMENT_TYPE_PATTERN 	pattern [METRONOME_SCHEDULE_SECTIONS];
+		u8 									volume 	[METRONOME_SCHEDULE_SECTIONS];
+		u8 									sound 	[METRONOME_SCHEDULE_SECTIONS];
+	};
+
+	PLAN plan;
+
+}
+
+
+namespace SCHEDULE {
+
+	// Returns false when 'sound' doesn't fit.
+	bool SetSound (
+		INOUT	PLAN& 				plan,
+		IN		const u8& 			index,
+		IN		const c8* const& 	sound,
+		IN		const u32& 			length
+	) {
+		if (length >= METRONOME_SCHEDULE_SOUND_LENGTH) return false;
+
+		memcpy (plan.sounds[index], sound, length);
+		plan.sounds[index][length] = '\0';
+		return true;
+	}
+
+	// A single section played until stopped.
+	void FromArguments (
+		OUT		PLAN& 							plan,
+		IN		const ARGUMENTS::MAINARGS& 		args
+	) {
+		if (!SetSound (plan, 0, args.filename, strlen (args.filename))) {
+			ERROR ("Sound filename is too long - '%s'\n", args.filename);
+		}
+
+		plan.soundsCount 	= 1;
+		plan.sectionsCount 	= 1;
+		plan.bpm[0] 		= args.bpm;
+		plan.bars[0] 		= 0;
+		plan.pattern[0] 	= args.pattern;
+		plan.volume[0] 		= args.volume;
+		plan.sound[0] 		= 0;
+	}
+
+}
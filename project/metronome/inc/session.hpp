@@ -0,0 +1,613 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/io_map.hpp>
+#include <blue/swar.hpp>
+#include <blue/timestamp.hpp>
+//
+#include <csetjmp>
+//
+#include "arguments.hpp"
+#include "schedule.hpp"
+
+
+//  ABOUT
+// Loads a session ('--json') into 'SCHEDULE::PLAN'. The file is memory-mapped and parsed in
+//  a single pass straight into the plan's arrays - there is no DOM, nothing is allocated and
+//  strings are copied only when they're kept (sounds). Unknown keys are skipped, so sessions
+//  may carry names, notes etc.
+//
+//  {
+//  	"sounds": [ "synth-sine", "res\\base\\02_.opus" ],
+//  	"sections": [
+//  		{ "bpm": 90, "pattern": 4, "bars": 8, "volume": 60, "sound": 0 },
+//  		{ "bpm": 120, "bars": 16, "sound": 1 },
+//  		{ "bpm": 140 }
+//  	]
+//  }
+//
+//  Missing section fields are taken from the previous section. The first section takes them
+//  from the command-line ('bars' -> 0, play until stopped). Without "sounds" the only sound
+//  is the '--filename' one. Numbers share their ranges with the command-line options.
+//
+//  Errors are reported with the line and column (in bytes) they were found at. 'Load' errors
+//  out, 'Reload' (used while playing) only warns and leaves - it jumps out of the parser with
+//  'longjmp', which is fine as nothing in it has a destructor.
+//
+
+#define METRONOME_SESSION_DEPTH 	64 	// Nesting allowed in skipped values.
+#define METRONOME_SESSION_KEY 		16 	// Longer keys are unknown keys.
+
+
+namespace SESSION {
+
+	struct PARSER {
+		const c8* begin;
+		const c8* current;
+		const c8* end;
+		const c8* filename;
+		jmp_buf* recover; 	// nullptr -> 'ERROR'
+	};
+
+	// The line and column are only counted when something is wrong.
+	template <class... Arguments>
+	void Fail (
+		IN		const PARSER& 		parser,
+		IN		const c8* const& 	at,
+		IN		const c8* const& 	format,
+		IN		Arguments... 		arguments
+	) {
+		const c8* lineBegin = parser.begin;
+		u32 line = 1;
+
+		for (const c8* character = parser.begin; character < at; ++character) {
+			if (*character == '\n') { ++line; lineBegin = character + 1; }
+		}
+
+		c8 message [128];
+		snprintf (message, sizeof (message), format, arguments...);
+
+		const u32 column = (u32)(at - lineBegin) + 1;
+
+		if (parser.recover) {
+			LOGWARN ("Session '%s' (line %u, column %u): %s\n", parser.filename, line, column, message);
+			longjmp (*parser.recover, 1);
+		}
+
+		ERROR ("Session '%s' (line %u, column %u): %s\n", parser.filename, line, column, message);
+	}
+
+	// Hot loops work on a local copy of 'current' - stores through 'c8*' alias it otherwise.
+	void SkipSpace (
+		INOUT	PARSER& 			parser
+	) {
+		const c8* current = parser.current;
+
+		for (; current < parser.end; ++current) {
+			const c8 character = *current;
+			if (character != ' ' && character != '\n' && character != '\r' && character != '\t') break;
+		}
+
+		parser.current = current;
+	}
+
+	// The next meaningful character or '\0' at the end.
+	c8 Peek (
+		INOUT	PARSER& 			parser
+	) {
+		SkipSpace (parser);
+		return parser.current < parser.end ? *parser.current : '\0';
+	}
+
+	void Expect (
+		INOUT	PARSER& 			parser,
+		IN		const c8& 			character
+	) {
+		if (Peek (parser) != character) {
+			if (parser.current == parser.end) Fail (parser, parser.current, "expected '%c', the file ended", character);
+			Fail (parser, parser.current, "expected '%c', got '%c'", character, *parser.current);
+		}
+
+		++parser.current;
+	}
+
+}
+
+
+namespace SESSION {
+
+	u32 ReadHex (
+		INOUT	PARSER& 			parser
+	) {
+		u32 value = 0;
+
+		for (u8 i = 0; i < 4; ++i, ++parser.current) {
+			const c8 character = parser.current < parser.end ? *parser.current : '\0';
+			value <<= 4;
+
+			if (character >= '0' && character <= '9') 		value |= character - '0';
+			else if (character >= 'a' && character <= 'f') 	value |= character - 'a' + 10;
+			else if (character >= 'A' && character <= 'F') 	value |= character - 'A' + 10;
+			else Fail (parser, parser.current, "expected a hex digit");
+		}
+
+		return value;
+	}
+
+	// Decodes a '\' escape into 'decoded' as UTF-8. Returns the number of bytes.
+	u8 ReadEscape (
+		INOUT	PARSER& 			parser,
+		OUT		c8* const& 			decoded
+	) {
+		const c8* const at = parser.current++; // '\'
+		const c8 character = parser.current < parser.end ? *parser.current++ : '\0';
+
+		switch (character) {
+			case '"': 	decoded[0] = '"'; 	return 1;
+			case '\\': 	decoded[0] = '\\'; 	return 1;
+			case '/': 	decoded[0] = '/'; 	return 1;
+			case 'b': 	decoded[0] = '\b'; 	return 1;
+			case 'f': 	decoded[0] = '\f'; 	return 1;
+			case 'n': 	decoded[0] = '\n'; 	return 1;
+			case 'r': 	decoded[0] = '\r'; 	return 1;
+			case 't': 	decoded[0] = '\t'; 	return 1;
+			case 'u': 	break;
+			default: 	Fail (parser, at, "invalid escape sequence");
+		}
+
+		u32 code = ReadHex (parser);
+
+		if (code >= 0xD800 && code <= 0xDBFF) { // Surrogate pair.
+			if (parser.end - parser.current < 2 || parser.current[0] != '\\' || parser.current[1] != 'u') {
+				Fail (parser, at, "unpaired surrogate");
+			}
+
+			parser.current += 2;
+			const u32 low = ReadHex (parser);
+			if (low < 0xDC00 || low > 0xDFFF) Fail (parser, at, "unpaired surrogate");
+
+			code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+		} else if (code >= 0xDC00 && code <= 0xDFFF) {
+			Fail (parser, at, "unpaired surrogate");
+		}
+
+		if (code < 0x80) {
+			decoded[0] = (c8)code;
+			return 1;
+		} else if (code < 0x800) {
+			decoded[0] = (c8)(0xC0 | code >> 6);
+			decoded[1] = (c8)(0x80 | (code & 0x3F));
+			return 2;
+		} else if (code < 0x10000) {
+			decoded[0] = (c8)(0xE0 | code >> 12);
+			decoded[1] = (c8)(0x80 | (code >> 6 & 0x3F));
+			decoded[2] = (c8)(0x80 | (code & 0x3F));
+			return 3;
+		} else {
+			decoded[0] = (c8)(0xF0 | code >> 18);
+			decoded[1] = (c8)(0x80 | (code >> 12 & 0x3F));
+			decoded[2] = (c8)(0x80 | (code >> 6 & 0x3F));
+			decoded[3] = (c8)(0x80 | (code & 0x3F));
+			return 4;
+		}
+	}
+
+	// Reads a string into 'buffer' (nullptr only skips it) and '\0'-terminates it.
+	//  Returns its length or UINT32_MAX when it didn't fit into 'capacity'.
+	u32 ReadString (
+		INOUT	PARSER& 			parser,
+		OUT		c8* const& 			buffer,
+		IN		const u32& 			capacity
+	) {
+		Expect (parser, '"');
+
+		u32 length = 0;
+		bool isFitting = true;
+
+		auto Append = [&] (const c8* const& data, const u32& count) {
+			if (buffer == nullptr) return;
+			if (length + count < capacity) { memcpy (buffer + length, data, count); length += count; }
+			else isFitting = false;
+		};
+
+		for (;;) {
+			const c8* const run = parser.current;
+			const c8* current = run;
+
+			// Plain characters are copied in runs.
+			for (; current < parser.end; ++current) {
+				const c8 character = *current;
+				if (character == '"' || character == '\\' || (u8)character < 0x20) break;
+			}
+
+			parser.current = current;
+			Append (run, current - run);
+
+			if (parser.current == parser.end) Fail (parser, parser.current, "unterminated string");
+
+			const c8 character = *parser.current;
+
+			if (character == '"') {
+				++parser.current;
+				break;
+			} else if (character == '\\') {
+				c8 decoded [4];
+				const u8 count = ReadEscape (parser, decoded);
+				Append (decoded, count);
+			} else {
+				Fail (parser, parser.current, "control character in a string");
+			}
+		}
+
+		if (buffer != nullptr) buffer[length] = '\0';
+		return isFitting ? length : UINT32_MAX;
+	}
+
+	// Only non-negative integers are accepted. Up to 8 digits are read at once when 8 bytes are
+	//  left, whatever remains one at a time.
+	u32 ReadWhole (
+		INOUT	PARSER& 			parser,
+		IN		const u32& 			min,
+		IN		const u32& 			max,
+		IN		const c8* const& 	name
+	) {
+		Peek (parser);
+
+		const c8* const start = parser.current;
+		const c8* current = start;
+		u64 number = 0;
+
+		if (parser.end - current >= 8) {
+			const u64 bytes = SWAR::Load (current);
+			const u32 count = SWAR::CountDigits (bytes);
+
+			if (count) number = SWAR::GetDigits (bytes, count);
+			current += count;
+		}
+
+		for (; current < parser.end && *current >= '0' && *current <= '9'; ++current) {
+			if (number <= UINT32_MAX) number = number * 10 + (*current - '0');
+		}
+
+		parser.current = current;
+
+		const c8 next = parser.current < parser.end ? *parser.current : '\0';
+
+		if (parser.current == start || next == '.' || next == 'e' || next == 'E') {
+			Fail (parser, start, "'%s' expects a whole number", name);
+		}
+
+		if (number < min || number > max) Fail (parser, start, "'%s' has to be within %u-%u", name, min, max);
+
+		return (u32)number;
+	}
+
+	void SkipNumber (
+		INOUT	PARSER& 			parser
+	) {
+		const c8* const start = parser.current;
+		auto IsDigit = [&] () { return parser.current < parser.end && *parser.current >= '0' && *parser.current <= '9'; };
+		auto IsNext = [&] (const c8& character) { return parser.current < parser.end && *parser.current == character; };
+
+		if (IsNext ('-')) ++parser.current;
+		if (!IsDigit ()) Fail (parser, start, "invalid number");
+		for (; IsDigit (); ++parser.current);
+
+		if (IsNext ('.')) {
+			++parser.current;
+			if (!IsDigit ()) Fail (parser, start, "invalid number");
+			for (; IsDigit (); ++parser.current);
+		}
+
+		if (IsNext ('e') || IsNext ('E')) {
+			++parser.current;
+			if (IsNext ('+') || IsNext ('-')) ++parser.current;
+			if (!IsDigit ()) Fail (parser, start, "invalid number");
+			for (; IsDigit (); ++parser.current);
+		}
+	}
+
+	void SkipLiteral (
+		INOUT	PARSER& 			parser,
+		IN		const c8* const& 	literal
+	) {
+		const c8* const start = parser.current;
+
+		for (const c8* character = literal; *character; ++character, ++parser.current) {
+			if (parser.current == parser.end || *parser.current != *character) Fail (parser, start, "unexpected value");
+		}
+	}
+
+}
+
+
+namespace SESSION {
+
+	void SkipValue (INOUT PARSER& parser, IN const u32& depth);
+
+	// Keys without escapes are left in the file and 'key' points at them (not '\0'-terminated),
+	//  others are decoded into 'buffer'. Returns the length as 'ReadString' does.
+	u32 ReadKey (
+		INOUT	PARSER& 			parser,
+		OUT		const c8*& 			key,
+		OUT		c8 (&buffer) [METRONOME_SESSION_KEY]
+	) {
+		const c8* const quote = (Peek (parser), parser.current);
+		const c8* current = quote + 1;
+
+		if (quote < parser.end && *quote == '"') {
+			if (parser.end - current >= 8) { // Short keys at once.
+				const u64 bytes = SWAR::Load (current);
+				const u32 length = SWAR::Find (bytes, '"');
+
+				if (length < 8 && SWAR::Find (bytes, '\\') > length && SWAR::FindControl (bytes) > length) {
+					parser.current = current + length + 1;
+					key = current;
+					return length;
+				}
+			}
+
+			for (; current < parser.end; ++current) {
+				const c8 character = *current;
+				if (character == '"' || character == '\\' || (u8)character < 0x20) break;
+			}
+
+			if (current < parser.end && *current == '"') {
+				const u32 length = (u32)(current - quote - 1);
+				parser.current = current + 1;
+				key = quote + 1;
+				return length < METRONOME_SESSION_KEY ? length : UINT32_MAX;
+			}
+		}
+
+		key = buffer;
+		return ReadString (parser, buffer, METRONOME_SESSION_KEY);
+	}
+
+	// 'name' is a literal, 'key' and 'length' come from 'ReadKey'.
+	template <u32 size>
+	bool IsKey (
+		IN		const c8 (&name) [size],
+		IN		const c8* const& 	key,
+		IN		const u32& 			length
+	) {
+		return length == size - 1 && memcmp (name, key, size - 1) == 0;
+	}
+
+	// Calls 'onKey (key, length)' for every key of an object. 'onKey' has to read the value.
+	//  Keys longer than 'METRONOME_SESSION_KEY' are passed with 'length == UINT32_MAX'.
+	template <class Function>
+	void ForEachKey (
+		INOUT	PARSER& 			parser,
+		IN		Function 			onKey
+	) {
+		Expect (parser, '{');
+		if (Peek (parser) == '}') { ++parser.current; return; }
+
+		for (;;) {
+			c8 buffer [METRONOME_SESSION_KEY];
+			const c8* key;
+			const u32 length = ReadKey (parser, key, buffer);
+
+			Expect (parser, ':');
+			onKey (key, length);
+
+			if (Peek (parser) == ',') { ++parser.current; continue; }
+			Expect (parser, '}');
+			return;
+		}
+	}
+
+	// Calls 'onItem (index)' for every item of an array. 'onItem' has to read the item.
+	template <class Function>
+	void ForEachItem (
+		INOUT	PARSER& 			parser,
+		IN		Function 			onItem
+	) {
+		Expect (parser, '[');
+		if (Peek (parser) == ']') { ++parser.current; return; }
+
+		for (u32 index = 0;; ++index) {
+			onItem (index);
+
+			if (Peek (parser) == ',') { ++parser.current; continue; }
+			Expect (parser, ']');
+			return;
+		}
+	}
+
+	void SkipValue (
+		INOUT	PARSER& 			parser,
+		IN		const u32& 			depth
+	) {
+		if (depth > METRONOME_SESSION_DEPTH) Fail (parser, parser.current, "nested too deep");
+
+		const c8 character = Peek (parser);
+
+		switch (character) {
+			case '"': 	ReadString (parser, nullptr, 0); 														return;
+			case '{': 	ForEachKey (parser, [&] (const c8*, const u32&) { SkipValue (parser, depth + 1); }); 	return;
+			case '[': 	ForEachItem (parser, [&] (const u32&) { SkipValue (parser, depth + 1); }); 			return;
+			case 't': 	SkipLiteral (parser, "true"); 															return;
+			case 'f': 	SkipLiteral (parser, "false"); 															return;
+			case 'n': 	SkipLiteral (parser, "null"); 															return;
+			case '\0': 	Fail (parser, parser.current, "expected a value, the file ended"); 						return;
+		}
+
+		if (character == '-' || (character >= '0' && character <= '9')) return SkipNumber (parser);
+
+		Fail (parser, parser.current, "unexpected '%c'", character);
+	}
+
+}
+
+
+namespace SESSION {
+
+	void ReadSounds (
+		INOUT	PARSER& 			parser,
+		INOUT	SCHEDULE::PLAN& 	plan
+	) {
+		u32 count = 0;
+
+		ForEachItem (parser, [&] (const u32& index) {
+			const c8* const at = (Peek (parser), parser.current);
+			if (index == METRONOME_SCHEDULE_SOUNDS) Fail (parser, at, "too many sounds (%u max)", METRONOME_SCHEDULE_SOUNDS);
+
+			const u32 length = ReadString (parser, plan.sounds[index], METRONOME_SCHEDULE_SOUND_LENGTH);
+			if (length == UINT32_MAX) Fail (parser, at, "sound name is too long (%u max)", METRONOME_SCHEDULE_SOUND_LENGTH - 1);
+			if (length == 0) Fail (parser, at, "sound name is empty");
+
+			count = index + 1;
+		});
+
+		if (count == 0) Fail (parser, parser.current - 1, "'sounds' is empty");
+		plan.soundsCount = count;
+	}
+
+	// Returns the highest sound index used and where it was.
+	void ReadSections (
+		INOUT	PARSER& 				parser,
+		INOUT	SCHEDULE::PLAN& 		plan,
+		OUT		u32& 					soundMax,
+		OUT		const c8*& 				soundMaxAt
+	) {
+		using ARGUMENTS::MAINARGS;
+
+		constexpr const auto& BPM 		= ARGUMENTS::OPTION::Find<&MAINARGS::bpm> ();
+		constexpr const auto& PATTERN 	= ARGUMENTS::OPTION::Find<&MAINARGS::pattern> ();
+		constexpr const auto& VOLUME 	= ARGUMENTS::OPTION::Find<&MAINARGS::volume> ();
+
+		u32 count = 0;
+		soundMax = 0;
+		soundMaxAt = nullptr;
+
+		ForEachItem (parser, [&] (const u32& index) {
+			if (index == METRONOME_SCHEDULE_SECTIONS) {
+				Fail (parser, (Peek (parser), parser.current), "too many sections (%u max)", METRONOME_SCHEDULE_SECTIONS);
+			}
+
+			if (index != 0) { // Inherited. The first section keeps 'FromArguments' values.
+				plan.bpm[index] 	= plan.bpm[index - 1];
+				plan.bars[index] 	= plan.bars[index - 1];
+				plan.pattern[index] = plan.pattern[index - 1];
+				plan.volume[index] 	= plan.volume[index - 1];
+				plan.sound[index] 	= plan.sound[index - 1];
+			}
+
+			ForEachKey (parser, [&] (const c8* key, const u32& length) {
+				if (IsKey ("bpm", key, length)) {
+					plan.bpm[index] = ReadWhole (parser, BPM.min, BPM.max, BPM.name);
+				} else if (IsKey ("bars", key, length)) {
+					plan.bars[index] = ReadWhole (parser, 0, UINT16_MAX, "bars");
+				} else if (IsKey ("pattern", key, length)) {
+					plan.pattern[index] = ReadWhole (parser, PATTERN.min, PATTERN.max, PATTERN.name);
+				} else if (IsKey ("volume", key, length)) {
+					plan.volume[index] = ReadWhole (parser, VOLUME.min, VOLUME.max, VOLUME.name);
+				} else if (IsKey ("sound", key, length)) {
+					const c8* const at = (Peek (parser), parser.current);
+					plan.sound[index] = ReadWhole (parser, 0, METRONOME_SCHEDULE_SOUNDS - 1, "sound");
+					if (plan.sound[index] >= soundMax) { soundMax = plan.sound[index]; soundMaxAt = at; }
+				} else {
+					SkipValue (parser, 1);
+				}
+			});
+
+			count = index + 1;
+		});
+
+		if (count == 0) Fail (parser, parser.current - 1, "'sections' is empty");
+		plan.sectionsCount = count;
+	}
+
+	void Parse (
+		INOUT	PARSER& 			parser,
+		INOUT	SCHEDULE::PLAN& 	plan
+	) {
+		const c8* soundMaxAt = nullptr;
+		u32 soundMax = 0;
+		bool isSections = false;
+
+		if (parser.end - parser.current >= 3 && memcmp (parser.current, "\xEF\xBB\xBF", 3) == 0) {
+			parser.current += 3; // UTF-8 BOM
+		}
+
+		ForEachKey (parser, [&] (const c8* key, const u32& length) {
+			if (IsKey ("sounds", key, length)) {
+				ReadSounds (parser, plan);
+			} else if (IsKey ("sections", key, length)) {
+				if (isSections) Fail (parser, parser.current, "'sections' given twice");
+				ReadSections (parser, plan, soundMax, soundMaxAt);
+				isSections = true;
+			} else {
+				SkipValue (parser, 1);
+			}
+		});
+
+		if (Peek (parser) != '\0') Fail (parser, parser.current, "unexpected data after the session");
+		if (!isSections) Fail (parser, parser.current, "'sections' is missing");
+
+		if (soundMax >= plan.soundsCount) {
+			Fail (parser, soundMaxAt, "sound %u is not listed, %u sounds given", soundMax, plan.soundsCount);
+		}
+	}
+
+	void Load (
+		IN		const c8* const& 				filename,
+		IN		const ARGUMENTS::MAINARGS& 		args,
+		OUT		SCHEDULE::PLAN& 				plan
+	) {
+		const TIMESTAMP::Timestamp timestampBegin = TIMESTAMP::GetCurrent ();
+
+		SCHEDULE::FromArguments (plan, args);
+
+		IO::MAPPING mapping;
+		IO::Map (filename, mapping);
+
+		{ // Future ERROR.
+			MEMORY::EXIT::PUSH (IO::Unmap, 1, &mapping);
+		}
+
+		PARSER parser { mapping.data, mapping.data, mapping.data + mapping.size, filename, nullptr };
+		Parse (parser, plan);
+
+		MEMORY::EXIT::POP ();
+		IO::Unmap (mapping);
+
+		LOGINFO (
+			"Session '%s' loaded in %fs: %u sections, %u sounds.\n",
+			filename, TIMESTAMP::GetElapsed (timestampBegin), plan.sectionsCount, (u32)plan.soundsCount
+		);
+	}
+
+
+	// Returns false, keeping whatever was parsed, when the file is missing or invalid.
+	bool Reload (
+		IN		const c8* const& 				filename,
+		IN		const ARGUMENTS::MAINARGS& 		args,
+		OUT		SCHEDULE::PLAN& 				plan
+	) {
+		SCHEDULE::FromArguments (plan, args);
+
+		IO::MAPPING mapping;
+		if (!IO::TryMap (filename, mapping)) {
+			LOGWARN ("Session '%s' could not be opened.\n", filename);
+			return false;
+		}
+
+		jmp_buf recover;
+		PARSER parser { mapping.data, mapping.data, mapping.data + mapping.size, filename, &recover };
+
+		if (setjmp (recover)) {
+			IO::Unmap (mapping);
+			return false;
+		}
+
+		Parse (parser, plan);
+		IO::Unmap (mapping);
+		return true;
+	}
+
+}
@@ -0,0 +1,412 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/timestamp.hpp>
+//
+#include <atomic>
+//
+#ifdef _WIN32
+	#include <winsock2.h> // Included before 'windows.h' in 'bluelib.hpp'.
+	#include <ws2tcpip.h>
+#else
+	#include <sys/socket.h>
+	#include <sys/select.h>
+	#include <netinet/in.h>
+	#include <netdb.h>
+	#include <unistd.h>
+#endif
+
+
+//  ABOUT
+// Playing in step with another metronome over UDP. The leader ('--lead <port>') answers
+//  requests with its timeline - the deadline of the last beat it played, its length and the
+//  beat's place in the bar. A follower ('--join <host:port>') asks every
+//  'METRONOME_SYNC_INTERVAL' and plays the leader's beats at its own clock's equivalent.
+//
+//  Clocks are compared the way NTP and PTP do it. The follower sends its time (t1), the
+//  leader notes when the request came (t2) and when the reply leaves (t3), the follower when
+//  it came back (t4). Then the offset is ((t2 - t1) + (t3 - t4)) / 2 and the round trip
+//  (t4 - t1) - (t3 - t2). The offset is exact when both ways take as long - so only
+//  exchanges with a round trip close to the shortest seen ('METRONOME_SYNC_SPREAD') are kept,
+//  the others waited in a queue one way. A line fitted through the kept offsets of the last
+//  'METRONOME_SYNC_SAMPLES' exchanges gives the offset now and the drift between the clocks.
+//
+//  The estimate is written by the sync thread and read by the player - through a sequence
+//  counter, as in 'FOLLOW'. Packets are sent in host byte order, both ends are expected to
+//  be little-endian (x86, ARM).
+//
+
+#define METRONOME_SYNC_MAGIC 		0x5953544D 	// "MTSY"
+#define METRONOME_SYNC_INTERVAL 	100 		// ms, between requests
+#define METRONOME_SYNC_SAMPLES 		64 			// Exchanges the estimate is fitted to, 6.4 s.
+#define METRONOME_SYNC_SPREAD 		100000 		// ns, round trip allowed over the shortest one.
+#define METRONOME_SYNC_DRIFT 		0.0005 		// Largest drift believed, 500 ppm.
+#define METRONOME_SYNC_SYNCED 		4 			// Exchanges before beats are played.
+#define METRONOME_SYNC_POLL 		250 		// ms, longest wait for the leader's requests.
+
+
+namespace SYNC {
+
+	#ifndef _WIN32
+		using SOCKET = s32;
+		constexpr SOCKET INVALID_SOCKET = -1;
+	#endif
+
+	enum TYPE: u8 {
+		TYPE_REQUEST 	= 0,
+		TYPE_REPLY 		= 1,
+	};
+
+	struct TIMELINE {
+		u64 anchor; 	// Leader's time of the last beat, nanoseconds.
+		u64 spbNs; 		// 0 -> leader isn't playing
+		u8 bar; 		// Anchor beat's place in the bar, the accent is at 'pattern'.
+		u8 pattern;
+	};
+
+	struct PACKET {
+		u32 magic;
+		TYPE type;
+		u8 bar;
+		u8 pattern;
+		u8 reserved;
+		u64 originate; 	// t1, follower's clock
+		u64 receive; 	// t2, leader's clock
+		u64 transmit; 	// t3, leader's clock
+		u64 anchor;
+		u64 spbNs;
+	};
+
+	static_assert (sizeof (PACKET) == 48, "Sync packets have no padding.");
+
+	struct SAMPLE {
+		u64 time; 		// Follower's clock, midway between t1 and t4.
+		r64 offset; 	// leader - follower, nanoseconds
+		u64 delay; 		// Round trip without the leader's own time.
+	};
+
+	struct ESTIMATE {
+		u64 reference; 	// Follower's clock 'offset' is for.
+		r64 offset;
+		r64 drift; 		// Leader's nanoseconds per follower's nanosecond - 1.
+		u32 samples; 	// Exchanges so far.
+		TIMELINE timeline;
+	};
+
+	SOCKET connection = INVALID_SOCKET;
+	bool isLeading = false;
+
+	// Leader. Written by the player, read by the sync thread.
+	TIMELINE timeline {};
+	std::atomic<u32> timelineSequence = 0;
+
+	// Follower. Written by the sync thread, read by the player.
+	SAMPLE samples [METRONOME_SYNC_SAMPLES];
+	ESTIMATE estimate {};
+	std::atomic<u32> estimateSequence = 0;
+
+}
+
+
+namespace SYNC {
+
+	template <class T, class Function>
+	void Write (
+		INOUT	T& 						shared,
+		INOUT	std::atomic<u32>& 		sequence,
+		IN		Function 				function
+	) {
+		sequence.fetch_add (1, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_release);
+		function (shared);
+		sequence.fetch_add (1, std::memory_order_release);
+	}
+
+	template <class T>
+	T Read (
+		IN		const T& 				shared,
+		IN		const std::atomic<u32>& sequence
+	) {
+		T copy;
+		u32 before;
+
+		do {
+			before = sequence.load (std::memory_order_acquire);
+			copy = shared;
+			std::atomic_thread_fence (std::memory_order_acquire);
+		} while ((before & 1) || before != sequence.load (std::memory_order_relaxed));
+
+		return copy;
+	}
+
+	bool IsFollowing () {
+		return connection != INVALID_SOCKET && !isLeading;
+	}
+
+	// Player. 'spbNs' 0 when stopped.
+	void Publish (
+		IN		const u64& 		anchor,
+		IN		const u64& 		spbNs,
+		IN		const u8& 		bar,
+		IN		const u8& 		pattern
+	) {
+		if (!isLeading) return;
+		Write (timeline, timelineSequence, [&] (TIMELINE& timeline) { timeline = TIMELINE { anchor, spbNs, bar, pattern }; });
+	}
+
+	// Fits 'offset' and 'drift' to the samples with a round trip close to the shortest one.
+	void Fit (
+		INOUT	ESTIMATE& 				estimate,
+		IN		const SAMPLE* const& 	samples,
+		IN		const u32& 				samplesCount
+	) {
+		u64 shortest = UINT64_MAX;
+		for (u32 i = 0; i < samplesCount; ++i) if (samples[i].delay < shortest) shortest = samples[i].delay;
+
+		// Relative to the newest sample - keeps the sums small enough for doubles.
+		const u64 reference = estimate.reference;
+		r64 count = 0, sumTime = 0, sumOffset = 0, sumTimeTime = 0, sumTimeOffset = 0;
+
+		for (u32 i = 0; i < samplesCount; ++i) {
+			const SAMPLE& sample = samples[i];
+			if (sample.delay > shortest + METRONOME_SYNC_SPREAD) continue;
+
+			const r64 time = (r64)(s64)(sample.time - reference);
+			count 			+= 1;
+			sumTime 		+= time;
+			sumOffset 		+= sample.offset;
+			sumTimeTime 	+= time * time;
+			sumTimeOffset 	+= time * sample.offset;
+		}
+
+		const r64 spread = count * sumTimeTime - sumTime * sumTime;
+		r64 drift = 0;
+
+		if (count > 2 && spread > 0) {
+			drift = (count * sumTimeOffset - sumTime * sumOffset) / spread;
+			if (drift > METRONOME_SYNC_DRIFT) drift = METRONOME_SYNC_DRIFT;
+			if (drift < -METRONOME_SYNC_DRIFT) drift = -METRONOME_SYNC_DRIFT;
+		}
+
+		estimate.offset = (sumOffset - drift * sumTime) / count;
+		estimate.drift = drift;
+	}
+
+	// Adds the exchange to 'samples' (the estimate's own 'METRONOME_SYNC_SAMPLES') and fits
+	//  the estimate again.
+	void Feed (
+		INOUT	ESTIMATE& 				estimate,
+		INOUT	SAMPLE* const& 			samples,
+		IN		const u64& 				t1, 	// originate
+		IN		const u64& 				t2, 	// receive
+		IN		const u64& 				t3, 	// transmit
+		IN		const u64& 				t4 		// arrival
+	) {
+		SAMPLE& sample = samples[estimate.samples % METRONOME_SYNC_SAMPLES];
+		sample.time 	= t1 + (t4 - t1) / 2;
+		sample.offset 	= ((r64)(s64)(t2 - t1) + (r64)(s64)(t3 - t4)) / 2;
+		sample.delay 	= (t4 - t1) - (t3 - t2);
+
+		++estimate.samples;
+		estimate.reference = sample.time;
+
+		const u32 samplesCount = estimate.samples < METRONOME_SYNC_SAMPLES ? estimate.samples : METRONOME_SYNC_SAMPLES;
+		Fit (estimate, samples, samplesCount);
+	}
+
+	// Leader's clock at follower's 'time' and back. Only differences go through doubles,
+	//  whole timestamps don't fit their 53 bits.
+	u64 ToLeader (
+		IN		const ESTIMATE& 		estimate,
+		IN		const u64& 				time
+	) {
+		const r64 elapsed = (r64)(s64)(time - estimate.reference);
+		return time + (s64)(estimate.offset + estimate.drift * elapsed);
+	}
+
+	u64 ToFollower (
+		IN		const ESTIMATE& 		estimate,
+		IN		const u64& 				time
+	) {
+		const r64 elapsed = (r64)(s64)(time - (s64)estimate.offset - estimate.reference);
+		return estimate.reference + (s64)(elapsed / (1 + estimate.drift));
+	}
+
+	// Deadline of the leader's first beat due after 'after', the beat's length and its place
+	//  in the bar. False until synced or while the leader isn't playing.
+	bool GetBeat (
+		IN		const ESTIMATE& 		estimate,
+		IN		const u64& 				after,
+		OUT		u64& 					deadline,
+		OUT		u64& 					spbNs,
+		OUT		u8& 					pattern,
+		OUT		u8& 					bar
+	) {
+		const TIMELINE& timeline = estimate.timeline;
+		if (estimate.samples < METRONOME_SYNC_SYNCED || timeline.spbNs == 0) return false;
+
+		const s64 length = timeline.spbNs;
+		const s64 since = (s64)(ToLeader (estimate, after) - timeline.anchor);
+		const s64 beats = since > 0 ? (since + length - 1) / length : -(-since / length);
+		const s64 barLength = timeline.pattern + 1;
+
+		deadline 	= ToFollower (estimate, timeline.anchor + beats * length);
+		spbNs 		= (u64)(length / (1 + estimate.drift));
+		pattern 	= timeline.pattern;
+		bar 		= (u8)(((timeline.bar + beats) % barLength + barLength) % barLength);
+		return true;
+	}
+
+}
+
+
+namespace SYNC {
+
+	void Close () {
+		if (connection == INVALID_SOCKET) return;
+
+		#ifdef _WIN32
+			closesocket (connection);
+			WSACleanup ();
+		#else
+			close (connection);
+		#endif
+
+		connection = INVALID_SOCKET;
+	}
+
+	void Start () {
+		#ifdef _WIN32
+			WSADATA wsa;
+			if (WSAStartup (MAKEWORD (2, 2), &wsa) != 0) ERROR ("Winsock could not be started.\n");
+		#endif
+	}
+
+	// Answers followers on 'port', every interface.
+	void Lead (
+		IN		const u16& 		port
+	) {
+		Start ();
+
+		connection = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		if (connection == INVALID_SOCKET) ERROR ("Sync socket could not be created.\n");
+
+		sockaddr_in address {};
+		address.sin_family 		= AF_INET;
+		address.sin_port 		= htons (port);
+		address.sin_addr.s_addr = htonl (INADDR_ANY);
+
+		if (bind (connection, (const sockaddr*)&address, sizeof (address)) != 0) {
+			ERROR ("Sync port %u could not be bound.\n", port);
+		}
+
+		isLeading = true;
+		LOGINFO ("Leading on port %u\n", port);
+	}
+
+	// 'leader' is 'host:port'.
+	void Join (
+		IN		const c8* const& 	leader
+	) {
+		const c8* const colon = strrchr (leader, ':');
+		c8 host [256];
+
+		if (colon == nullptr || colon == leader || colon - leader >= (s64)sizeof (host) || colon[1] == '\0') {
+			ERROR ("Invalid argument passed, '--join' expects 'host:port', got '%s'\n", leader);
+		}
+
+		memcpy (host, leader, colon - leader);
+		host[colon - leader] = '\0';
+
+		Start ();
+
+		addrinfo hints {};
+		hints.ai_family 	= AF_INET;
+		hints.ai_socktype 	= SOCK_DGRAM;
+
+		addrinfo* found;
+		if (getaddrinfo (host, colon + 1, &hints, &found) != 0) ERROR ("Leader '%s' could not be resolved.\n", leader);
+
+		connection = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		if (connection == INVALID_SOCKET) ERROR ("Sync socket could not be created.\n");
+
+		// Connected - replies from anyone else are dropped by the system.
+		const bool isConnected = connect (connection, found->ai_addr, (s32)found->ai_addrlen) == 0;
+		freeaddrinfo (found);
+
+		if (!isConnected) ERROR ("Leader '%s' could not be reached.\n", leader);
+
+		LOGINFO ("Following the leader at '%s'\n", leader);
+	}
+
+	bool Wait (
+		IN		const u32& 		milliseconds
+	) {
+		fd_set readable;
+		FD_ZERO (&readable);
+		FD_SET (connection, &readable);
+
+		timeval timeout { 0, (s32)milliseconds * 1000 };
+		return select (connection + 1, &readable, nullptr, nullptr, &timeout) > 0;
+	}
+
+	// Leader. Answers requests that came within 'METRONOME_SYNC_POLL'.
+	void Serve () {
+		if (!Wait (METRONOME_SYNC_POLL)) return;
+
+		PACKET packet;
+		sockaddr_storage follower;
+		socklen_t followerSize = sizeof (follower);
+
+		const s32 size = recvfrom (connection, (c8*)&packet, sizeof (packet), 0, (sockaddr*)&follower, &followerSize);
+		const u64 received = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+
+		if (size != sizeof (packet) || packet.magic != METRONOME_SYNC_MAGIC || packet.type != TYPE_REQUEST) return;
+
+		const TIMELINE current = Read (timeline, timelineSequence);
+
+		packet.type 	= TYPE_REPLY;
+		packet.bar 		= current.bar;
+		packet.pattern 	= current.pattern;
+		packet.receive 	= received;
+		packet.anchor 	= current.anchor;
+		packet.spbNs 	= current.spbNs;
+		packet.transmit = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+
+		sendto (connection, (const c8*)&packet, sizeof (packet), 0, (const sockaddr*)&follower, followerSize);
+	}
+
+	// Follower. One exchange, then waits out the rest of 'METRONOME_SYNC_INTERVAL'.
+	void Exchange () {
+		const u64 sent = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+
+		PACKET packet {};
+		packet.magic 		= METRONOME_SYNC_MAGIC;
+		packet.type 		= TYPE_REQUEST;
+		packet.originate 	= sent;
+
+		send (connection, (const c8*)&packet, sizeof (packet), 0);
+
+		for (u64 now = sent; now - sent < METRONOME_SYNC_INTERVAL * 1000000ull;) {
+			const u32 left = METRONOME_SYNC_INTERVAL - (u32)((now - sent) / 1000000);
+			const bool isReadable = Wait (left);
+
+			now = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+			if (!isReadable) continue;
+
+			if (recv (connection, (c8*)&packet, sizeof (packet), 0) != sizeof (packet)) continue;
+
+			// Late replies to earlier requests count too, their 't1' is their own.
+			if (packet.magic != METRONOME_SYNC_MAGIC || packet.type != TYPE_REPLY) continue;
+			if (packet.originate > now || packet.transmit < packet.receive) continue;
+
+			Write (estimate, estimateSequence, [&] (ESTIMATE& estimate) {
+				Feed (estimate, samples, packet.originate, packet.receive, packet.transmit, now);
+				estimate.timeline = TIMELINE { packet.anchor, packet.spbNs, packet.bar, packet.pattern };
+			});
+		}
+	}
+
+}
@@ -0,0 +1,135 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/wave.hpp>
+#include <blue/comparesearch.hpp>
+//
+#include <cstring>
+#include <cmath>
+//
+#include "resources.hpp"
+#include "audio.hpp"
+
+#define METRONOME_MESSAGE_SYNTH "[SYNTH] "
+
+
+//  ABOUT
+// Built-in click generator. Instead of decoding a whole '.opus' file for a ~30ms click
+//  we're rendering it from a small 'w8' wavetable shaped by an attack/decay envelope.
+//  Both variants (regular, accent) are rendered on the stack and handed to OpenAL which
+//  copies them. No file I/O, no allocations.
+//
+
+namespace SYNTH {
+
+	const u16 SAMPLING_RATE 	= 48000;
+	const u16 CLICK_LENGTH 		= SAMPLING_RATE * 30 / 1000; // 30ms
+	const u16 ATTACK_LENGTH 	= SAMPLING_RATE * 1 / 1000;	 // 1ms
+	const u8  TABLE_SIZE 		= 64;
+
+	enum CLICK: u8 {
+		CLICK_SINE 	= 0,
+		CLICK_SQUARE 	= 1,
+		CLICK_NOISE 	= 2,
+		CLICK_COUNT 	= 3,
+	};
+
+	constexpr const c8* NAMES [CLICK_COUNT] {
+		METRONOME_SYNTH_SINE,
+		METRONOME_SYNTH_SQUARE,
+		METRONOME_SYNTH_NOISE,
+	};
+
+	constexpr auto NAMES_TABLE = COMPARESEARCH::MakePerfect (NAMES);
+
+	//  ABOUT
+	// One period of sin (x) encoded as 'w8' -> 6bit magnitude, phase (mirror) and sign bit.
+	//  1.0f is encoded as phase set with zero wave (0x40), -1.0f as (0xC0).
+	//
+	constexpr auto SINE = LUT::Generate<u8, TABLE_SIZE> ([] (u32 i) {
+		const r32 value = SINE64LUT[i * 64 / TABLE_SIZE];
+		const u8 magnitude = (u8)((value < 0 ? -value : value) * 64.0f + 0.5f);
+		const u8 code = magnitude >= 64 ? 0x40 : magnitude;
+		return (u8)(code | ((value < 0 && code) << 7));
+	});
+
+	struct VOICE {
+		u16 frequency; 	// Hz
+		r32 decay; 		// seconds (time constant)
+	};
+
+	//  ABOUT
+	// [click][0] -> regular, [click][1] -> accent.
+	//
+	const VOICE VOICES [CLICK_COUNT][2] {
+		{ { 1000, 0.006f }, { 1500, 0.008f } }, // SINE
+		{ {  800, 0.004f }, { 1200, 0.006f } }, // SQUARE
+		{ {    0, 0.003f }, {    0, 0.005f } }, // NOISE
+	};
+
+
+	bool Find (
+		IN		const c8* const& 	name,
+		OUT		CLICK& 				click
+	) {
+		const u32 index = NAMES_TABLE.Find (name);
+		if (index == CLICK_COUNT) return false;
+
+		click = (CLICK)index;
+		return true;
+	}
+
+
+	void Render (
+		OUT		s16* const& 		pcm,
+		IN		const CLICK& 		click,
+		IN		const VOICE& 		voice
+	) {
+		// Phase accumulator in 16.16 fixed point over the 'TABLE_SIZE' entries.
+		const u32 step = (u32)(((u64)voice.frequency * TABLE_SIZE << 16) / SAMPLING_RATE);
+		const r32 decay = expf (-1.0f / (voice.decay * SAMPLING_RATE));
+		const r32 attack = 1.0f / ATTACK_LENGTH;
+
+		u32 phase = 0;
+		u32 noise = 0x1234567;
+		r32 envelope = 1.0f;
+
+		for (u16 i = 0; i < CLICK_LENGTH; ++i) {
+			u8 code;
+
+			switch (click) {
+				case CLICK_SINE: 	code = SINE[(phase >> 16) & (TABLE_SIZE - 1)]; 					break;
+				case CLICK_SQUARE: 	code = ((phase >> 16) & (TABLE_SIZE - 1)) < (TABLE_SIZE / 2) ? 0x40 : 0xC0; 	break;
+				default: 			noise = noise * 1664525 + 1013904223; code = noise >> 24; 		break; // LCG
+			}
+
+			phase += step;
+
+			// Linear attack to avoid a pop, exponential decay afterwards.
+			const r32 gain = i < ATTACK_LENGTH ? i * attack : (envelope *= decay);
+			pcm[i] = (s16)(w8 (code).real32 () * gain * 32767.0f);
+		}
+	}
+
+
+	// Render a synthesized click (regular & accent variants) into the given AL buffers.
+	void Load (
+		INOUT 	const ALuint& 			buffer,
+		INOUT 	const ALuint& 			accentBuffer,
+		IN 		const CLICK& 			click
+	) {
+		s16 pcm [CLICK_LENGTH];
+
+		Render (pcm, click, VOICES[click][0]);
+		alBufferData (buffer, AL_FORMAT_MONO16, pcm, sizeof (pcm), SAMPLING_RATE);
+
+		Render (pcm, click, VOICES[click][1]);
+		alBufferData (accentBuffer, AL_FORMAT_MONO16, pcm, sizeof (pcm), SAMPLING_RATE);
+
+		if (alGetError() == AL_NO_ERROR) { LOGINFO (METRONOME_MESSAGE_SYNTH "Buffered '%s'!\n", NAMES[click]); }
+		else { ERROR (METRONOME_MESSAGE_SYNTH "Failed to buffer data!"); }
+	}
+
+}
@@ -0,0 +1,201 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/error.hpp>
+#include <blue/timestamp.hpp>
+//
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+//
+#include "global.hpp"
+
+
+//  ABOUT
+// Tap tempo. A 't' line toggles tapping, while it's on every enter is a tap - and so is
+//  every onset '--grade' hears. Each tap sets the tempo as soon as there are
+//  'METRONOME_TAP_MINIMUM' of them, through the same 'BPM' command the keyboard and OSC
+//  push, so it's played from the next beat on.
+//
+//  The last 'METRONOME_TAP_TAPS' taps are kept. Their median interval puts every tap on a
+//  beat counted back from the newest one - a skipped beat lands two beats back, not as one
+//  long interval. A line fitted through (beat, time) gives the beat length. Taps further
+//  than 'METRONOME_TAP_OUTLIER' of a beat from the line, and all but the closest tap of a
+//  beat, are left out and the line fitted again. 'METRONOME_TAP_RESET' without a tap starts
+//  over.
+//
+//  Taps come from the keyboard and the grading thread, a spin lock keeps them apart. An
+//  onset can come after a newer key tap, it's put in its place.
+//
+
+#define METRONOME_TAP_KEY 			't'
+#define METRONOME_TAP_TAPS 			8
+#define METRONOME_TAP_MINIMUM 		3 		// Taps before a tempo is set.
+#define METRONOME_TAP_OUTLIER 		0.2 	// Of a beat, from the fitted line.
+#define METRONOME_TAP_RESET 		2000 	// ms
+
+
+namespace TAP {
+
+	struct TAPS {
+		u64 times [METRONOME_TAP_TAPS]; 	// Oldest first.
+		u32 count;
+	};
+
+	TAPS taps {};
+	u16 pushed = 0; 	// Tempo pushed last, bpm.
+
+	std::atomic<bool> isTapping = false;
+	std::atomic_flag lock = ATOMIC_FLAG_INIT;
+
+}
+
+
+namespace TAP {
+
+	// Slope and intercept of 'times' over 'beats' for the taps in 'isKept'. False when they
+	//  don't span two beats.
+	bool Fit (
+		IN		const r64* const& 	beats,
+		IN		const r64* const& 	times,
+		IN		const bool* const& 	isKept,
+		IN		const u32& 			count,
+		OUT		r64& 				slope,
+		OUT		r64& 				intercept
+	) {
+		r64 kept = 0, sumBeat = 0, sumTime = 0;
+
+		for (u32 i = 0; i < count; ++i) {
+			if (!isKept[i]) continue;
+			kept += 1; sumBeat += beats[i]; sumTime += times[i];
+		}
+
+		if (kept < 2) return false;
+
+		const r64 meanBeat = sumBeat / kept, meanTime = sumTime / kept;
+		r64 spread = 0, product = 0;
+
+		for (u32 i = 0; i < count; ++i) {
+			if (!isKept[i]) continue;
+			spread 	+= (beats[i] - meanBeat) * (beats[i] - meanBeat);
+			product += (beats[i] - meanBeat) * (times[i] - meanTime);
+		}
+
+		if (spread == 0) return false;
+
+		slope 		= product / spread;
+		intercept 	= meanTime - slope * meanBeat;
+		return slope > 0;
+	}
+
+	// Adds a tap at 'time' (nanoseconds), in order. Returns the tempo in bpm or 0 while there
+	//  isn't one.
+	r64 Estimate (
+		INOUT	TAPS& 			taps,
+		IN		const u64& 		time
+	) {
+		constexpr u64 RESET = METRONOME_TAP_RESET * 1000000ull;
+
+		if (taps.count && time > taps.times[taps.count - 1] && time - taps.times[taps.count - 1] > RESET) taps.count = 0;
+
+		// Onsets are placed back by the capture latency, one can be older than a key tap
+		//  already in - it goes in order. Older than all of a full list, or than the
+		//  newest by a reset, it's left out.
+		u32 at = taps.count;
+		while (at && taps.times[at - 1] > time) --at;
+
+		if (at < taps.count && taps.times[taps.count - 1] - time > RESET) return 0;
+		if (at == 0 && taps.count == METRONOME_TAP_TAPS) return 0;
+
+		if (taps.count == METRONOME_TAP_TAPS) {
+			memmove (taps.times, taps.times + 1, (METRONOME_TAP_TAPS - 1) * sizeof (u64));
+			--taps.count;
+			--at;
+		}
+
+		memmove (taps.times + at + 1, taps.times + at, (taps.count - at) * sizeof (u64));
+		taps.times[at] = time;
+		++taps.count;
+
+		if (taps.count < METRONOME_TAP_MINIMUM) return 0;
+
+		const u32 count = taps.count;
+		r64 intervals [METRONOME_TAP_TAPS];
+
+		for (u32 i = 1; i < count; ++i) intervals[i - 1] = (r64)(taps.times[i] - taps.times[i - 1]);
+		std::sort (intervals, intervals + count - 1);
+
+		const u32 half = (count - 1) / 2;
+		const r64 median = (count - 1) % 2 ? intervals[half] : (intervals[half - 1] + intervals[half]) / 2;
+		if (median <= 0) return 0;
+
+		// Back from the newest tap, relative times keep doubles exact.
+		r64 beats [METRONOME_TAP_TAPS], times [METRONOME_TAP_TAPS];
+		bool isKept [METRONOME_TAP_TAPS];
+
+		for (u32 i = 0; i < count; ++i) {
+			times[i] 	= -(r64)(taps.times[count - 1] - taps.times[i]);
+			beats[i] 	= round (times[i] / median);
+			isKept[i] 	= true;
+		}
+
+		r64 slope = median, intercept = 0;
+		if (!Fit (beats, times, isKept, count, slope, intercept)) return 0;
+
+		for (u32 i = 0; i < count; ++i) {
+			const r64 residual = fabs (times[i] - (intercept + slope * beats[i]));
+			if (residual > METRONOME_TAP_OUTLIER * slope) { isKept[i] = false; continue; }
+
+			// One tap per beat, the closest to the line.
+			for (u32 j = 0; j < i; ++j) {
+				if (!isKept[j] || beats[j] != beats[i]) continue;
+
+				const r64 other = fabs (times[j] - (intercept + slope * beats[j]));
+				if (other <= residual) isKept[i] = false;
+				else isKept[j] = false;
+			}
+		}
+
+		if (!Fit (beats, times, isKept, count, slope, intercept)) return 0;
+		return 60e9 / slope;
+	}
+
+	// Keyboard and grading threads.
+	void Tap (
+		IN		const u64& 		time
+	) {
+		using ARGUMENTS::MAINARGS;
+		constexpr const auto& BPM = ARGUMENTS::OPTION::Find<&MAINARGS::bpm> ();
+
+		if (!isTapping.load (std::memory_order_relaxed)) return;
+
+		while (lock.test_and_set (std::memory_order_acquire));
+
+		const r64 bpm = Estimate (taps, time);
+		const u16 rounded = bpm < BPM.min ? BPM.min : bpm > BPM.max ? BPM.max : (u16)(bpm + 0.5);
+		const bool isChanged = bpm != 0 && rounded != pushed;
+
+		if (isChanged) pushed = rounded;
+
+		lock.clear (std::memory_order_release);
+
+		if (!isChanged) return;
+
+		GLOBAL::PushCommand (METRONOME_COMMAND_BPM, rounded);
+		printf ("Tapped %.1f bpm.\n", bpm);
+	}
+
+	void Toggle () {
+		while (lock.test_and_set (std::memory_order_acquire));
+		taps.count = 0;
+		pushed = 0;
+		lock.clear (std::memory_order_release);
+
+		const bool isOn = !isTapping.load (std::memory_order_relaxed);
+		isTapping.store (isOn, std::memory_order_relaxed);
+
+		printf (isOn ? "Tap tempo - press enter on the beat, '%c' again to stop.\n" : "Tap tempo off.\n", METRONOME_TAP_KEY);
+	}
+
+}
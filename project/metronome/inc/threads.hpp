@@ -5,14 +5,20 @@
 #include <threads.h>
 //
 #include "global.hpp"
+#include "reload.hpp"
+#include "osc.hpp"
+#include "tap.hpp"
 
 namespace THREADS {
 
 	struct YIELDARGS {
 		METRONOME_ARGUMENT_TYPE_WAIT        wait;
-		METRONOME_ARGUMENT_TYPE_BPM         bmp;
-        METRONOME_ARGUMENT_TYPE_PATTERN     pattern;
-		ALuint                              source;
+		const BANK::SLOT*                   slot;
+	};
+
+	struct WATCHARGS {
+		const c8*                           session;
+		const ARGUMENTS::MAINARGS*          args;
 	};
 
 }
@@ -37,6 +43,12 @@ namespace THREADS {
 			// TODO
 			// Right now it waits for new-line. That's not needed. 
 			if (fgets (buffer, sizeof (buffer), stdin)) {
+				const u64 entered = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+
+				if (buffer[0] == METRONOME_TAP_KEY && buffer[1] == '\n') { TAP::Toggle (); continue; } // The whole line, "t\n".
+				if (buffer[0] == '\n' && TAP::isTapping.load (std::memory_order_relaxed)) { TAP::Tap (entered); continue; }
+
+				GLOBAL::PushCommand (buffer[0]);
 				printf("You entered: %s", buffer);
 				GLOBAL::isStopPlayback = false;
 			}
@@ -81,9 +93,113 @@ namespace THREADS {
 			}
 		}
 
-		GLOBAL::PlayBPM (args.bmp, args.pattern, args.source);
+		GLOBAL::PlaySchedule (args.slot);
 	
 		return 0;
 	}
 
+
+	s32 LISTEN (
+		INOUT 	void* anyargs
+	) {
+
+		DEBUG (DEBUG_FLAG_LOGGING) {
+			if (anyargs != nullptr) LOGWARN ("Arguments passed to 'LTHREAD'!");
+		}
+
+		while (GLOBAL::isStopPlayback) OSC::Receive ();
+
+		return 0;
+	}
+
+
+	s32 SYNC (
+		INOUT 	void* anyargs
+	) {
+
+		DEBUG (DEBUG_FLAG_LOGGING) {
+			if (anyargs != nullptr) LOGWARN ("Arguments passed to 'STHREAD'!");
+		}
+
+		while (GLOBAL::isStopPlayback) {
+			if (SYNC::isLeading) SYNC::Serve ();
+			else SYNC::Exchange ();
+		}
+
+		return 0;
+	}
+
+
+	s32 PEERS (
+		INOUT 	void* anyargs
+	) {
+
+		DEBUG (DEBUG_FLAG_LOGGING) {
+			if (anyargs != nullptr) LOGWARN ("Arguments passed to 'ETHREAD'!");
+		}
+
+		while (GLOBAL::isStopPlayback) PEERS::Exchange ();
+
+		return 0;
+	}
+
+
+	s32 GRADE (
+		INOUT 	void* anyargs
+	) {
+
+		DEBUG (DEBUG_FLAG_LOGGING) {
+			if (anyargs != nullptr) LOGWARN ("Arguments passed to 'GTHREAD'!");
+		}
+
+		u64 onsets [METRONOME_ONSET_FOUND];
+
+		while (GLOBAL::isStopPlayback) {
+			const u32 found = ONSET::Listen (onsets);
+			for (u32 i = 0; i < found; ++i) TAP::Tap (onsets[i]);
+		}
+
+		return 0;
+	}
+
+
+	s32 WATCH (
+		INOUT 	void* anyargs
+	) {
+
+		DEBUG (DEBUG_FLAG_LOGGING) {
+			if (anyargs == nullptr) LOGWARN ("No arguments passed to 'WTHREAD'!");
+		}
+
+		const auto args = *(WATCHARGS*)anyargs;
+		const timespec settle { 0, METRONOME_RELOAD_SETTLE * 1000000l };
+
+		RELOAD::Watch (args.session, *BANK::playing.load ()->plan);
+
+		while (GLOBAL::isStopPlayback) {
+
+			if (!IO::WATCH::Wait (RELOAD::watch, METRONOME_RELOAD_POLL)) continue;
+
+			thrd_sleep (&settle, nullptr);
+			IO::WATCH::Wait (RELOAD::watch, 0); // Settled, don't report it again.
+
+			BANK::SLOT* spare = BANK::GetSpare ();
+			for (; spare == nullptr && GLOBAL::isStopPlayback; spare = BANK::GetSpare ()) {
+				thrd_sleep (&settle, nullptr); // Previous reload wasn't taken yet.
+			}
+
+			if (spare == nullptr) break;
+
+			if (RELOAD::Prepare (*spare, args.session, *args.args)) {
+				BANK::pending.store (spare, std::memory_order_release);
+				RELOAD::Watch (args.session, *spare->plan);
+				printf ("Session reloaded. Switching at the next bar.\n");
+			}
+		}
+
+		IO::WATCH::Destroy (RELOAD::watch);
+
+		return 0;
+	}
+
 }
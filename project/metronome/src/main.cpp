@@ -5,6 +5,14 @@
 #include "bluelib.hpp"
 //
 #include "arguments.hpp"
+#include "schedule.hpp"
+#include "session.hpp"
+#include "compiled.hpp"
+#include "daemon.hpp"
+#include "latency.hpp"
+#include "bank.hpp"
+#include "midi.hpp"
+#include "follow.hpp"
 #include "threads.hpp"
 #include "global.hpp"
 #include <blue/wave.hpp>
@@ -12,99 +20,163 @@
 
 s32 main (s32 argumentsCount, c8** arguments) {
 
-	ARGUMENTS::MAINARGS mainArgs {
-		nullptr,
-		METRONOME_ARGUMENT_DEFAULT_BPM,
-		METRONOME_ARGUMENT_DEFAULT_WAIT,
-		METRONOME_ARGUMENT_DEFAULT_VOLUME,
-        METRONOME_ARGUMENT_DEFAULT_PATTERN,
-	};
+	ARGUMENTS::MAINARGS mainArgs = ARGUMENTS::Defaults ();
 
 
 	ALCdevice* device;
 	ALCcontext* context;
-	ALuint buffer;
-	ALuint source;
+	BANK::SLOT& slot = BANK::slots[0];
 
 
     { // BLUE START
         TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+        LOGSTART ();
+
+        if (MEMORY::ARENA::Create (MEMORY_ARENA_SIZE)) {
+            MEMORY::EXIT::PUSH (MEMORY::ARENA::Destroy, 1, nullptr);
+        } else {
+            LOGWARN ("Arena could not be reserved. Falling back to 'malloc'.\n");
+        }
+
         DEBUG (DEBUG_FLAG_LOGGING) putc ('\n', stdout); // Align fututre debug-logs
         LOGINFO ("Application Statred!\n");
     }
 
 
+	if (COMPILED::IsCommand (argumentsCount, arguments)) {
+		COMPILED::Command (argumentsCount, arguments);
+	}
+
+	if (DAEMON::IsCommand (argumentsCount, arguments)) {
+		DAEMON::Command (argumentsCount, arguments);
+	}
+
+	if (LATENCY::IsCommand (argumentsCount, arguments)) {
+		LATENCY::Command (argumentsCount, arguments);
+	}
+
+
 	ARGUMENTS::Get (argumentsCount, arguments, mainArgs);
 
 
 	const auto& filename 	= mainArgs.filename;
+	const auto& session 	= mainArgs.session;
+	const auto& compiled 	= mainArgs.compiled;
 	const auto& bpm 		= mainArgs.bpm;
 	const auto& wait 		= mainArgs.wait;
 	const auto& volume 		= mainArgs.volume;
-    auto& pattern 	        = mainArgs.pattern;
+	const auto& pattern 	= mainArgs.pattern;
+	const auto& midi 		= mainArgs.midi;
+	const auto& follow 		= mainArgs.follow;
+	const auto& osc 		= mainArgs.osc;
+	const auto& lead 		= mainArgs.lead;
+	const auto& join 		= mainArgs.join;
+	const auto& peers 		= mainArgs.peers;
+	const auto& latency 	= mainArgs.latency;
+	const auto& grade 		= mainArgs.grade;
 
 
 	LOGINFO (
-		"filename: %s, bpm: %d, wait: %d, volume: %d, pattern: %d\n",
-		filename, bpm, wait, volume, pattern
+		"filename: %s, session: %s, bpm: %d, wait: %d, volume: %d, pattern: %d\n",
+		filename, session ? session : "-", bpm, wait, volume, pattern
 	);
 
-    {
-        // Offset
-        // 1 means every 1byte which tlanslates to pattern iterator being always equal to 0.
-        --pattern;
-    }
+	LOGINFO ("midi: %d, follow: %d, osc: %d, lead: %d, join: %s, peers: %d\n", midi, follow, osc, lead, join ? join : "-", peers);
+	LOGINFO ("latency: %d, grade: %s\n", latency, grade ? grade : "-");
 
 
-	{ // OPENAL INIT
-		AUDIO::LISTENER::Create (device, context);
+	COMPILED::LOADED loaded {};
 
-		alGenBuffers (1, &buffer);
-		alGenSources (1, &source);
+	if (lead && join) ERROR ("Invalid argument passed, '--lead' and '--join' can't be used together\n");
+	if (follow && join) ERROR ("Invalid argument passed, '--follow' and '--join' can't be used together\n");
+	if (peers && (follow || join)) ERROR ("Invalid argument passed, '--peers' can't be used with '--follow' or '--join'\n");
+
+	if (session && compiled) {
+		ERROR ("Invalid argument passed, '--json' and '--compiled' can't be used together\n");
+	} else if (compiled) {
+		COMPILED::Load (compiled, loaded);
+	} else if (session) {
+		SESSION::Load (session, mainArgs, SCHEDULE::plan);
+	} else {
+		SCHEDULE::FromArguments (SCHEDULE::plan, mainArgs);
+	}
+
+	slot.plan = loaded.plan ? loaded.plan : &SCHEDULE::plan;
 
-		OPUS::Load (buffer, filename);
 
-		{ // Release filepath.
-			MEMORY::EXIT::POP ();
-			FREE (1, filename);
-		}
+	{ // OPENAL INIT
+		AUDIO::LISTENER::Create (device, context);
+		LATENCY::Set (device, latency);
 
 		AUDIO::LISTENER::SetPosition (0.0f, 0.0f, 0.0f);
 		AUDIO::LISTENER::SetGain (volume / 100.0f);
 
-		AUDIO::SOURCE::SetBuffer (source, buffer);
-		AUDIO::SOURCE::SetPosition (source, 0.0f, 0.0f, 0.0f);
-		AUDIO::SOURCE::SetGain (source, 1.0f);
+		BANK::Create (slot.sounds, *slot.plan, loaded);
+		BANK::playing = &slot;
 	}
 
 
+	MIDI::Open (midi);
+	FOLLOW::Open (follow);
+	if (osc) OSC::Open (osc);
+	if (lead) SYNC::Lead (lead);
+	if (join) SYNC::Join (join);
+	if (peers) PEERS::Open (peers, 60000000000ull / slot.plan->bpm[0], slot.plan->pattern[0] - 1);
+	ONSET::Open (grade);
+
+
 	{ // Future ERROR.
-		MEMORY::EXIT::PUSH (AL_WRAPPER::DestroyBuffers, 1, &buffer);
-		MEMORY::EXIT::PUSH (AL_WRAPPER::DestroySources, 1, &source);
+		MEMORY::EXIT::PUSH (AL_WRAPPER::DestroyBuffers, slot.sounds.count, slot.sounds.buffers);
+		MEMORY::EXIT::PUSH (AL_WRAPPER::DestroySources, slot.sounds.count, slot.sounds.sources);
 	}
 
 
 	{ // THREADING
-		THREADS::YIELDARGS args { wait, bpm, pattern, source };
+		THREADS::YIELDARGS args { wait, &slot };
+		THREADS::WATCHARGS watchArgs { session, &mainArgs };
 
-		thrd_t iThread, oThread;
+		thrd_t iThread, oThread, wThread, lThread, sThread, eThread, gThread;
 		thrd_create (&oThread, THREADS::YIELD, &args);
 		thrd_create (&iThread, THREADS::INPUT, NULL);
+		if (session) thrd_create (&wThread, THREADS::WATCH, &watchArgs); // Only '--json' sessions are reloaded.
+		if (osc) thrd_create (&lThread, THREADS::LISTEN, NULL);
+		if (lead || join) thrd_create (&sThread, THREADS::SYNC, NULL);
+		if (peers) thrd_create (&eThread, THREADS::PEERS, NULL);
+		if (grade) thrd_create (&gThread, THREADS::GRADE, NULL);
 
    		thrd_join (iThread, NULL);
 		thrd_join (oThread, NULL);
+		if (session) thrd_join (wThread, NULL);
+		if (osc) thrd_join (lThread, NULL);
+		if (lead || join) thrd_join (sThread, NULL);
+		if (peers) thrd_join (eThread, NULL);
+		if (grade) thrd_join (gThread, NULL);
 	}
 
 
+	ONSET::Close ();
+	PEERS::Close ();
+	SYNC::Close ();
+	OSC::Close ();
+	FOLLOW::Close ();
+	MIDI::Close ();
+
+
 	{ // OPENAL EXIT
-		alDeleteSources (1, &source);
-		alDeleteBuffers (1, &buffer);
+		BANK::Destroy (BANK::slots[0].sounds);
+		BANK::Destroy (BANK::slots[1].sounds);
 
 		AUDIO::LISTENER::Destroy (device, context);
 	}
+
+
+	IO::Unmap (loaded.mapping);
 	
 
 	{ // BLUE EXIT
+		TRACEDUMP (METRONOME_TRACE_FILENAME);
+		LOGSTOP ();
+		MEMORY::ARENA::Destroy (1, nullptr);
 		LOGMEMORY ();
 		LOGINFO ("Finalized Execution\n");
 		DEBUG (DEBUG_FLAG_LOGGING) putc ('\n', stdout); // Align debug-logs
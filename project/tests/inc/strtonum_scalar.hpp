@@ -0,0 +1,236 @@
+/*
+ * mstd - Maipa's Standard Library
+ *
+ * Licensed under the BSD 3-Clause License with Attribution Requirement.
+ * See the LICENSE file for details: https://github.com/MAIPA01/mstd/blob/main/LICENSE
+ *
+ * Copyright (c) 2025, Patryk Antosik (MAIPA01)
+ */
+
+#pragma once
+#include <mstd/strtonum.hpp>
+#include <mstd/isstrnum.hpp>
+
+// The vendored mstd number parsers before they read 8 digits at a time, kept for 'bench_numbers'.
+// The 0b / 0c / 0x forms they hand over to are unchanged and shared.
+
+namespace mstd::scalar {
+	static bool isstrnum(const std::string& str) {
+		if (str.size() == 0) return false;
+
+		if (str.size() > 2) {
+			if (str[0] == '0') {
+				if (str[1] == 'b') {
+					return isstrbin(str);
+				}
+				else if (str[1] == 'c') {
+					return isstroct(str);
+				}
+				else if (str[1] == 'x') {
+					return isstrhex(str);
+				}
+			}
+		}
+
+		size_t i = 0;
+		while (str[i] == '+' || str[i] == '-') {
+			++i;
+			if (i == str.size()) return false;
+		}
+
+		for (; i != str.size(); ++i) {
+			if (str[i] < '0' || str[i] > '9') return false;
+		}
+
+		return true;
+	}
+
+	static bool isstrunum(const std::string& str) {
+		if (str.size() == 0) return false;
+
+		if (str.size() > 2) {
+			if (str[0] == '0') {
+				if (str[1] == 'b') {
+					return isstrbin(str);
+				}
+				else if (str[1] == 'c') {
+					return isstroct(str);
+				}
+				else if (str[1] == 'x') {
+					return isstrhex(str);
+				}
+			}
+		}
+
+		size_t i = 0;
+		while (str[i] == '+') {
+			++i;
+			if (i == str.size()) return false;
+		}
+
+		for (; i != str.size(); ++i) {
+			if (str[i] < '0' || str[i] > '9') return false;
+		}
+
+		return true;
+	}
+
+	static bool isstrfp(const std::string& str) {
+		if (str.size() == 0) return false;
+
+		size_t i = 0;
+		while (str[i] == '+' || str[i] == '-') {
+			++i;
+			if (i == str.size()) return false;
+		}
+
+		while (str[i] >= '0' && str[i] <= '9') {
+			++i;
+			if (i == str.size()) return true;
+		}
+
+		if (str[i] == '.') {
+			++i;
+			if (i == str.size()) return false;
+
+			while (str[i] >= '0' && str[i] <= '9') {
+				++i;
+				if (i == str.size()) return true;
+			}
+		}
+
+		return false;
+	}
+
+	// ((+|-)* 12) | (0b00...) | (0c00...) | (0x00...)
+	template<class _SN, std::enable_if_t<std::is_integral_v<_SN>, bool> = true>
+	static constexpr bool strtonum(const std::string& str, _SN& num) {
+		if (str.size() == 0) return false;
+
+		if (str.size() > 2) {
+			if (str[0] == '0') {
+				if (str[1] == 'b') {
+					return strbtonum(str, num);
+				}
+				else if (str[1] == 'c') {
+					return strctonum(str, num);
+				}
+				else if (str[1] == 'x') {
+					return strxtonum(str, num);
+				}
+			}
+		}
+
+		size_t i = 0;
+
+		_SN sign = 1;
+		while (str[i] == '-' || str[i] == '+') {
+			if (str[i] == '-') sign *= -1;
+			
+			++i;
+			if (i == str.size()) return false;
+		}
+
+		num = 0;
+		while (str[i] >= '0' && str[i] <= '9') {
+			if (mul_overflow(num, 10, num)) {
+				return false;
+			}
+			if (add_overflow(num, sign * (str[i] - '0'), num)) {
+				return false;
+			}
+
+			++i;
+			if (i == str.size()) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// (+* 12) | (0b00...) | (0c00...) | (0x00...)
+	template<class _UN, std::enable_if_t<std::is_integral_v<_UN>, bool> = true>
+	static constexpr bool strtounum(const std::string& str, _UN& num) {
+		if (str.size() == 0) return false;
+
+		if (str.size() > 2) {
+			if (str[0] == '0') {
+				if (str[1] == 'b') {
+					return strbtonum(str, num);
+				}
+				else if (str[1] == 'c') {
+					return strctonum(str, num);
+				}
+				else if (str[1] == 'x') {
+					return strxtonum(str, num);
+				}
+			}
+		}
+
+		size_t i = 0;
+		while (str[i] == '+') {
+			++i;
+			if (i == str.size()) return false;
+		}
+
+		num = 0;
+		while (str[i] >= '0' && str[i] <= '9') {
+			if (mul_overflow(num, 10u, num)) {
+				return false;
+			}
+			if (add_overflow(num, str[i] - '0', num)) {
+				return false;
+			}
+
+			++i;
+			if (i == str.size()) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// ((+|-)* 12.22)
+	template<class _FP, std::enable_if_t<std::is_floating_point_v<_FP>, bool> = true>
+	static constexpr bool strtofp(const std::string& str, _FP& num) {
+		if (str.size() == 0) return false;
+
+		size_t i = 0;
+
+		_FP sign = 1;
+		while (str[i] == '-' || str[i] == '+') {
+			if (str[i] == '-') sign *= -1;
+			
+			++i;
+			if (i == str.size()) return false;
+		}
+
+		num = 0;
+		
+		while (str[i] >= '0' && str[i] <= '9') {
+			num *= 10;
+			num += str[i] - '0';
+
+			++i;
+			if (i == str.size()) return true;
+		}
+
+		if (str[i] == '.') {
+			++i;
+			if (i == str.size()) return false;
+
+			_FP decimal = 0.1;
+			while (str[i] >= '0' && str[i] <= '9') {
+				num += decimal * (str[i] - '0');
+				decimal *= 0.1;
+
+				++i;
+				if (i == str.size()) return true;
+			}
+		}
+
+		return false;
+	}
+}
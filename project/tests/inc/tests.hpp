@@ -0,0 +1,107 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#pragma once
+#include <blue/types.hpp>
+#include <blue/timestamp.hpp>
+//
+#include <cstdio>
+//
+#ifndef _WIN32
+	#include <spawn.h>
+	#include <signal.h>
+	#include <sys/wait.h>
+#endif
+
+
+//  ABOUT
+// Shared by tests and benchmarks. A failed 'CHECK' is printed and counted, tests return
+//  'TESTS::failed' so 'ctest' reports them. Benchmarks pass what they computed to 'Keep'
+//  so the measured loop isn't optimized away. Tests of more processes run their own
+//  executable again ('Spawn') with arguments telling it which part to play.
+//
+
+#define CHECK(condition, ...) if (!(condition)) { \
+	++TESTS::failed; \
+	printf ("%s:%d: FAILED ", __FILE__, __LINE__); \
+	printf (__VA_ARGS__); \
+	putc ('\n', stdout); \
+}
+
+
+namespace TESTS {
+
+	u32 failed = 0;
+	volatile r64 kept = 0;
+
+	u64 Now () {
+		return TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+	}
+
+	void Keep (
+		IN		const r64& 		value
+	) {
+		kept = kept + value;
+	}
+
+	#ifdef _WIN32
+		using PROCESS = HANDLE;
+	#else
+		using PROCESS = pid_t;
+	#endif
+
+	// 'arguments' without the program.
+	template <u32 size>
+	PROCESS Spawn (
+		IN		const c8* const& 				program,
+		IN		const c8* const (&arguments) [size]
+	) {
+		#ifdef _WIN32
+			c8 line [1024];
+			u32 length = snprintf (line, sizeof (line), "\"%s\"", program);
+			for (u32 i = 0; i < size && length < sizeof (line); ++i) length += snprintf (line + length, sizeof (line) - length, " %s", arguments[i]);
+
+			STARTUPINFOA startup { sizeof (startup) };
+			PROCESS_INFORMATION information;
+
+			if (!CreateProcessA (nullptr, line, nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup, &information)) {
+				printf ("'%s' could not be started.\n", line);
+				exit (1);
+			}
+
+			CloseHandle (information.hThread);
+			return information.hProcess;
+		#else
+			const c8* argv [size + 2] { program };
+			for (u32 i = 0; i < size; ++i) argv[i + 1] = arguments[i];
+
+			pid_t process;
+			if (posix_spawn (&process, program, nullptr, nullptr, (c8* const*)argv, nullptr) != 0) {
+				printf ("'%s' could not be started.\n", program);
+				exit (1);
+			}
+
+			return process;
+		#endif
+	}
+
+	void Stop (
+		IN		const PROCESS& 		process
+	) {
+		#ifdef _WIN32
+			TerminateProcess (process, 0);
+			WaitForSingleObject (process, INFINITE);
+			CloseHandle (process);
+		#else
+			kill (process, SIGTERM);
+			waitpid (process, nullptr, 0);
+		#endif
+	}
+
+	s32 Result () {
+		if (failed) printf ("%u check(s) failed.\n", failed);
+		else printf ("All checks passed.\n");
+		return failed != 0;
+	}
+
+}
@@ -0,0 +1,133 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <new>
+//
+#include "arguments.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// Startup argument parsing - 'ARGUMENTS::Get' (constexpr option table, single pass) against
+//  the 'margs' path it replaced ('bench_arguments_margs.cpp'). The same command lines, with
+//  only the 5 options 'margs' knew, are parsed 'BENCH_PARSES' times each way. Reported are
+//  nanoseconds per parse and 'operator new' calls per parse, and both have to agree on the
+//  values they read. Where 'margs' doesn't compile (GCC) only the table parser is measured.
+//
+//  USAGE: bench_arguments [parses]
+//
+
+#define BENCH_PARSES 		100000
+#define BENCH_ARGUMENTS 	11
+
+
+#ifdef BENCH_MARGS
+
+	struct MARGSARGS {
+		char* filename;
+		uint16_t bpm;
+		uint16_t wait;
+		uint16_t volume;
+		uint8_t pattern;
+	};
+
+	bool GetMargs (const s32& argumentsCount, c8** arguments, MARGSARGS& args);
+	void FreeMargs (MARGSARGS& args);
+
+#endif
+
+
+u64 newCount = 0; // 'margs' allocates through 'operator new'.
+
+void* operator new (size_t size) {
+	++newCount;
+	if (void* data = malloc (size ? size : 1)) return data;
+	throw std::bad_alloc ();
+}
+
+void operator delete (void* data) noexcept { free (data); }
+void operator delete (void* data, size_t) noexcept { free (data); }
+
+
+struct LINE {
+	const c8* name;
+	s32 count;
+	const c8* arguments [BENCH_ARGUMENTS];
+};
+
+
+const LINE lines [] {
+	{ "defaults", 	1, 	{ "metronome" } },
+	{ "short", 		11, { "metronome", "-f", "square", "-b", "140", "-w", "0", "-v", "80", "-p", "3" } },
+	{ "long", 		11, { "metronome", "--filename", "square", "--bpm", "140", "--wait", "0", "--volume", "80", "--pattern", "3" } },
+};
+
+
+s32 main (s32 argumentsCount, c8** arguments) {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	const u32 parses = argumentsCount > 1 ? atoi (arguments[1]) : BENCH_PARSES;
+	if (parses == 0) ERROR ("At least 1 parse.\n");
+
+	printf ("%-10s %14s %14s %14s %14s\n", "arguments", "table ns", "table news", "margs ns", "margs news");
+
+	for (const LINE& line : lines) {
+		c8** const argv = (c8**)line.arguments;
+		const ARGUMENTS::MAINARGS defaults = ARGUMENTS::Defaults ();
+
+		ARGUMENTS::MAINARGS args;
+		u64 news = newCount;
+		u64 start = TESTS::Now ();
+
+		for (u32 i = 0; i < parses; ++i) {
+			args = defaults;
+			ARGUMENTS::Get (line.count, argv, args);
+			TESTS::Keep (args.bpm);
+		}
+
+		const r64 tableNs = (r64)(TESTS::Now () - start) / parses;
+		const r64 tableNews = (r64)(newCount - news) / parses;
+
+		CHECK (tableNews == 0, "%s: the table parser allocated", line.name);
+
+		#ifdef BENCH_MARGS
+			MARGSARGS old;
+			bool isParsed = true;
+			news = newCount;
+			start = TESTS::Now ();
+
+			for (u32 i = 0; i < parses && isParsed; ++i) {
+				old = MARGSARGS { (c8*)defaults.filename, defaults.bpm, defaults.wait, defaults.volume, defaults.pattern };
+				isParsed = GetMargs (line.count, argv, old);
+				TESTS::Keep (old.bpm);
+				if (isParsed && i + 1 != parses) FreeMargs (old);
+			}
+
+			const r64 margsNs = (r64)(TESTS::Now () - start) / parses;
+			const r64 margsNews = (r64)(newCount - news) / parses;
+
+			printf ("%-10s %14.0f %14.1f %14.0f %14.1f\n", line.name, tableNs, tableNews, margsNs, margsNews);
+			CHECK (isParsed, "%s: 'margs' rejected the arguments", line.name);
+
+			if (isParsed) {
+				CHECK (
+					strcmp (args.filename, old.filename) == 0 && args.bpm == old.bpm && args.wait == old.wait &&
+					args.volume == old.volume && args.pattern == old.pattern,
+					"%s: the parsers read different values", line.name
+				);
+
+				FreeMargs (old);
+			}
+		#else
+			printf ("%-10s %14.0f %14.1f %14s %14s\n", line.name, tableNs, tableNews, "-", "-");
+		#endif
+	}
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
@@ -0,0 +1,84 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <cstring>
+#include <string>
+//
+#include <margs/margs.hpp>
+
+
+//  ABOUT
+// 'bench_arguments' second translation unit - 'ARGUMENTS::Get' as it was with 'margs', for
+//  the 5 options it knew. It builds the analizer on every call, copies the filename into an
+//  allocated buffer and clamps what it reads like the old getters did. No bluelib here, its
+//  headers can't be in two units, so 'ALLOCATE' is its 'malloc' fallback and nothing is
+//  logged. Built only where 'margs' compiles - it specializes templates in class scope,
+//  which GCC doesn't accept.
+//
+
+struct MARGSARGS {
+	char* filename;
+	uint16_t bpm;
+	uint16_t wait;
+	uint16_t volume;
+	uint8_t pattern;
+};
+
+
+template <class T>
+void Clamp (
+	const margs::args_map& 	map,
+	const char* const& 		name,
+	T& 						value,
+	const T& 				min,
+	const T& 				max
+) {
+	if (!map.contains_value (name)) return;
+	value = map.get_value (name).as<T> ();
+	if (value > max) value = max;
+	if (value < min) value = min;
+}
+
+
+// 'args' holds the defaults. Returns 'false' when 'margs' rejected the arguments.
+bool GetMargs (
+	const int32_t& 		argumentsCount,
+	char** 				arguments,
+	MARGSARGS& 			args
+) {
+	using namespace margs;
+
+	args_analizer analizer = args_analizer (
+		help_data { .description = "Args analizer sample description" },
+		args_builder::makeValue ("filename", 'f', 1, help_data { .description = "desc..." }),
+		args_builder::makeValue ("bpm", 'b', 1, help_data { .description = "desc..." }),
+		args_builder::makeValue ("wait", 'w', 1, help_data { .description = "desc..." }),
+		args_builder::makeValue ("volume", 'v', 1, help_data { .description = "desc..." }),
+		args_builder::makeValue ("pattern", 'p', 1, help_data { .description = "desc..." })
+	);
+
+	args_map values;
+
+	try { values = analizer.analize (argumentsCount, arguments);
+	} catch (const args_exception&) { return false; }
+
+	const std::string filename = values.contains_value ("filename") ? values.get_value ("filename").as<std::string> () : args.filename;
+	args.filename = (char*) malloc (filename.length () + 1);
+	memcpy (args.filename, filename.c_str (), filename.length () + 1);
+
+	Clamp<uint16_t> (values, "bpm", args.bpm, 40, 440);
+	Clamp<uint16_t> (values, "wait", args.wait, 0, 10);
+	Clamp<uint16_t> (values, "volume", args.volume, 1, 100);
+	Clamp<uint8_t> (values, "pattern", args.pattern, 1, 16);
+
+	return true;
+}
+
+
+void FreeMargs (
+	MARGSARGS& 			args
+) {
+	free (args.filename);
+}
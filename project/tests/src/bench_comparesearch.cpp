@@ -0,0 +1,277 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <blue/error.hpp>
+#include <blue/comparesearch.hpp>
+//
+#include <ctype.h>
+#include <string.h>
+//
+#include "tests.hpp"
+
+
+//  ABOUT
+// 'COMPARESEARCH' lookups against the byte-by-byte loops they replaced ('BYTEWISE', copied
+//  as they were). Two sets are searched for every one of their names (with its terminator,
+//  so only the whole name matches) and for as many missing names:
+//  - options - the 16 option names, also looked up by 'PERFECT' (built with 'MakePerfect'),
+//  - sounds - 256 '.opus' names, the low-case search runs on them written in upper-case.
+//  Nanoseconds per lookup, 'BENCH_ROUNDS' times over. Every way has to find the same index.
+//
+//  USAGE: bench_comparesearch
+//
+
+#define BENCH_ROUNDS 		2000
+#define BENCH_SOUNDS 		256
+#define BENCH_NAME 			32 		// Bytes per name, zero padded. The byte loops read past the terminator.
+
+
+namespace BYTEWISE {
+
+	void ArrayPartFirstMatch (
+		IN		const void* const	compered,
+		IN		const u16&			comperedCount,
+		IN		const u8&			comperedSize,
+		OUT		u32&				index,
+		IN		const u32&			elementsCount,
+		IN		const void* const	elements
+	) {
+		auto& iElement = index;
+		u8 collision = 1;
+
+		for (; iElement < (elementsCount * collision); ++iElement) {
+
+			for (u8 iInner = 0; iInner < comperedCount * comperedSize; ++iInner) {
+				const auto& array = ((u8**)elements)[iElement];
+				const u8& byte =  array[iInner * comperedSize];
+
+				collision += ((u8*)compered)[iInner * comperedSize] == byte;
+			}
+
+			collision = ((collision - 1) != comperedCount);
+		}
+
+		--iElement;
+	}
+
+	void ArrayPartFirstMatchVector (
+		IN		const void* const&			compered,
+		IN		const u16&					comperedCount,
+		IN		const u8&					comperedSize,
+		OUT		u32&						index,
+		IN		const u32&					elementsCount,
+		IN		const void* const* const&	elements
+	) {
+		auto& iElement = index;
+		u8 collision = 1;
+
+		for (; iElement < (elementsCount * collision); ++iElement) {
+
+			for (u8 iInner = 0; iInner < comperedCount * comperedSize; ++iInner) {
+
+				const auto& array = (u8*) (elements[iElement]);
+				const u8& byte = array[iInner * comperedSize];
+
+				collision += ((u8*)compered)[iInner * comperedSize] == byte;
+			}
+
+			collision = ((collision - 1) != comperedCount);
+		}
+
+		--iElement;
+		index += collision;
+	}
+
+	void ArrayPartFirstMatchVectorLowCase (
+		IN		const void* const&			compered,
+		IN		const u16&					comperedCount,
+		IN		const u8&					comperedSize,
+		OUT		u32&						index,
+		IN		const u32&					elementsCount,
+		IN		const void* const* const&	elements
+	) {
+		auto& iElement = index;
+		u8 collision = 1;
+
+		for (; iElement < (elementsCount * collision); ++iElement) {
+
+			for (u8 iInner = 0; iInner < comperedCount * comperedSize; ++iInner) {
+
+				const auto& array = (u8*) (elements[iElement]);
+				const u8& byte = array[iInner * comperedSize];
+				const u8 lowCaseByte = tolower (byte);
+
+				collision += ((u8*)compered)[iInner * comperedSize] == lowCaseByte;
+			}
+
+			collision = ((collision - 1) != comperedCount);
+		}
+
+		--iElement;
+		index += collision;
+	}
+
+}
+
+
+constexpr const c8* OPTIONS [] {
+	"filename", "json", "compiled", "bpm", "wait", "volume", "pattern", "midi",
+	"follow", "osc", "lead", "join", "peers", "latency", "grade", "help",
+};
+
+constexpr u32 OPTIONS_COUNT = sizeof (OPTIONS) / sizeof (OPTIONS[0]);
+constexpr auto PERFECT = COMPARESEARCH::MakePerfect (OPTIONS);
+
+
+struct SET {
+	const c8* name;
+	u32 count;
+	c8 (*names) [BENCH_NAME]; 	// Searched.
+	c8 (*queries) [BENCH_NAME]; // 'count' found then 'count' missing.
+	const void* elements [BENCH_SOUNDS];
+};
+
+
+c8 optionNames [OPTIONS_COUNT][BENCH_NAME];
+c8 optionQueries [OPTIONS_COUNT * 2][BENCH_NAME];
+c8 soundNames [BENCH_SOUNDS][BENCH_NAME];
+c8 soundUpperNames [BENCH_SOUNDS][BENCH_NAME];
+c8 soundQueries [BENCH_SOUNDS * 2][BENCH_NAME];
+
+
+void Fill (
+	INOUT	SET& 			set
+) {
+	for (u32 i = 0; i < set.count; ++i) set.elements[i] = set.names[i];
+}
+
+
+using Search = u32 (*) (const SET& set, const c8* const& query, const u16& length);
+
+
+u32 SearchBytewise (const SET& set, const c8* const& query, const u16& length) {
+	u32 index = 0;
+	BYTEWISE::ArrayPartFirstMatch (query, length, 1, index, set.count, set.elements);
+	return index;
+}
+
+u32 SearchCurrent (const SET& set, const c8* const& query, const u16& length) {
+	u32 index = 0;
+	COMPARESEARCH::ArrayPartFirstMatch (query, length, 1, index, set.count, set.elements);
+	return index;
+}
+
+u32 SearchVectorBytewise (const SET& set, const c8* const& query, const u16& length) {
+	u32 index = 0;
+	BYTEWISE::ArrayPartFirstMatchVector (query, length, 1, index, set.count, set.elements);
+	return index;
+}
+
+u32 SearchVectorCurrent (const SET& set, const c8* const& query, const u16& length) {
+	u32 index = 0;
+	COMPARESEARCH::ArrayPartFirstMatchVector (query, length, 1, index, set.count, set.elements);
+	return index;
+}
+
+u32 SearchLowCaseBytewise (const SET& set, const c8* const& query, const u16& length) {
+	u32 index = 0;
+	BYTEWISE::ArrayPartFirstMatchVectorLowCase (query, length, 1, index, set.count, set.elements);
+	return index;
+}
+
+u32 SearchLowCaseCurrent (const SET& set, const c8* const& query, const u16& length) {
+	u32 index = 0;
+	COMPARESEARCH::ArrayPartFirstMatchVectorLowCase (query, length, 1, index, set.count, set.elements);
+	return index;
+}
+
+u32 SearchPerfect (const SET&, const c8* const& query, const u16&) {
+	return PERFECT.Find (query);
+}
+
+
+// Nanoseconds per lookup. 'found' gets every lookup's index of the last round.
+r64 Measure (
+	IN		const SET& 			set,
+	IN		const Search& 		search,
+	OUT		u32* const& 		found
+) {
+	const u64 start = TESTS::Now ();
+
+	for (u32 round = 0; round < BENCH_ROUNDS; ++round) {
+		for (u32 i = 0; i < set.count * 2; ++i) {
+			const c8* const query = set.queries[i];
+			found[i] = search (set, query, strlen (query) + 1);
+		}
+
+		TESTS::Keep (found[round % (set.count * 2)]);
+	}
+
+	return (r64)(TESTS::Now () - start) / (BENCH_ROUNDS * set.count * 2);
+}
+
+
+void Compare (
+	IN		const SET& 			set,
+	IN		const c8* const& 	name,
+	IN		const Search& 		bytewise,
+	IN		const Search& 		current
+) {
+	u32 bytewiseFound [BENCH_SOUNDS * 2], currentFound [BENCH_SOUNDS * 2];
+
+	const r64 bytewiseNs = Measure (set, bytewise, bytewiseFound);
+	const r64 currentNs = Measure (set, current, currentFound);
+
+	printf ("%-8s %-28s %12.1f %12.1f\n", set.name, name, bytewiseNs, currentNs);
+
+	for (u32 i = 0; i < set.count * 2; ++i) {
+		// 'PERFECT' returns the key count when missing, the same as the vector searches.
+		if (bytewiseFound[i] == currentFound[i]) continue;
+		CHECK (false, "%s, %s: '%s' found at %u instead of %u", set.name, name, set.queries[i], currentFound[i], bytewiseFound[i]);
+		break;
+	}
+}
+
+
+s32 main () {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	for (u32 i = 0; i < OPTIONS_COUNT; ++i) {
+		strcpy (optionNames[i], OPTIONS[i]);
+		strcpy (optionQueries[i], OPTIONS[i]);
+		snprintf (optionQueries[OPTIONS_COUNT + i], BENCH_NAME, "%sx", OPTIONS[i]);
+	}
+
+	for (u32 i = 0; i < BENCH_SOUNDS; ++i) {
+		snprintf (soundNames[i], BENCH_NAME, "sounds/click-%03u.opus", i);
+		snprintf (soundUpperNames[i], BENCH_NAME, "SOUNDS/Click-%03u.OPUS", i);
+		strcpy (soundQueries[i], soundNames[i]);
+		snprintf (soundQueries[BENCH_SOUNDS + i], BENCH_NAME, "sounds/click-%03u.ogg", i);
+	}
+
+	SET options { "options", OPTIONS_COUNT, optionNames, optionQueries, {} };
+	SET sounds { "sounds", BENCH_SOUNDS, soundNames, soundQueries, {} };
+	SET upper { "sounds", BENCH_SOUNDS, soundUpperNames, soundQueries, {} };
+
+	Fill (options);
+	Fill (sounds);
+	Fill (upper);
+
+	printf ("%-8s %-28s %12s %12s\n", "set", "search", "bytewise ns", "current ns");
+
+	for (const SET* set : { &options, &sounds }) {
+		Compare (*set, "ArrayPartFirstMatch", SearchBytewise, SearchCurrent);
+		Compare (*set, "ArrayPartFirstMatchVector", SearchVectorBytewise, SearchVectorCurrent);
+	}
+
+	Compare (upper, "ArrayPartFirstMatchVectorLow", SearchLowCaseBytewise, SearchLowCaseCurrent);
+	Compare (options, "PERFECT::Find", SearchVectorBytewise, SearchPerfect);
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
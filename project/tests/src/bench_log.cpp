@@ -0,0 +1,74 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <blue/error.hpp>
+//
+#include "tests.hpp"
+
+
+//  ABOUT
+// Log lines per second, the same message every way:
+//  - stdio - what 'LOGINFO' was before 'LOGLINE', the timestamp, the tag and the message
+//    with separate 'fprintf' calls,
+//  - single write - 'LOGLINE::Write', the whole line built in one buffer, one 'write',
+//  - async - 'LOGINFO' with the async logger running, as the metronome logs. What the
+//    logging thread pays, the lines are written by the consumer one 'LOGLINE' write each.
+//    A flood like this fills the ring, messages that didn't fit are dropped and counted.
+//  Lines go to stdout and the results to stderr, so stdout is best redirected.
+//
+//  USAGE: bench_log [messages] > /dev/null
+//
+
+#define BENCH_MESSAGES 		1000000
+
+
+void Report (
+	IN		const c8* const& 	name,
+	IN		const u32& 			messages,
+	IN		const u64& 			elapsed
+) {
+	fprintf (stderr, "%-16s %14.0f messages/s\n", name, messages / (elapsed / 1e9));
+}
+
+
+s32 main (s32 argumentsCount, c8** arguments) {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+
+	const u32 messages = argumentsCount > 1 ? atoi (arguments[1]) : BENCH_MESSAGES;
+	if (messages == 0) ERROR ("At least 1 message.\n");
+
+	u64 start = TESTS::Now ();
+
+	for (u32 i = 0; i < messages; ++i) {
+		fprintf (stdout, "[" LOGGER_TIME_FORMAT "]", TIMESTAMP::GetElapsed (TIMESTAMP_BEGIN));
+		fprintf (stdout, " INFO");
+		fprintf (stdout, ": Beat %u of %u at %.3f ms.\n", i, messages, i * 0.5);
+	}
+
+	fflush (stdout);
+	Report ("stdio", messages, TESTS::Now () - start);
+
+	start = TESTS::Now ();
+
+	for (u32 i = 0; i < messages; ++i) {
+		LOGLINE::Write (LOGLINE::LEVEL_INFO, TIMESTAMP::GetElapsed (TIMESTAMP_BEGIN), "Beat %u of %u at %.3f ms.\n", i, messages, i * 0.5);
+	}
+
+	Report ("single write", messages, TESTS::Now () - start);
+
+	LOGSTART ();
+	start = TESTS::Now ();
+
+	for (u32 i = 0; i < messages; ++i) LOGINFO ("Beat %u of %u at %.3f ms.\n", i, messages, i * 0.5);
+
+	Report ("async", messages, TESTS::Now () - start);
+
+	LOGSTOP ();
+	fprintf (stderr, "%u of %u async messages dropped.\n", LOGASYNC::dropped.load (std::memory_order_relaxed), messages);
+
+	return TESTS::Result ();
+}
@@ -0,0 +1,106 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#include <blue/wave.hpp>
+//
+#include <cmath>
+//
+#include "tests.hpp"
+
+
+//  ABOUT
+// Lookup tables against computing the value. 'w8::real32' as built (multiply by 1/64)
+//  against its 'WAVE_LUT_OPT' path (a 'DIV64LUT' read) - the same header built again with
+//  the define in 'bench_lut_opt.cpp' - and an accent gain given in dB computed with 'powf'
+//  against a generated table.
+//
+//  USAGE: bench_lut
+//
+
+#define BENCH_SAMPLES 	(1 << 20)
+#define BENCH_ROUNDS 	64
+
+
+// [i] -> gain of (-i) dB, from 0dB to -60dB.
+constexpr auto DBGAIN = LUT::Generate<r32, 60 + 1> (
+	[] (u32 i) { return (r32)LUT::Exp (-(r64)i * 2.30258509299404568402 / 20.0); }
+);
+
+
+// 'w8::real32' with 'WAVE_LUT_OPT' defined, in 'bench_lut_opt.cpp'.
+r32 GetReal32Lut (
+	IN		const u8& 			value
+);
+
+r64 SumReal32Lut (
+	IN		const u8* const& 	codes,
+	IN		const u32& 			count,
+	IN		const u32& 			round
+);
+
+
+template <class Function>
+r64 Measure (
+	IN		const c8* const& 	name,
+	IN		Function 			function
+) {
+	const u64 start = TESTS::Now ();
+	r64 sum = 0;
+
+	for (u32 round = 0; round < BENCH_ROUNDS; ++round) sum += function (round);
+
+	const r64 ns = (r64)(TESTS::Now () - start) / ((r64)BENCH_ROUNDS * BENCH_SAMPLES);
+	printf ("  %-24s %6.3f ns\n", name, ns);
+	TESTS::Keep (sum);
+	return ns;
+}
+
+
+s32 main () {
+	static u8 codes [BENCH_SAMPLES];
+	static u8 decibels [BENCH_SAMPLES];
+
+	u32 noise = 0x1234567;
+	for (u32 i = 0; i < BENCH_SAMPLES; ++i) {
+		noise = noise * 1664525 + 1013904223; // LCG
+		codes[i] 	= noise >> 24;
+		decibels[i] = (noise >> 8) % 61;
+	}
+
+	for (u32 i = 0; i < 256; ++i) {
+		CHECK (w8 ((u8)i).real32 () == GetReal32Lut ((u8)i), "w8 0x%02X differs between paths", i);
+	}
+
+	for (u32 i = 0; i <= 60; ++i) {
+		const r32 computed = powf (10.0f, -(r32)i / 20.0f);
+		CHECK (fabsf (computed - DBGAIN[i]) <= computed * 1e-6f, "-%u dB: %g computed, %g in table", i, computed, DBGAIN[i]);
+	}
+
+	printf ("w8::real32, per sample:\n");
+
+	Measure ("compute (default)", [&] (u32 round) {
+		r32 sum = 0;
+		for (u32 i = 0; i < BENCH_SAMPLES; ++i) sum += w8 ((u8)(codes[i] + round)).real32 ();
+		return (r64)sum;
+	});
+
+	Measure ("DIV64LUT (WAVE_LUT_OPT)", [&] (u32 round) {
+		return SumReal32Lut (codes, BENCH_SAMPLES, round);
+	});
+
+	printf ("Accent gain from dB, per gain:\n");
+
+	Measure ("powf", [&] (u32 round) {
+		r32 sum = 0;
+		for (u32 i = 0; i < BENCH_SAMPLES; ++i) sum += powf (10.0f, -(r32)((decibels[i] + round) % 61) / 20.0f);
+		return (r64)sum;
+	});
+
+	Measure ("DBGAIN table", [&] (u32 round) {
+		r32 sum = 0;
+		for (u32 i = 0; i < BENCH_SAMPLES; ++i) sum += DBGAIN[(decibels[i] + round) % 61];
+		return (r64)sum;
+	});
+
+	return TESTS::Result ();
+}
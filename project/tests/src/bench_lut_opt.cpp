@@ -0,0 +1,46 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#include <blue/sal.hpp>
+//
+#include <stdint.h>
+#include <wchar.h>
+#include <array>
+#include <ctype.h>
+
+
+//  ABOUT
+// 'bench_lut's second translation unit, built with 'WAVE_LUT_OPT' defined. Bluelib is header
+//  only and defines functions that aren't inline, so 'blue/wave.hpp' with the bluelib headers
+//  it includes goes into a namespace of its own here - the standard and SAL headers are in
+//  beforehand. This 'w8' doesn't collide with the default one the other unit builds.
+//
+
+#ifndef WAVE_LUT_OPT
+	#error "'bench_lut_opt.cpp' is built with 'WAVE_LUT_OPT' defined."
+#endif
+
+namespace WAVE_LUT {
+	#include <blue/wave.hpp>
+}
+
+using WAVE_LUT::u8, WAVE_LUT::u32, WAVE_LUT::r32, WAVE_LUT::r64;
+
+
+r32 GetReal32Lut (
+	IN		const u8& 		value
+) {
+	return WAVE_LUT::w8 (value).real32 ();
+}
+
+
+// Whole loop here, a call per sample across units would be measured instead.
+r64 SumReal32Lut (
+	IN		const u8* const& 	codes,
+	IN		const u32& 			count,
+	IN		const u32& 			round
+) {
+	r32 sum = 0;
+	for (u32 i = 0; i < count; ++i) sum += WAVE_LUT::w8 ((u8)(codes[i] + round)).real32 ();
+	return (r64)sum;
+}
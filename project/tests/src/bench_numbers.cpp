@@ -0,0 +1,199 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <blue/error.hpp>
+//
+#include <string>
+#include <vector>
+#include <mstd/strtonum.hpp>
+#include <mstd/isstrnum.hpp>
+//
+#include "strtonum_scalar.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// 'mstd' number parsing 8 digits at a time against the digit by digit loops it replaced
+//  ('mstd::scalar'). Millions of numbers per second (of the fastest round), 'BENCH_NUMBERS'
+//  numbers of each kind:
+//  - s64 - 'strtonum' on 1 to 19 digits with a sign,
+//  - u64 - 'strtounum' on 1 to 21 digits, some past 'UINT64_MAX',
+//  - r64 - 'strtofp' on '%.6f' values,
+//  - is - 'isstrnum', 'isstrunum' and 'isstrfp' on the same strings.
+//  Both have to accept and reject the same strings and read the same integers. Floats have
+//  to match 'strtod' - the scalar loop isn't correctly rounded, so it's only timed.
+//
+//  USAGE: bench_numbers [numbers]
+//
+
+#define BENCH_NUMBERS 		1000000
+#define BENCH_ROUNDS 		10 		// The fastest is reported.
+
+
+struct NUMBERS {
+	std::vector<std::string> s64s;
+	std::vector<std::string> u64s;
+	std::vector<std::string> r64s;
+};
+
+
+// Deterministic, so every run parses the same strings.
+u64 Random (
+	INOUT	u64& 				state
+) {
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+
+void Generate (
+	IN		const u32& 			count,
+	OUT		NUMBERS& 			numbers
+) {
+	u64 state = 0x9E3779B97F4A7C15;
+	c8 buffer [32];
+
+	for (u32 i = 0; i < count; ++i) {
+		const u32 digits = 1 + Random (state) % 21;
+
+		for (u32 digit = 0; digit < digits; ++digit) buffer[digit] = '0' + Random (state) % 10;
+		buffer[digits] = '\0';
+		numbers.u64s.emplace_back (buffer);
+
+		const c8* const sign = (i % 3 == 0) ? "-" : (i % 3 == 1) ? "+" : "";
+		numbers.s64s.emplace_back (std::string (sign) + std::string (buffer, digits > 19 ? 19 : digits));
+
+		snprintf (buffer, sizeof (buffer), "%.6f", (r64)(Random (state) % 100000000) / 997.0);
+		numbers.r64s.emplace_back (buffer);
+	}
+}
+
+
+// Millions of numbers per second, of the fastest round. 'parse' returns how many were accepted.
+template <class PARSE>
+r64 Measure (
+	IN		const std::vector<std::string>& 	strings,
+	IN		const PARSE& 						parse
+) {
+	u64 fastest = UINT64_MAX;
+
+	for (u32 round = 0; round < BENCH_ROUNDS; ++round) {
+		const u64 start = TESTS::Now ();
+		TESTS::Keep ((r64)parse (strings));
+
+		const u64 elapsed = TESTS::Now () - start;
+		if (elapsed < fastest) fastest = elapsed;
+	}
+
+	return (r64)strings.size () * 1000.0 / (r64)fastest;
+}
+
+
+template <class T, bool (*PARSE) (const std::string&, T&)>
+u32 ParseAll (const std::vector<std::string>& strings) {
+	u32 accepted = 0;
+	r64 sum = 0;
+	T number = 0;
+
+	for (const std::string& string : strings) {
+		accepted += PARSE (string, number);
+		sum += (r64)number;
+	}
+
+	TESTS::Keep (sum);
+	return accepted;
+}
+
+
+template <bool (*IS) (const std::string&)>
+u32 CheckAll (const std::vector<std::string>& strings) {
+	u32 accepted = 0;
+	for (const std::string& string : strings) accepted += IS (string);
+	return accepted;
+}
+
+
+template <class T, bool (*SCALAR) (const std::string&, T&), bool (*CURRENT) (const std::string&, T&)>
+void CompareIntegers (
+	IN		const c8* const& 					name,
+	IN		const std::vector<std::string>& 	strings
+) {
+	const r64 scalar = Measure (strings, ParseAll<T, SCALAR>);
+	const r64 current = Measure (strings, ParseAll<T, CURRENT>);
+
+	printf ("%-10s %14.1f %14.1f\n", name, scalar, current);
+
+	for (const std::string& string : strings) {
+		T scalarNumber = 0, currentNumber = 0;
+
+		const bool isScalar = SCALAR (string, scalarNumber);
+		const bool isCurrent = CURRENT (string, currentNumber);
+
+		if (isScalar == isCurrent && (!isScalar || scalarNumber == currentNumber)) continue;
+		CHECK (false, "%s: '%s' read differently", name, string.c_str ());
+		break;
+	}
+}
+
+
+template <bool (*SCALAR) (const std::string&), bool (*CURRENT) (const std::string&)>
+void CompareChecks (
+	IN		const c8* const& 					name,
+	IN		const std::vector<std::string>& 	strings
+) {
+	const r64 scalar = Measure (strings, CheckAll<SCALAR>);
+	const r64 current = Measure (strings, CheckAll<CURRENT>);
+
+	printf ("%-10s %14.1f %14.1f\n", name, scalar, current);
+
+	for (const std::string& string : strings) {
+		if (SCALAR (string) == CURRENT (string)) continue;
+		CHECK (false, "%s: '%s' checked differently", name, string.c_str ());
+		break;
+	}
+}
+
+
+s32 main (s32 argumentsCount, c8** arguments) {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	const u32 count = argumentsCount > 1 ? atoi (arguments[1]) : BENCH_NUMBERS;
+	if (count == 0) ERROR ("At least 1 number.\n");
+
+	NUMBERS numbers;
+	Generate (count, numbers);
+
+	printf ("%-10s %14s %14s\n", "numbers", "scalar M/s", "swar M/s");
+
+	CompareIntegers<s64, mstd::scalar::strtonum<s64>, mstd::strtonum<s64>> ("s64", numbers.s64s);
+	CompareIntegers<u64, mstd::scalar::strtounum<u64>, mstd::strtounum<u64>> ("u64", numbers.u64s);
+
+	{
+		const r64 scalar = Measure (numbers.r64s, ParseAll<r64, mstd::scalar::strtofp<r64>>);
+		const r64 current = Measure (numbers.r64s, ParseAll<r64, mstd::strtofp<r64>>);
+
+		printf ("%-10s %14.1f %14.1f\n", "r64", scalar, current);
+
+		for (const std::string& string : numbers.r64s) {
+			r64 number = 0;
+			const bool isRead = mstd::strtofp (string, number);
+			if (isRead && number == strtod (string.c_str (), nullptr)) continue;
+			CHECK (false, "r64: '%s' read as %.17g", string.c_str (), number);
+			break;
+		}
+	}
+
+	CompareChecks<mstd::scalar::isstrnum, mstd::isstrnum> ("is s64", numbers.s64s);
+	CompareChecks<mstd::scalar::isstrunum, mstd::isstrunum> ("is u64", numbers.u64s);
+	CompareChecks<mstd::scalar::isstrfp, mstd::isstrfp> ("is r64", numbers.r64s);
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
@@ -0,0 +1,82 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include "onset.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// 'ONSET::Feed' throughput on a generated 48 kHz signal - quiet noise with a click every
+//  beat at 120 bpm - fed in 'METRONOME_ONSET_CHUNK' pieces, as the detector thread takes
+//  them. Millions of samples per second (of the fastest round) and how many times that is
+//  the capture rate. One core has to keep up with 'METRONOME_ONSET_RATE', otherwise the
+//  capture buffer fills faster than it's emptied.
+//
+//  USAGE: bench_onset [seconds]
+//
+
+#define BENCH_SECONDS 		60 		// Of signal.
+#define BENCH_ROUNDS 		10 		// The fastest is reported.
+#define BENCH_SPB 			24000 	// samples, 120 bpm at 48 kHz
+
+
+s32 main (s32 argumentsCount, c8** arguments) {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	const u32 seconds = argumentsCount > 1 ? atoi (arguments[1]) : BENCH_SECONDS;
+	if (seconds == 0) ERROR ("At least 1 second.\n");
+
+	const u64 count = (u64)seconds * METRONOME_ONSET_RATE;
+	s16* const signal = (s16*) malloc (count * sizeof (s16));
+
+	u32 noise = 0x1234567;
+	for (u64 i = 0; i < count; ++i) {
+		noise = noise * 1664525 + 1013904223; // LCG
+		r64 value = (r64)((s32)(noise >> 16) % 201 - 100);
+
+		const r64 t = (r64)(i % BENCH_SPB) / METRONOME_ONSET_RATE;
+		if (t < 0.02) value += 12000.0 * sin (2 * M_PI * 1500 * t) * exp (-t / 0.004);
+
+		signal[i] = (s16)value;
+	}
+
+	u64 onsets [METRONOME_ONSET_FOUND];
+	u64 fastest = UINT64_MAX;
+	u64 found = 0;
+
+	for (u32 round = 0; round < BENCH_ROUNDS; ++round) {
+		ONSET::DETECTOR detector;
+		ONSET::Create (detector, METRONOME_ONSET_RATE);
+		found = 0;
+
+		const u64 start = TESTS::Now ();
+
+		for (u64 fed = 0; fed < count; fed += METRONOME_ONSET_CHUNK) {
+			const u32 chunk = count - fed < METRONOME_ONSET_CHUNK ? (u32)(count - fed) : METRONOME_ONSET_CHUNK;
+			found += ONSET::Feed (detector, signal + fed, chunk, onsets, METRONOME_ONSET_FOUND);
+		}
+
+		const u64 elapsed = TESTS::Now () - start;
+		if (elapsed < fastest) fastest = elapsed;
+
+		TESTS::Keep ((r64)found);
+	}
+
+	free (signal);
+
+	const r64 rate = (r64)count * 1000000000.0 / (r64)fastest;
+	printf ("%-12s %14s %14s %10s\n", "samples", "Msamples/s", "realtime", "onsets");
+	printf ("%-12llu %14.1f %13.0fx %10llu\n", (unsigned long long)count, rate / 1000000.0, rate / METRONOME_ONSET_RATE, (unsigned long long)found);
+
+	const u64 beats = (count + BENCH_SPB - 1) / BENCH_SPB;
+	CHECK (found == beats, "%llu onsets found for %llu clicks", (unsigned long long)found, (unsigned long long)beats);
+	CHECK (rate >= METRONOME_ONSET_RATE, "%.0f samples/s, doesn't keep up with %u Hz", rate, METRONOME_ONSET_RATE);
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
@@ -0,0 +1,128 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <blue/error.hpp>
+//
+#include <string>
+#include <vector>
+#include <mstd/ordered_map.hpp>
+//
+#include "ordered_map_upstream.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// 'mstd::ordered_map' (dense vector, open-addressing index) against the upstream one it
+//  replaced ('mstd::upstream::ordered_map', a vector and an 'unordered_map' of indexes) at
+//  10, 1k and 100k string keys. Nanoseconds per operation:
+//  - append - 'operator[]' of a new key, as 'args_map' is built,
+//  - find - every key,
+//  - iterate - every element, in order,
+//  - erase - 'BENCH_CAPPED' keys (at most half) spread over the map,
+//  - insert front - 'BENCH_CAPPED' new keys (at most half) at 'begin ()'.
+//  Upstream rewrites every index after the position on erase and insert, so those two are
+//  capped for both. Small maps are built 'BENCH_ELEMENTS' / entries times. Both have to
+//  end up with the same elements in the same order.
+//
+//  USAGE: bench_ordered_map
+//
+
+#define BENCH_ELEMENTS 		100000 	// Per measurement, at least.
+#define BENCH_CAPPED 		1000
+
+
+enum OPERATION: u8 {
+	OPERATION_APPEND,
+	OPERATION_FIND,
+	OPERATION_ITERATE,
+	OPERATION_ERASE,
+	OPERATION_FRONT,
+	OPERATION_COUNT,
+};
+
+const c8* const OPERATIONS [] { "append", "find", "iterate", "erase", "insert front" };
+
+
+struct RESULT {
+	r64 ns [OPERATION_COUNT];
+	std::vector<std::pair<std::string, u32>> elements; 	// Of the last round.
+};
+
+
+template <class MAP>
+void Measure (
+	IN		const std::vector<std::string>& 	keys,
+	IN		const u32& 							entries,
+	OUT		RESULT& 							result
+) {
+	const u32 rounds = entries < BENCH_ELEMENTS ? BENCH_ELEMENTS / entries : 1;
+	const u32 capped = entries / 2 < BENCH_CAPPED ? entries / 2 : BENCH_CAPPED;
+	const u32 step = capped ? entries / capped : 1;
+
+	u64 elapsed [OPERATION_COUNT] {};
+
+	for (u32 round = 0; round < rounds; ++round) {
+		MAP map;
+
+		u64 start = TESTS::Now ();
+		for (u32 i = 0; i < entries; ++i) map[keys[i]] = i;
+		elapsed[OPERATION_APPEND] += TESTS::Now () - start;
+
+		start = TESTS::Now ();
+		u64 found = 0;
+		for (u32 i = 0; i < entries; ++i) found += map.find (keys[i]) != map.end ();
+		elapsed[OPERATION_FIND] += TESTS::Now () - start;
+		TESTS::Keep ((r64)found);
+
+		start = TESTS::Now ();
+		u64 sum = 0;
+		for (const auto& element : map) sum += element.second;
+		elapsed[OPERATION_ITERATE] += TESTS::Now () - start;
+		TESTS::Keep ((r64)sum);
+
+		start = TESTS::Now ();
+		for (u32 i = 0; i < capped; ++i) map.erase (keys[i * step]);
+		elapsed[OPERATION_ERASE] += TESTS::Now () - start;
+
+		start = TESTS::Now ();
+		for (u32 i = 0; i < capped; ++i) map.insert (map.cbegin (), { keys[entries + i], i });
+		elapsed[OPERATION_FRONT] += TESTS::Now () - start;
+
+		if (round + 1 == rounds) result.elements.assign (map.begin (), map.end ());
+	}
+
+	const r64 counts [OPERATION_COUNT] { (r64)entries, (r64)entries, (r64)entries, (r64)capped, (r64)capped };
+	for (u8 i = 0; i < OPERATION_COUNT; ++i) result.ns[i] = counts[i] ? elapsed[i] / (counts[i] * rounds) : 0;
+}
+
+
+s32 main () {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	const u32 sizes [] { 10, 1000, 100000 };
+
+	std::vector<std::string> keys;
+	for (u32 i = 0; i < 100000 + BENCH_CAPPED; ++i) keys.push_back ("argument-" + std::to_string (i));
+
+	printf ("%8s %-14s %14s %14s\n", "entries", "operation", "upstream ns", "dense ns");
+
+	for (const u32& entries : sizes) {
+		RESULT upstream, dense;
+		Measure<mstd::upstream::ordered_map<std::string, u32>> (keys, entries, upstream);
+		Measure<mstd::ordered_map<std::string, u32>> (keys, entries, dense);
+
+		for (u8 i = 0; i < OPERATION_COUNT; ++i) {
+			printf ("%8u %-14s %14.1f %14.1f\n", entries, OPERATIONS[i], upstream.ns[i], dense.ns[i]);
+		}
+
+		CHECK (upstream.elements == dense.elements, "%u entries: the maps differ", entries);
+	}
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
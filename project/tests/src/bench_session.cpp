@@ -0,0 +1,116 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <algorithm>
+//
+#include "session.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// Loads a generated 10k-section session ('--json') the way the player does - mapped,
+//  parsed into 'SCHEDULE::plan' and unmapped - and reports the fastest and the median
+//  load. The target is under a millisecond. The parse alone (on the mapped file) and
+//  a plain byte sum over the same bytes are measured too, as this machine's baseline.
+//
+//  USAGE: bench_session [sections]
+//
+
+#define BENCH_FILENAME 		"bench_session.json"
+#define BENCH_SECTIONS 		10000
+#define BENCH_ROUNDS 		200
+#define BENCH_TARGET 		1000000 	// ns
+
+
+// Returns the file's size.
+u32 Generate (
+	IN		const c8* const& 	filename,
+	IN		const u32& 			sections
+) {
+	FILE* file = fopen (filename, "wb");
+	if (file == nullptr) ERROR ("Couldn't create '%s'.\n", filename);
+
+	u32 size = fprintf (file, "{\n\t\"name\": \"Generated practice plan\",\n\t\"sounds\": [ \"synth-sine\", \"synth-square\", \"synth-noise\" ],\n\t\"sections\": [\n");
+
+	for (u32 i = 0; i < sections; ++i) {
+		size += fprintf (
+			file, "\t\t{ \"bpm\": %u, \"pattern\": %u, \"bars\": %u, \"volume\": %u, \"sound\": %u }%s\n",
+			60 + i % 181, 2 + i % 6, 1 + i % 16, 40 + i % 61, i % 3, i + 1 == sections ? "" : ","
+		);
+	}
+
+	size += fprintf (file, "\t]\n}\n");
+	fclose (file);
+
+	return size;
+}
+
+
+void Report (
+	IN		const c8* const& 	name,
+	INOUT	u64* const& 		times
+) {
+	std::sort (times, times + BENCH_ROUNDS);
+	printf ("  %-18s min %7.3f ms, median %7.3f ms\n", name, times[0] / 1e6, times[BENCH_ROUNDS / 2] / 1e6);
+}
+
+
+s32 main (s32 argumentsCount, c8** arguments) {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	const u32 sections = argumentsCount > 1 ? atoi (arguments[1]) : BENCH_SECTIONS;
+	if (sections == 0 || sections > METRONOME_SCHEDULE_SECTIONS) ERROR ("1-%u sections.\n", METRONOME_SCHEDULE_SECTIONS);
+
+	const ARGUMENTS::MAINARGS mainArgs = ARGUMENTS::Defaults ();
+	const u32 size = Generate (BENCH_FILENAME, sections);
+
+	static u64 loads [BENCH_ROUNDS], parses [BENCH_ROUNDS], sums [BENCH_ROUNDS];
+
+	for (u32 round = 0; round < BENCH_ROUNDS; ++round) {
+		const u64 start = TESTS::Now ();
+		SESSION::Load (BENCH_FILENAME, mainArgs, SCHEDULE::plan);
+		loads[round] = TESTS::Now () - start;
+	}
+
+	CHECK (SCHEDULE::plan.sectionsCount == sections, "%u sections loaded, %u expected", SCHEDULE::plan.sectionsCount, sections);
+	CHECK (SCHEDULE::plan.bpm[sections - 1] == 60 + (sections - 1) % 181, "last section's bpm is %u", SCHEDULE::plan.bpm[sections - 1]);
+	CHECK (SCHEDULE::plan.volume[sections - 1] == 40 + (sections - 1) % 61, "last section's volume is %u", SCHEDULE::plan.volume[sections - 1]);
+
+	IO::MAPPING mapping;
+	IO::Map (BENCH_FILENAME, mapping);
+
+	for (u32 round = 0; round < BENCH_ROUNDS; ++round) {
+		SESSION::PARSER parser { mapping.data, mapping.data, mapping.data + mapping.size, BENCH_FILENAME, nullptr };
+		SCHEDULE::FromArguments (SCHEDULE::plan, mainArgs);
+
+		const u64 start = TESTS::Now ();
+		SESSION::Parse (parser, SCHEDULE::plan);
+		parses[round] = TESTS::Now () - start;
+	}
+
+	for (u32 round = 0; round < BENCH_ROUNDS; ++round) {
+		const u64 start = TESTS::Now ();
+		u64 sum = 0;
+		for (u32 i = 0; i < mapping.size; ++i) sum += (u8)mapping.data[i];
+		sums[round] = TESTS::Now () - start;
+		TESTS::Keep ((r64)sum);
+	}
+
+	IO::Unmap (mapping);
+	remove (BENCH_FILENAME);
+
+	printf ("%u sections, %u bytes:\n", sections, size);
+	Report ("load", loads);
+	Report ("parse", parses);
+	Report ("byte sum", sums);
+
+	if (loads[BENCH_ROUNDS / 2] > BENCH_TARGET) printf ("Median load is over the %.1f ms target.\n", BENCH_TARGET / 1e6);
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
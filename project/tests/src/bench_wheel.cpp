@@ -0,0 +1,141 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <algorithm>
+#include <threads.h>
+//
+#include "daemon.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// The daemon's timer wheel ('TIMER::WHEEL') from 1 to 100k click streams, each with its own
+//  tempo (40-440 BPM) and phase. Every due stream is inserted again a beat later, as
+//  'DAEMON::Beat' does.
+//  - Throughput - time only simulated, jumping to 'GetNext'. Beats per second of CPU time.
+//  - Wakeup accuracy - in real time with the daemon's wait ('METRONOME_DAEMON_SPIN' before
+//    the next deadline, sleeping until then). How late beats are taken from the wheel.
+//
+//  USAGE: bench_wheel [streams max]
+//
+
+#define BENCH_STREAMS 		100000
+#define BENCH_EVENTS 		2000000 		// Simulated beats per count, at least.
+#define BENCH_SIMULATED 	60000000000ull 	// ns, simulated at most.
+#define BENCH_REAL 			1000000000ull 	// ns, per count.
+#define BENCH_SAMPLES 		(1 << 21)
+
+
+TIMER::WHEEL<BENCH_STREAMS> wheel;
+u64 spbNs [BENCH_STREAMS];
+s64 late [BENCH_SAMPLES];
+u32 noise = 0x1234567;
+
+
+u32 GetRandom () {
+	noise = noise * 1664525 + 1013904223; // LCG
+	return noise >> 8;
+}
+
+
+void Create (
+	IN		const u32& 		streams,
+	IN		const u64& 		now
+) {
+	wheel.Create (now);
+
+	for (u32 i = 0; i < streams; ++i) {
+		spbNs[i] = 60000000000ull / (40 + GetRandom () % 401);
+		wheel.Insert (i, now + GetRandom () % spbNs[i] + 1);
+	}
+}
+
+
+// Beats per second of CPU time.
+r64 MeasureThroughput (
+	IN		const u32& 		streams
+) {
+	u64 simulated = BENCH_EVENTS / streams * 1000000000ull / 4; // ~4 beats per second a stream.
+	if (simulated > BENCH_SIMULATED) simulated = BENCH_SIMULATED;
+
+	const u64 begin = 1000000000ull;
+	u64 events = 0;
+
+	Create (streams, begin);
+
+	const u64 start = TESTS::Now ();
+
+	for (u64 now = begin; now < begin + simulated; now = wheel.GetNext ()) {
+		wheel.Expire (now, [&] (const u32& id) {
+			wheel.Insert (id, now + spbNs[id]);
+			++events;
+		});
+	}
+
+	return events / ((TESTS::Now () - start) / 1e9);
+}
+
+
+// Lateness samples, sorted. Returns their count.
+u32 MeasureWakeups (
+	IN		const u32& 		streams
+) {
+	const u64 begin = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+	u32 count = 0;
+
+	Create (streams, begin);
+
+	for (u64 now = begin; now < begin + BENCH_REAL; now = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ())) {
+		wheel.Expire (now, [&] (const u32& id) {
+			if (count < BENCH_SAMPLES) late[count++] = (s64)(now - wheel.timers[id].deadline);
+			wheel.Insert (id, wheel.timers[id].deadline + spbNs[id]);
+		});
+
+		const u64 heard = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+		const u64 next = wheel.GetNext ();
+
+		u64 wait = next <= heard + METRONOME_DAEMON_SPIN ? 0 : next - heard - METRONOME_DAEMON_SPIN;
+		if (wait > METRONOME_DAEMON_POLL) wait = METRONOME_DAEMON_POLL;
+
+		if (wait) {
+			const timespec duration { 0, (s64)wait };
+			thrd_sleep (&duration, nullptr);
+		}
+	}
+
+	std::sort (late, late + count);
+	return count;
+}
+
+
+s32 main (s32 argumentsCount, c8** arguments) {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	const u32 streamsMax = argumentsCount > 1 ? atoi (arguments[1]) : BENCH_STREAMS;
+	if (streamsMax == 0 || streamsMax > BENCH_STREAMS) ERROR ("1-%u streams.\n", BENCH_STREAMS);
+
+	printf ("%8s %16s %10s %10s %10s %10s\n", "streams", "beats/s (CPU)", "beats", "median ms", "99th ms", "max ms");
+
+	for (u32 streams = 1; streams <= streamsMax; streams *= 10) {
+		const r64 throughput = MeasureThroughput (streams);
+		const u32 count = MeasureWakeups (streams);
+
+		CHECK (count != 0, "no beats with %u streams", streams);
+		if (count == 0) continue;
+
+		printf (
+			"%8u %16.0f %10u %10.3f %10.3f %10.3f\n", streams, throughput, count,
+			late[count / 2] / 1e6, late[count * 99 / 100] / 1e6, late[count - 1] / 1e6
+		);
+
+		CHECK (late[0] >= 0, "a beat was taken before it was due");
+	}
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
@@ -0,0 +1,171 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <atomic>
+#include <new>
+#include <threads.h>
+//
+#include "global.hpp"
+#include "compiled.hpp"
+#include "bank.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// Nothing the player or a command producer does after playback started may reach the heap.
+//  The heap is hooked - 'malloc' and friends with glibc, the debug CRT's allocation hook and
+//  'operator new' on Windows (release builds there only see 'new'). Only the playback thread
+//  and the thread pushing commands are counted, OpenAL's own threads are not.
+//
+//  The schedule plays at the highest tempo while tempo, pattern, volume, stop and start
+//  commands are pushed. A heap call made on purpose first shows the hook is counting.
+//
+
+#define TEST_COMMAND_INTERVAL 	100 	// ms
+#define TEST_COMMANDS 			12
+
+
+namespace HEAP {
+
+	std::atomic<u64> calls = 0;
+	thread_local bool isCounted = false;
+
+	void Count () {
+		if (isCounted) calls.fetch_add (1, std::memory_order_relaxed);
+	}
+
+}
+
+
+#ifdef _WIN32
+
+	#include <crtdbg.h>
+
+	#ifdef _DEBUG
+		s32 __cdecl AllocationHook (s32 type, void*, size_t, s32, long, const unsigned char*, s32) {
+			if (type != _HOOK_FREE) HEAP::Count ();
+			return TRUE;
+		}
+	#endif
+
+	void* operator new (size_t size) {
+		HEAP::Count ();
+		void* const address = malloc (size ? size : 1);
+		if (address == nullptr) throw std::bad_alloc ();
+		return address;
+	}
+
+	void operator delete (void* address) noexcept { free (address); }
+	void operator delete (void* address, size_t) noexcept { free (address); }
+
+#elif defined (__GLIBC__)
+
+	extern "C" {
+
+		void* __libc_malloc (size_t);
+		void* __libc_calloc (size_t, size_t);
+		void* __libc_realloc (void*, size_t);
+		void* __libc_memalign (size_t, size_t);
+
+		void* malloc (size_t size) 							{ HEAP::Count (); return __libc_malloc (size); }
+		void* calloc (size_t count, size_t size) 			{ HEAP::Count (); return __libc_calloc (count, size); }
+		void* realloc (void* address, size_t size) 			{ HEAP::Count (); return __libc_realloc (address, size); }
+		void* aligned_alloc (size_t alignment, size_t size) { HEAP::Count (); return __libc_memalign (alignment, size); }
+
+	}
+
+#endif
+
+
+BANK::SLOT& slot = BANK::slots[0];
+
+
+s32 Play (
+	INOUT	void* anyargs
+) {
+
+	DEBUG (DEBUG_FLAG_LOGGING) {
+		if (anyargs != nullptr) LOGWARN ("Arguments passed to 'Play'!");
+	}
+
+	HEAP::isCounted = true;
+	GLOBAL::PlaySchedule (&slot);
+	HEAP::isCounted = false;
+
+	return 0;
+}
+
+
+s32 main () {
+	using ARGUMENTS::MAINARGS;
+	constexpr const auto& BPM = ARGUMENTS::OPTION::Find<&MAINARGS::bpm> ();
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	#if defined (_WIN32) && defined (_DEBUG)
+		_CrtSetAllocHook (AllocationHook);
+	#endif
+
+	#if !defined (_WIN32) && !defined (__GLIBC__)
+		printf ("The heap isn't hooked on this platform. Skipped.\n");
+		return 0;
+	#endif
+
+	ARGUMENTS::MAINARGS mainArgs = ARGUMENTS::Defaults ();
+	mainArgs.bpm = BPM.max;
+
+	ALCdevice* device;
+	ALCcontext* context;
+	COMPILED::LOADED loaded {};
+
+	SCHEDULE::FromArguments (SCHEDULE::plan, mainArgs);
+	slot.plan = &SCHEDULE::plan;
+
+	AUDIO::LISTENER::Create (device, context);
+	BANK::Create (slot.sounds, *slot.plan, loaded);
+	BANK::playing = &slot;
+
+	{ // The hook counts.
+		HEAP::isCounted = true;
+		void* const address = ::operator new (16);
+		HEAP::isCounted = false;
+		::operator delete (address);
+
+		CHECK (HEAP::calls.load () != 0, "a heap call wasn't counted");
+		HEAP::calls = 0;
+	}
+
+	thrd_t player;
+	thrd_create (&player, Play, nullptr);
+
+	const timespec interval { 0, TEST_COMMAND_INTERVAL * 1000000l };
+	const c8 codes [] { METRONOME_COMMAND_BPM, METRONOME_COMMAND_PATTERN, METRONOME_COMMAND_VOLUME, METRONOME_COMMAND_STOP, METRONOME_COMMAND_START, METRONOME_COMMAND_BPM };
+	const u16 values [] { (u16)(BPM.max - 20), 3, 50, 0, 0, BPM.max };
+
+	HEAP::isCounted = true;
+
+	for (u32 i = 0; i < TEST_COMMANDS; ++i) {
+		thrd_sleep (&interval, nullptr);
+		GLOBAL::PushCommand (codes[i % sizeof (codes)], values[i % sizeof (codes)]);
+	}
+
+	thrd_sleep (&interval, nullptr);
+	HEAP::isCounted = false;
+
+	GLOBAL::isStopPlayback = false;
+	thrd_join (player, nullptr);
+
+	printf ("Heap calls after playback started: %llu\n", (unsigned long long)HEAP::calls.load ());
+	CHECK (HEAP::calls.load () == 0, "playback or a command producer called the heap");
+	CHECK (GLOBAL::commandsDropped.load () == 0, "commands were dropped");
+
+	BANK::Destroy (slot.sounds);
+	AUDIO::LISTENER::Destroy (device, context);
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
@@ -0,0 +1,70 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include "arguments.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// 'ARGUMENTS::Get' on numbers out of their option's range. Each is clamped to the range (with
+//  a warning) instead of being rejected, however many digits it has - past 'UINT16_MAX' and
+//  past the width of any integer, or with hundreds of leading zeros. Values at the edges of
+//  a range are kept. Every accepted form is used ('--name value', '--name=value',
+//  '-n value', '-nvalue').
+//
+//  USAGE: test_arguments
+//
+
+#define TEST_ZEROS 			300 	// Leading, more than a u8 index could count.
+
+
+struct CASE {
+	const c8* name;
+	s32 count;
+	const c8* arguments [3];
+	u32 (*read) (const ARGUMENTS::MAINARGS&);
+	u32 expected;
+};
+
+
+c8 zeros [TEST_ZEROS + 4];
+
+
+const CASE cases [] {
+	{ "over u16", 			3, { "metronome", "--bpm", "70000" }, 					[] (const ARGUMENTS::MAINARGS& a) -> u32 { return a.bpm; }, 		440 },
+	{ "over u64", 			2, { "metronome", "--bpm=4294967296000000000000" }, 	[] (const ARGUMENTS::MAINARGS& a) -> u32 { return a.bpm; }, 		440 },
+	{ "leading zeros", 		3, { "metronome", "-b", zeros }, 						[] (const ARGUMENTS::MAINARGS& a) -> u32 { return a.bpm; }, 		200 },
+	{ "under min", 			2, { "metronome", "-b39" }, 							[] (const ARGUMENTS::MAINARGS& a) -> u32 { return a.bpm; }, 		40 	},
+	{ "zero volume", 		3, { "metronome", "--volume", "0" }, 					[] (const ARGUMENTS::MAINARGS& a) -> u32 { return a.volume; }, 		1 	},
+	{ "over u8 field", 		3, { "metronome", "-p", "300" }, 						[] (const ARGUMENTS::MAINARGS& a) -> u32 { return a.pattern; }, 	16 	},
+	{ "max wait", 			2, { "metronome", "--wait=10" }, 						[] (const ARGUMENTS::MAINARGS& a) -> u32 { return a.wait; }, 		10 	},
+	{ "max port", 			3, { "metronome", "--osc", "65535" }, 					[] (const ARGUMENTS::MAINARGS& a) -> u32 { return a.osc; }, 		65535 },
+	{ "port + 1", 			3, { "metronome", "--osc", "65536" }, 					[] (const ARGUMENTS::MAINARGS& a) -> u32 { return a.osc; }, 		65535 },
+	{ "over latency", 		2, { "metronome", "-a1001" }, 							[] (const ARGUMENTS::MAINARGS& a) -> u32 { return a.latency; }, 	1000 },
+};
+
+
+s32 main () {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	memset (zeros, '0', TEST_ZEROS);
+	memcpy (zeros + TEST_ZEROS, "200", 4);
+
+	for (const CASE& test : cases) {
+		ARGUMENTS::MAINARGS args = ARGUMENTS::Defaults ();
+		ARGUMENTS::Get (test.count, (c8**)test.arguments, args);
+
+		const u32 value = test.read (args);
+		printf ("%-16s %u\n", test.name, value);
+
+		CHECK (value == test.expected, "%s: %u instead of %u", test.name, value, test.expected);
+	}
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
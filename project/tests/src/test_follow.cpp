@@ -0,0 +1,141 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include "follow.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// The MIDI clock follower ('FOLLOW') fed with generated clocks - no device and no waiting,
+//  'Feed' and 'GetBeat' only work on timestamps. Clocks arrive with uniform jitter.
+//  - How many clocks it takes to lock and how close the followed beat is then.
+//  - Lost clocks (a dropped run of them) mustn't move the beats - they still count.
+//  - Stop, a Song Position Pointer and Continue a while later, off the old beats. Nothing is
+//    played until the first clock after Continue, which is the pointer's - the beats follow
+//    the new timeline right away, without locking again.
+//
+//  USAGE: test_follow
+//
+
+#define TEST_BPM 			120
+#define TEST_JITTER 		1000000 	// ns, clocks arrive up to this much late or early.
+#define TEST_LOCK 			(8 * METRONOME_MIDI_PPQN) 	// Clocks allowed to lock, 8 beats.
+#define TEST_CLOCKS 		(32 * METRONOME_MIDI_PPQN)
+#define TEST_LOST 			5 			// Clocks dropped in a row.
+#define TEST_BEAT 			2000000 	// ns, allowed between a followed and a sent beat.
+#define TEST_POSITION 		81 			// 16ths, a Song Position Pointer off a beat.
+
+
+u32 noise = 0x1234567;
+
+// Uniform in -TEST_JITTER, TEST_JITTER.
+s64 GetJitter () {
+	noise = noise * 1664525 + 1013904223; // LCG
+	return (s64)(noise >> 8) % (2 * TEST_JITTER + 1) - TEST_JITTER;
+}
+
+
+// Distance from the followed beat after 'after' to the nearest beat sent.
+s64 GetBeatError (
+	IN		const FOLLOW::LOOP& 	loop,
+	IN		const u64& 				start,
+	IN		const u64& 				spbNs,
+	IN		const u64& 				after
+) {
+	u64 deadline, followedNs;
+	if (!FOLLOW::GetBeat (loop, after, deadline, followedNs)) return INT64_MAX;
+
+	const s64 since = (s64)(deadline - start);
+	const s64 nearest = (since + (s64)spbNs / 2) / (s64)spbNs * (s64)spbNs;
+	return since - nearest;
+}
+
+
+s32 main () {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	const u64 spbNs = 60000000000ull / TEST_BPM;
+	const u64 start = 1000000000ull; // Arbitrary, the loop only sees differences.
+
+	auto GetClock = [&] (const u32& index, const u64& from) {
+		return from + index * spbNs / METRONOME_MIDI_PPQN + GetJitter ();
+	};
+
+	{ // Locking.
+		FOLLOW::LOOP loop {};
+		u32 lockedAt = 0;
+
+		for (u32 i = 0; i < TEST_CLOCKS; ++i) {
+			FOLLOW::Feed (loop, GetClock (i, start));
+			if (loop.isLocked && lockedAt == 0) lockedAt = i + 1;
+		}
+
+		const r64 followedNs = loop.period * METRONOME_MIDI_PPQN;
+		const s64 beatError = GetBeatError (loop, start, spbNs, loop.phase);
+
+		printf (
+			"Locked after %u clocks (%.2f beats), beat %.3f ms of %.3f ms, off the beat by %.3f ms\n",
+			lockedAt, (r64)lockedAt / METRONOME_MIDI_PPQN, followedNs / 1e6, spbNs / 1e6, beatError / 1e6
+		);
+
+		CHECK (lockedAt != 0 && lockedAt <= TEST_LOCK, "locking took %u clocks, %u allowed", lockedAt, TEST_LOCK);
+		CHECK (std::fabs (followedNs - (r64)spbNs) <= spbNs * 0.001, "followed beat is off by more than 0.1%%");
+		CHECK (std::llabs (beatError) <= TEST_BEAT, "followed beat is %.3f ms off", beatError / 1e6);
+	}
+
+	{ // Lost clocks.
+		FOLLOW::LOOP loop {};
+		u32 i = 0;
+
+		for (; i < TEST_CLOCKS / 2; ++i) FOLLOW::Feed (loop, GetClock (i, start));
+		i += TEST_LOST;
+		for (; i < TEST_CLOCKS; ++i) FOLLOW::Feed (loop, GetClock (i, start));
+
+		const s64 beatError = GetBeatError (loop, start, spbNs, loop.phase);
+
+		printf ("After %u lost clocks: %u counted of %u, off the beat by %.3f ms\n", TEST_LOST, loop.clocks, TEST_CLOCKS, beatError / 1e6);
+		CHECK (loop.clocks == TEST_CLOCKS, "lost clocks weren't counted, %u of %u", loop.clocks, TEST_CLOCKS);
+		CHECK (std::llabs (beatError) <= TEST_BEAT, "followed beat is %.3f ms off", beatError / 1e6);
+	}
+
+	{ // Stop and Continue.
+		FOLLOW::LOOP loop {};
+		for (u32 i = 0; i < TEST_CLOCKS; ++i) FOLLOW::Feed (loop, GetClock (i, start));
+
+		FOLLOW::Pause (loop);
+		const bool isStoppedPlayed = GetBeatError (loop, start, spbNs, loop.phase) != INT64_MAX;
+
+		FOLLOW::Position (loop, TEST_POSITION);
+		FOLLOW::Resume (loop);
+		const bool isContinuedPlayed = GetBeatError (loop, start, spbNs, loop.phase) != INT64_MAX;
+
+		// The song as if it was started here, a third of a beat off the old one.
+		const u64 restart = start + 100 * spbNs + spbNs / 3;
+		const u32 position = TEST_POSITION * METRONOME_MIDI_PPQN / 4;
+
+		FOLLOW::Feed (loop, GetClock (position, restart));
+		const s64 firstError = GetBeatError (loop, restart, spbNs, loop.phase);
+
+		for (u32 i = position + 1; i < position + TEST_CLOCKS / 2; ++i) FOLLOW::Feed (loop, GetClock (i, restart));
+		const s64 beatError = GetBeatError (loop, restart, spbNs, loop.phase);
+
+		printf (
+			"Continued at clock %u: off the beat by %.3f ms after its first clock, %.3f ms after %u\n",
+			position, firstError / 1e6, beatError / 1e6, TEST_CLOCKS / 2
+		);
+
+		CHECK (!isStoppedPlayed, "a beat was found after Stop");
+		CHECK (!isContinuedPlayed, "a beat was found after Continue, before its first clock");
+		CHECK (loop.isLocked && loop.clocks == position + TEST_CLOCKS / 2, "%u clocks counted, %u expected", loop.clocks, position + TEST_CLOCKS / 2);
+		CHECK (std::llabs (firstError) <= TEST_BEAT, "followed beat is %.3f ms off after the first clock", firstError / 1e6);
+		CHECK (std::llabs (beatError) <= TEST_BEAT, "followed beat is %.3f ms off", beatError / 1e6);
+	}
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
@@ -0,0 +1,162 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <algorithm>
+#include <threads.h>
+#ifndef _WIN32
+	#include <unistd.h>
+#endif
+//
+#include "global.hpp"
+#include "compiled.hpp"
+#include "bank.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// MIDI clock output looped back without a MIDI device. The schedule plays with clock output
+//  on, every clock is traced as due and as sent. How late clocks go out (the jitter a
+//  receiver sees) is checked, then the clocks, timed as sent, are fed to the follower's
+//  loop ('FOLLOW') - it has to lock onto the tempo played.
+//
+//  On windows 'midiOut' device 1 is used (the software synthesizer, it ignores clocks),
+//  without one the test is skipped. Elsewhere the output is a pipe instead of a raw MIDI
+//  device, read back after playback - every clock sent has to be in it.
+//
+//  95% of the clocks have to go out within 'TEST_JITTER', as in 'test_osc'. The 99th
+//  percentile is only printed - a few preempted sends on a busy (or single core) machine
+//  made it fail on its own.
+//
+//  USAGE: test_midi
+//
+
+#define TEST_BPM 				240
+#define TEST_DURATION 			3000 	// ms
+#define TEST_JITTER 			1000000 // ns, 95th percentile allowed
+#define TEST_TEMPO 				0.001 	// Relative error of the followed tempo allowed.
+
+
+BANK::SLOT& slot = BANK::slots[0];
+
+
+s32 Play (
+	INOUT	void* anyargs
+) {
+
+	DEBUG (DEBUG_FLAG_LOGGING) {
+		if (anyargs != nullptr) LOGWARN ("Arguments passed to 'Play'!");
+	}
+
+	GLOBAL::PlaySchedule (&slot);
+	return 0;
+}
+
+
+s32 main () {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	#ifdef _WIN32
+		if (midiOutGetNumDevs () == 0) {
+			printf ("No 'midiOut' device. Skipped.\n");
+			return 0;
+		}
+
+		MIDI::Open (1);
+	#else
+		s32 loopback [2];
+		if (pipe (loopback) != 0) ERROR ("Pipe could not be created.\n");
+
+		MIDI::output = fdopen (loopback[1], "wb");
+		setvbuf (MIDI::output, nullptr, _IONBF, 0);
+	#endif
+
+	ARGUMENTS::MAINARGS mainArgs = ARGUMENTS::Defaults ();
+	mainArgs.bpm = TEST_BPM;
+
+	ALCdevice* device;
+	ALCcontext* context;
+	COMPILED::LOADED loaded {};
+
+	SCHEDULE::FromArguments (SCHEDULE::plan, mainArgs);
+	slot.plan = &SCHEDULE::plan;
+
+	AUDIO::LISTENER::Create (device, context);
+	BANK::Create (slot.sounds, *slot.plan, loaded);
+	BANK::playing = &slot;
+
+	thrd_t player;
+	thrd_create (&player, Play, nullptr);
+
+	const timespec duration { TEST_DURATION / 1000, (TEST_DURATION % 1000) * 1000000l };
+	thrd_sleep (&duration, nullptr);
+
+	GLOBAL::isStopPlayback = false;
+	thrd_join (player, nullptr);
+	MIDI::Close ();
+
+	#ifndef _WIN32
+		u32 looped = 0;
+		u8 bytes [256];
+
+		for (ssize_t count; (count = read (loopback[0], bytes, sizeof (bytes))) > 0;) {
+			for (ssize_t i = 0; i < count; ++i) looped += bytes[i] == METRONOME_MIDI_CLOCK;
+		}
+
+		close (loopback[0]);
+		CHECK (looped == MIDI::clock, "%u clocks sent, %u written", MIDI::clock, looped);
+	#endif
+
+	// Clocks by index, from whichever thread traced them.
+	static u64 scheduled [TRACE_SIZE], sent [TRACE_SIZE];
+	static s64 late [TRACE_SIZE];
+	const u32 clocks = std::min<u32> (MIDI::clock, TRACE_SIZE);
+
+	for (u16 thread = 0; thread < std::min<u16> (TRACE::threadsCounter.load (), TRACE_THREADS); ++thread) {
+		for (u32 i = 0; i < TRACE::counts[thread]; ++i) {
+			const TRACE::EVENT& event = TRACE::events[thread][i];
+			if (event.value >= clocks) continue;
+			if (event.type == EVENTS::CLOCK_SCHEDULED) scheduled[event.value] = event.time;
+			if (event.type == EVENTS::CLOCK_SENT) sent[event.value] = event.time;
+		}
+	}
+
+	const u32 expected = TEST_DURATION * TEST_BPM / 60000 * METRONOME_MIDI_PPQN;
+	CHECK (clocks + 2 * METRONOME_MIDI_PPQN >= expected, "%u clocks sent, about %u expected", clocks, expected);
+
+	FOLLOW::LOOP loop {};
+
+	for (u32 i = 0; i < clocks; ++i) {
+		late[i] = (s64)(sent[i] - scheduled[i]);
+		FOLLOW::Feed (loop, sent[i]);
+	}
+
+	std::sort (late, late + clocks);
+
+	if (clocks) {
+		printf (
+			"%u clocks, sent late by: median %.3f ms, 95th %.3f ms, 99th %.3f ms, max %.3f ms\n", clocks,
+			late[clocks / 2] / 1e6, late[clocks * 95 / 100] / 1e6, late[clocks * 99 / 100] / 1e6, late[clocks - 1] / 1e6
+		);
+
+		CHECK (late[0] >= 0, "a clock was sent before it was due");
+		CHECK (late[clocks * 95 / 100] <= TEST_JITTER, "95th percentile over %.3f ms", TEST_JITTER / 1e6);
+	}
+
+	const r64 spbNs = 60e9 / TEST_BPM;
+	const r64 followed = loop.period * METRONOME_MIDI_PPQN;
+
+	printf ("Followed: %s, beat %.3f ms, played %.3f ms\n", loop.isLocked ? "locked" : "not locked", followed / 1e6, spbNs / 1e6);
+	CHECK (loop.isLocked, "the follower didn't lock");
+	CHECK (std::fabs (followed - spbNs) <= spbNs * TEST_TEMPO, "followed tempo is off");
+
+	BANK::Destroy (slot.sounds);
+	AUDIO::LISTENER::Destroy (device, context);
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
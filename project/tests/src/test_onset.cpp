@@ -0,0 +1,171 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include "onset.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// Grading ('ONSET') a generated '.wav' recording of hits played off the beats by known
+//  deviations - no capture device and no waiting. The file (stereo, hits on the first
+//  channel, quiet noise on both, a 'LIST' chunk of odd length before 'data') is opened with
+//  'ONSET::Open', then fed in capture-sized chunks through 'Feed' and every onset goes to
+//  'Grade' against a timeline starting at the first sample, the way 'Listen' does it.
+//  - Some beats have no hit, they have to be counted as missed.
+//  - Some beats have a second hit after them, it has to be counted as extra.
+//  - Every graded deviation has to be within 'TEST_ERROR' of the one played.
+//
+//  USAGE: test_onset
+//
+
+#define TEST_FILENAME 		"test_onset.wav"
+#define TEST_RATE 			48000
+#define TEST_CHANNELS 		2
+#define TEST_BPM 			120
+#define TEST_BEATS 			32
+#define TEST_MISSED 		11 		// Every 11th beat (from the 6th) has no hit.
+#define TEST_EXTRA 			7 		// Every 7th beat (from the 4th) is hit again,
+#define TEST_EXTRA_AFTER 	180 	//  ms after it.
+#define TEST_CLICK 			960 	// samples, 20 ms
+#define TEST_NOISE 			100 	// Amplitude, about 0.3% of the full scale.
+#define TEST_ERROR 			0.1 	// ms, allowed between a graded and a played deviation.
+
+
+// Played off the beat by, in ms - whole samples at 48 kHz.
+constexpr r64 DEVIATIONS [] { 0, 4.5, -6.25, 12, -2, 20.5, -15, 8 };
+
+
+u32 noise = 0x1234567;
+
+s16 GetNoise () {
+	noise = noise * 1664525 + 1013904223; // LCG
+	return (s16)((s32)(noise >> 16) % (2 * TEST_NOISE + 1) - TEST_NOISE);
+}
+
+
+bool IsMissed (const u32& beat) { return beat % TEST_MISSED == 5; }
+bool IsExtra (const u32& beat) { return beat % TEST_EXTRA == 3; }
+
+
+// A decaying 1.5 kHz burst starting at 'at' on the first channel.
+void Click (
+	INOUT	s16* const& 		frames,
+	IN		const u64& 			framesCount,
+	IN		const s64& 			at
+) {
+	for (s64 i = 0; i < TEST_CLICK && at + i < (s64)framesCount; ++i) {
+		const r64 t = (r64)i / TEST_RATE;
+		const r64 value = 12000.0 * sin (2 * M_PI * 1500 * t) * exp (-t / 0.004);
+		frames[(at + i) * TEST_CHANNELS] += (s16)value;
+	}
+}
+
+
+// Returns the number of frames.
+u64 Generate (
+	IN		const c8* const& 	filename,
+	IN		const u64& 			spbSamples
+) {
+	const u64 framesCount = (TEST_BEATS + 1) * spbSamples;
+	s16* const frames = (s16*) calloc (framesCount * TEST_CHANNELS, sizeof (s16));
+
+	for (u64 i = 0; i < framesCount * TEST_CHANNELS; ++i) frames[i] = GetNoise ();
+
+	for (u32 beat = 0; beat < TEST_BEATS; ++beat) {
+		const s64 at = beat * spbSamples + (s64)(DEVIATIONS[beat % 8] * TEST_RATE / 1000);
+		if (!IsMissed (beat)) Click (frames, framesCount, at);
+		if (IsExtra (beat)) Click (frames, framesCount, at + TEST_EXTRA_AFTER * TEST_RATE / 1000);
+	}
+
+	FILE* file = fopen (filename, "wb");
+	if (file == nullptr) ERROR ("Couldn't create '%s'.\n", filename);
+
+	const u32 dataSize = framesCount * TEST_CHANNELS * sizeof (s16);
+	const c8 list [] = "INFOtest"; // 9 bytes with the terminator, padded to 10.
+
+	const u32 riffSize = 4 + (8 + 16) + (8 + sizeof (list) + 1) + (8 + dataSize);
+	const u16 format = 1, channels = TEST_CHANNELS, blockAlign = TEST_CHANNELS * 2, bits = 16;
+	const u32 fmtSize = 16, listSize = sizeof (list), rate = TEST_RATE, byteRate = TEST_RATE * blockAlign;
+
+	fwrite ("RIFF", 1, 4, file); fwrite (&riffSize, 4, 1, file); fwrite ("WAVE", 1, 4, file);
+
+	fwrite ("fmt ", 1, 4, file); fwrite (&fmtSize, 4, 1, file);
+	fwrite (&format, 2, 1, file); fwrite (&channels, 2, 1, file); fwrite (&rate, 4, 1, file);
+	fwrite (&byteRate, 4, 1, file); fwrite (&blockAlign, 2, 1, file); fwrite (&bits, 2, 1, file);
+
+	fwrite ("LIST", 1, 4, file); fwrite (&listSize, 4, 1, file); fwrite (list, 1, sizeof (list) + 1, file);
+
+	fwrite ("data", 1, 4, file); fwrite (&dataSize, 4, 1, file); fwrite (frames, 1, dataSize, file);
+
+	fclose (file);
+	free (frames);
+
+	return framesCount;
+}
+
+
+s32 main () {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	const u64 spbNs = 60000000000ull / TEST_BPM;
+	const u64 spbSamples = (u64)TEST_RATE * 60 / TEST_BPM;
+	const u64 origin = 1000000000000ull; // Arbitrary, only differences count.
+
+	const u64 framesCount = Generate (TEST_FILENAME, spbSamples);
+
+	ONSET::Open (TEST_FILENAME);
+	CHECK (
+		ONSET::rate == TEST_RATE && ONSET::frameSize == TEST_CHANNELS * 2 && ONSET::framesCount == framesCount,
+		"read as %u Hz, %u byte frames, %llu frames", ONSET::rate, ONSET::frameSize, (unsigned long long)ONSET::framesCount
+	);
+
+	const ONSET::BEATS beats { origin, spbNs, origin, 0 };
+	u64 onsets [METRONOME_ONSET_FOUND];
+	r64 worst = 0;
+	u32 wrong = 0; 	// Graded for a beat that has no hit.
+
+	for (u64 fed = 0; fed < ONSET::framesCount;) {
+		const u32 count = ONSET::framesCount - fed < METRONOME_ONSET_CHUNK ? (u32)(ONSET::framesCount - fed) : METRONOME_ONSET_CHUNK;
+		for (u32 i = 0; i < count; ++i) memcpy (ONSET::chunk + i, ONSET::samples + (fed + i) * ONSET::frameSize, 2);
+
+		const u32 found = ONSET::Feed (ONSET::detector, ONSET::chunk, count, onsets, METRONOME_ONSET_FOUND);
+		fed += count;
+
+		for (u32 i = 0; i < found; ++i) {
+			const u32 graded = ONSET::grades.graded;
+			const r64 sum = ONSET::grades.sum;
+
+			ONSET::Grade (ONSET::grades, beats, origin + onsets[i] * 1000000000ull / ONSET::rate);
+			if (ONSET::grades.graded == graded) continue;
+
+			const u32 beat = ONSET::grades.next - 1;
+			if (beat >= TEST_BEATS || IsMissed (beat)) { ++wrong; continue; }
+
+			const r64 error = fabs ((ONSET::grades.sum - sum) - DEVIATIONS[beat % 8]);
+			if (error > worst) worst = error;
+		}
+	}
+
+	const ONSET::GRADES grades = ONSET::grades;
+	ONSET::Close ();
+	remove (TEST_FILENAME);
+
+	u32 missed = 0, extra = 0;
+	for (u32 beat = 0; beat < TEST_BEATS; ++beat) { missed += IsMissed (beat); extra += IsExtra (beat); }
+
+	printf ("Deviations graded off the played ones by at most %.3f ms\n", worst);
+
+	CHECK (grades.graded == TEST_BEATS - missed, "%u beats graded, %u played", grades.graded, TEST_BEATS - missed);
+	CHECK (grades.missed == missed, "%u beats missed, %u not played", grades.missed, missed);
+	CHECK (grades.extra == extra, "%u extra onsets, %u played", grades.extra, extra);
+	CHECK (wrong == 0, "%u beats graded without a hit", wrong);
+	CHECK (worst <= TEST_ERROR, "a deviation is graded %.3f ms off", worst);
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
@@ -0,0 +1,230 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <algorithm>
+#include <threads.h>
+//
+#include "global.hpp"
+#include "compiled.hpp"
+#include "bank.hpp"
+#include "osc.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// OSC flood over loopback. The schedule plays with MIDI clock output on (24 traced timings
+//  a beat instead of one) while 'OSC::Receive' runs on its own thread, first quiet and then
+//  with another thread sending volume messages to it at 'TEST_RATE'. How late clocks go out
+//  is printed for both, under the flood 95% of them have to be within 'TEST_JITTER'. The
+//  sender shares the machine too, on a single core it's most of what the player feels.
+//
+//  On windows 'midiOut' device 1 is used (the software synthesizer, it ignores clocks),
+//  without one the test is skipped. Elsewhere clocks are written to '/dev/null'.
+//
+//  USAGE: test_osc
+//
+
+#define TEST_PORT 			47121
+#define TEST_RATE 			100000 		// Messages per second.
+#define TEST_PHASE 			2000 		// ms, quiet and then flooded.
+#define TEST_JITTER 		1000000 	// ns, 95th percentile allowed under the flood.
+
+
+BANK::SLOT& slot = BANK::slots[0];
+std::atomic<bool> isFlooding = true;
+u64 sentCount = 0;
+
+
+s32 Play (
+	INOUT	void* anyargs
+) {
+
+	DEBUG (DEBUG_FLAG_LOGGING) {
+		if (anyargs != nullptr) LOGWARN ("Arguments passed to 'Play'!");
+	}
+
+	GLOBAL::PlaySchedule (&slot);
+	return 0;
+}
+
+
+s32 Listen (
+	INOUT	void* anyargs
+) {
+
+	DEBUG (DEBUG_FLAG_LOGGING) {
+		if (anyargs != nullptr) LOGWARN ("Arguments passed to 'Listen'!");
+	}
+
+	while (GLOBAL::isStopPlayback) OSC::Receive ();
+	return 0;
+}
+
+
+// Sends '/metronome/volume i' at 'TEST_RATE', catching up every millisecond.
+s32 Flood (
+	INOUT	void* anyargs
+) {
+
+	DEBUG (DEBUG_FLAG_LOGGING) {
+		if (anyargs != nullptr) LOGWARN ("Arguments passed to 'Flood'!");
+	}
+
+	const OSC::SOCKET sender = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+	sockaddr_in address {};
+	address.sin_family 		= AF_INET;
+	address.sin_port 		= htons (TEST_PORT);
+	address.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+
+	c8 message [28] = "/metronome/volume\0\0\0,i\0\0"; // Address and tags padded to 4.
+	const timespec millisecond { 0, 1000000l };
+	const u64 start = TESTS::Now ();
+
+	while (isFlooding.load (std::memory_order_relaxed)) {
+		const u64 due = (TESTS::Now () - start) * TEST_RATE / 1000000000ull;
+
+		for (; sentCount < due; ++sentCount) {
+			const u32 volume = 1 + sentCount % 100;
+			const u8 value [4] { 0, 0, 0, (u8)volume };
+			memcpy (message + 24, value, sizeof (value));
+			sendto (sender, message, sizeof (message), 0, (const sockaddr*)&address, sizeof (address));
+		}
+
+		thrd_sleep (&millisecond, nullptr);
+	}
+
+	#ifdef _WIN32
+		closesocket (sender);
+	#else
+		close (sender);
+	#endif
+
+	return 0;
+}
+
+
+// Lateness of the clocks due within 'from' - 'to', sorted. Returns their count.
+u32 GetLate (
+	IN		const u64* const& 	scheduled,
+	IN		const u64* const& 	sent,
+	IN		const u32& 			clocks,
+	IN		const u64& 			from,
+	IN		const u64& 			to,
+	OUT		s64* const& 		late
+) {
+	u32 count = 0;
+
+	for (u32 i = 0; i < clocks; ++i) {
+		if (scheduled[i] >= from && scheduled[i] < to && sent[i]) late[count++] = (s64)(sent[i] - scheduled[i]);
+	}
+
+	std::sort (late, late + count);
+	return count;
+}
+
+
+s32 main () {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	#ifdef _WIN32
+		if (midiOutGetNumDevs () == 0) {
+			printf ("No 'midiOut' device. Skipped.\n");
+			return 0;
+		}
+
+		MIDI::Open (1);
+	#else
+		MIDI::output = fopen ("/dev/null", "wb"); // Instead of a raw MIDI device.
+		setvbuf (MIDI::output, nullptr, _IONBF, 0);
+	#endif
+
+	ALCdevice* device;
+	ALCcontext* context;
+	COMPILED::LOADED loaded {};
+
+	using ARGUMENTS::MAINARGS;
+	constexpr const auto& BPM = ARGUMENTS::OPTION::Find<&MAINARGS::bpm> ();
+
+	ARGUMENTS::MAINARGS mainArgs = ARGUMENTS::Defaults ();
+	mainArgs.bpm = BPM.max; // The most clocks.
+
+	SCHEDULE::FromArguments (SCHEDULE::plan, mainArgs);
+	slot.plan = &SCHEDULE::plan;
+
+	AUDIO::LISTENER::Create (device, context);
+	BANK::Create (slot.sounds, *slot.plan, loaded);
+	BANK::playing = &slot;
+
+	OSC::Open (TEST_PORT);
+
+	thrd_t player, listener, flooder;
+	thrd_create (&player, Play, nullptr);
+	thrd_create (&listener, Listen, nullptr);
+
+	const timespec phase { TEST_PHASE / 1000, (TEST_PHASE % 1000) * 1000000l };
+	const u64 quietAt = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+	thrd_sleep (&phase, nullptr);
+
+	const u64 floodAt = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+	thrd_create (&flooder, Flood, nullptr);
+	thrd_sleep (&phase, nullptr);
+
+	isFlooding = false;
+	thrd_join (flooder, nullptr);
+	const u64 endAt = TIMESTAMP::GetNanoseconds (TIMESTAMP::GetCurrent ());
+
+	GLOBAL::isStopPlayback = false;
+	thrd_join (player, nullptr);
+	thrd_join (listener, nullptr);
+
+	OSC::Close ();
+	MIDI::Close ();
+
+	// Clocks by index, from whichever thread traced them.
+	static u64 scheduled [TRACE_SIZE], sent [TRACE_SIZE];
+	static s64 late [TRACE_SIZE];
+	const u32 clocks = std::min<u32> (MIDI::clock, TRACE_SIZE);
+
+	for (u16 thread = 0; thread < std::min<u16> (TRACE::threadsCounter.load (), TRACE_THREADS); ++thread) {
+		for (u32 i = 0; i < TRACE::counts[thread]; ++i) {
+			const TRACE::EVENT& event = TRACE::events[thread][i];
+			if (event.value >= clocks) continue;
+			if (event.type == EVENTS::CLOCK_SCHEDULED) scheduled[event.value] = event.time;
+			if (event.type == EVENTS::CLOCK_SENT) sent[event.value] = event.time;
+		}
+	}
+
+	printf ("%llu messages sent, %.0f per second.\n", (unsigned long long)sentCount, sentCount / ((endAt - floodAt) / 1e9));
+	CHECK (sentCount >= (u64)TEST_RATE * TEST_PHASE / 1000 / 2, "the flood was under half of %u per second", TEST_RATE);
+
+	const c8* const names [2] { "quiet", "flooded" };
+	const u64 bounds [3] { quietAt, floodAt, endAt };
+	s64 flooded = 0;
+
+	for (u8 i = 0; i < 2; ++i) {
+		const u32 count = GetLate (scheduled, sent, clocks, bounds[i], bounds[i + 1], late);
+		CHECK (count != 0, "no clocks while %s", names[i]);
+		if (count == 0) continue;
+
+		flooded = late[count * 95 / 100];
+		printf (
+			"%-8s %4u clocks, sent late by: median %.3f ms, 95th %.3f ms, 99th %.3f ms, max %.3f ms\n", names[i], count,
+			late[count / 2] / 1e6, late[count * 95 / 100] / 1e6, late[count * 99 / 100] / 1e6, late[count - 1] / 1e6
+		);
+	}
+
+	CHECK (flooded <= TEST_JITTER, "95th percentile under the flood is over %.3f ms", TEST_JITTER / 1e6);
+	CHECK (GLOBAL::commandsDropped.load () == 0, "commands were dropped");
+
+	BANK::Destroy (slot.sounds);
+	AUDIO::LISTENER::Destroy (device, context);
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
@@ -0,0 +1,243 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <atomic>
+#include <threads.h>
+//
+#include "peers.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// Peers as separate processes on one machine. This one founds a session, then runs itself
+//  again 'TEST_PEERS' - 1 times as the other peers ('test_peers peer <at>'), each starting
+//  with its own tempo. A socket of its own in the group watches what they announce and times
+//  how long until all of them play the same session version:
+//  - joining - every newcomer takes the founded session over its own,
+//  - a change - this peer changes the tempo,
+//  - concurrent changes - this peer and the first other one change it at the same time
+//    ('<at>', system clock), the higher version wins everywhere.
+//  Each has to converge within 'TEST_CONVERGE'.
+//
+//  USAGE: test_peers
+//
+
+#define TEST_PORT 			47141
+#define TEST_PEERS 			4
+#define TEST_SPB 			500000000ull 	// ns, founded
+#define TEST_SPB_OTHER 		400000000ull 	// ns, newcomers' own
+#define TEST_SPB_CHANGED 	250000000ull 	// ns
+#define TEST_SPB_RIVAL 		300000000ull 	// ns, the first other peer's change
+#define TEST_PATTERN 		3
+#define TEST_CONVERGE 		1000 			// ms
+#define TEST_SETTLE 		500 			// ms, after converging before the next phase.
+#define TEST_LIFE 			20 				// s, other peers quit on their own after.
+
+
+struct STATE {
+	u32 id;
+	u64 counter;
+	u32 author;
+};
+
+
+std::atomic<bool> isPeering = true;
+PEERS::SOCKET watcher = PEERS::INVALID_SOCKET;
+STATE others [TEST_PEERS - 1];
+u8 othersCount = 0;
+STATE rival {}; 	// Highest version announced by another author.
+
+
+s32 Exchange (
+	INOUT	void* anyargs
+) {
+
+	DEBUG (DEBUG_FLAG_LOGGING) {
+		if (anyargs != nullptr) LOGWARN ("Arguments passed to 'Exchange'!");
+	}
+
+	while (isPeering.load (std::memory_order_relaxed)) PEERS::Exchange ();
+	return 0;
+}
+
+
+// Another peer. Changes the tempo at 'at' (system clock, nanoseconds) unless it's 0.
+s32 Peer (
+	IN		const u64& 		at
+) {
+	PEERS::Open (TEST_PORT, TEST_SPB_OTHER, TEST_PATTERN);
+
+	bool isChanged = at == 0;
+	const u64 start = TESTS::Now ();
+
+	for (u64 now = start; now - start < TEST_LIFE * 1000000000ull; now = TESTS::Now ()) {
+		if (!isChanged && now >= at) {
+			PEERS::Change (now, TEST_SPB_RIVAL, 0, TEST_PATTERN);
+			isChanged = true;
+		}
+
+		PEERS::Exchange ();
+	}
+
+	PEERS::Close ();
+	return 0;
+}
+
+
+void Watch () {
+	watcher = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+	const s32 isReused = 1;
+	setsockopt (watcher, SOL_SOCKET, SO_REUSEADDR, (const c8*)&isReused, sizeof (isReused));
+
+	sockaddr_in address {};
+	address.sin_family 		= AF_INET;
+	address.sin_port 		= htons (TEST_PORT);
+	address.sin_addr.s_addr = htonl (INADDR_ANY);
+
+	if (bind (watcher, (const sockaddr*)&address, sizeof (address)) != 0) ERROR ("Port %u could not be bound.\n", TEST_PORT);
+
+	ip_mreq membership {};
+	membership.imr_multiaddr.s_addr = htonl (METRONOME_PEERS_GROUP);
+	membership.imr_interface.s_addr = htonl (INADDR_ANY);
+
+	if (setsockopt (watcher, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const c8*)&membership, sizeof (membership)) != 0) {
+		ERROR ("Peers group could not be joined.\n");
+	}
+}
+
+
+// Takes announcements that came within 'milliseconds'.
+void Listen (
+	IN		const u32& 		milliseconds
+) {
+	fd_set readable;
+	FD_ZERO (&readable);
+	FD_SET (watcher, &readable);
+
+	timeval timeout { 0, (s32)milliseconds * 1000 };
+	if (select (watcher + 1, &readable, nullptr, nullptr, &timeout) <= 0) return;
+
+	PEERS::MESSAGE message;
+	if (recv (watcher, (c8*)&message, sizeof (message), 0) != sizeof (message)) return;
+	if (message.magic != METRONOME_PEERS_MAGIC || message.type != PEERS::TYPE_STATE || message.from == PEERS::self) return;
+
+	if (message.author != PEERS::self && message.counter > rival.counter) rival = STATE { message.from, message.counter, message.author };
+
+	u8 i = 0;
+	for (; i < othersCount; ++i) if (others[i].id == message.from) break;
+
+	if (i == othersCount) {
+		if (othersCount == TEST_PEERS - 1) return;
+		++othersCount;
+	}
+
+	others[i] = STATE { message.from, message.counter, message.author };
+}
+
+
+// Nanoseconds from 'start' until every other peer announced what this one plays, 0 when
+//  they didn't within 'TEST_CONVERGE'.
+u64 Converge (
+	IN		const u64& 		start
+) {
+	for (u64 now = start; now - start < TEST_CONVERGE * 1000000ull; now = TESTS::Now ()) {
+		Listen (1);
+
+		const PEERS::SESSION own = PEERS::Read ();
+		u8 agreeing = 0;
+
+		for (u8 i = 0; i < othersCount; ++i) {
+			if (others[i].counter == own.counter && others[i].author == own.author) ++agreeing;
+		}
+
+		if (agreeing == TEST_PEERS - 1) return TESTS::Now () - start;
+	}
+
+	return 0;
+}
+
+
+void Settle () {
+	const u64 start = TESTS::Now ();
+	while (TESTS::Now () - start < TEST_SETTLE * 1000000ull) Listen (1);
+}
+
+
+s32 main (s32 argumentsCount, c8** arguments) {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	if (argumentsCount > 2 && strcmp (arguments[1], "peer") == 0) return Peer (strtoull (arguments[2], nullptr, 10));
+
+	PEERS::Open (TEST_PORT, TEST_SPB, TEST_PATTERN);
+	Watch ();
+
+	thrd_t exchanger;
+	thrd_create (&exchanger, Exchange, nullptr);
+
+	while (PEERS::Read ().counter == 0) Listen (10);
+
+	// Concurrent changes happen this long after the peers were started.
+	const u64 at = TESTS::Now () + (TEST_CONVERGE + TEST_SETTLE) * 3000000ull;
+
+	c8 atArgument [24];
+	snprintf (atArgument, sizeof (atArgument), "%llu", (unsigned long long)at);
+
+	TESTS::PROCESS processes [TEST_PEERS - 1];
+	const c8* const firstArguments [] { "peer", atArgument };
+	const c8* const otherArguments [] { "peer", "0" };
+
+	const u64 joinedAt = TESTS::Now ();
+	for (u8 i = 0; i < TEST_PEERS - 1; ++i) processes[i] = TESTS::Spawn (arguments[0], i == 0 ? firstArguments : otherArguments);
+
+	const u64 joined = Converge (joinedAt);
+	printf ("Joining converged in %.1f ms.\n", joined / 1e6);
+	CHECK (joined != 0, "%u of %u peers joined within %u ms", othersCount, TEST_PEERS - 1, TEST_CONVERGE);
+
+	Settle ();
+
+	const u64 changedAt = TESTS::Now ();
+	PEERS::Change (changedAt, TEST_SPB_CHANGED, 0, TEST_PATTERN);
+
+	const u64 changed = Converge (changedAt);
+	printf ("A change converged in %.1f ms.\n", changed / 1e6);
+	CHECK (changed != 0, "the change didn't converge within %u ms", TEST_CONVERGE);
+
+	while (TESTS::Now () < at) Listen (1);
+
+	const u64 before = PEERS::Read ().counter;
+	PEERS::Change (at, TEST_SPB_CHANGED / 2, 0, TEST_PATTERN);
+
+	const u64 concurrent = Converge (at);
+	const PEERS::SESSION winner = PEERS::Read ();
+	printf ("Concurrent changes converged in %.1f ms, version %llu by %08x.\n", concurrent / 1e6, (unsigned long long)winner.counter, winner.author);
+
+	CHECK (concurrent != 0, "concurrent changes didn't converge within %u ms", TEST_CONVERGE);
+	CHECK (rival.counter > before, "the other peer's change wasn't heard");
+
+	if (rival.counter == before + 1) { // Truly concurrent, the same counter.
+		const u32 higher = rival.author > PEERS::self ? rival.author : PEERS::self;
+		CHECK (winner.counter == before + 1 && winner.author == higher, "the lower of equal versions won");
+	} else CHECK (winner.counter == rival.counter && winner.author == rival.author, "a later change lost");
+
+	for (u8 i = 0; i < TEST_PEERS - 1; ++i) TESTS::Stop (processes[i]);
+
+	isPeering = false;
+	thrd_join (exchanger, nullptr);
+
+	#ifdef _WIN32
+		closesocket (watcher);
+	#else
+		close (watcher);
+	#endif
+
+	PEERS::Close ();
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
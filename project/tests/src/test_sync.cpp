@@ -0,0 +1,235 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include <atomic>
+#include <cmath>
+#include <threads.h>
+//
+#include "sync.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// Leader and follower as two processes over loopback. The test runs itself again as the
+//  leader ('test_sync lead'), which publishes a fixed timeline and answers requests. The
+//  follower talks to it through a relay on its own thread that holds every packet for
+//  'TEST_DELAY' and a random time more, as if it waited in a queue - up to 'TEST_QUEUE' for
+//  replies and a quarter of it for requests, so averaging every exchange would be biased.
+//  The relay also moves the leader's clock by 'TEST_SKEW' in the replies. Both processes
+//  read the same system clock, so after 'TEST_EXCHANGES' the estimated offset has to be
+//  'TEST_SKEW' within 'TEST_ERROR' and the beats it gives have to fall on the leader's.
+//
+//  USAGE: test_sync
+//
+
+#define TEST_PORT 			47131 			// Leader.
+#define TEST_RELAY 			47132
+#define TEST_SPB 			500000000ull 	// ns, 120 BPM
+#define TEST_PATTERN 		3
+#define TEST_EXCHANGES 		50
+#define TEST_DELAY 			1000000 		// ns, each way.
+#define TEST_QUEUE 			4000000 		// ns, replies at most.
+#define TEST_SKEW 			3000000000ll 	// ns, leader's clock is ahead by.
+#define TEST_ERROR 			300000 			// ns, offset and beats.
+#define TEST_DRIFT 			0.0001 			// Largest drift accepted, the clocks are one.
+#define TEST_LIFE 			30 				// s, the leader quits on its own after.
+#define TEST_PENDING 		64
+
+
+struct PENDING {
+	u64 due;
+	bool isReply;
+	SYNC::PACKET packet;
+};
+
+
+std::atomic<bool> isRelaying = true;
+SYNC::SOCKET followers = SYNC::INVALID_SOCKET, leaders = SYNC::INVALID_SOCKET;
+sockaddr_in follower {}, leader {};
+PENDING pending [TEST_PENDING];
+u32 pendingCount = 0;
+u32 noise = 0x1234567;
+
+
+u32 GetRandom () {
+	noise = noise * 1664525 + 1013904223; // LCG
+	return noise >> 8;
+}
+
+
+void CloseSocket (
+	IN		const SYNC::SOCKET& 	socket
+) {
+	#ifdef _WIN32
+		closesocket (socket);
+	#else
+		close (socket);
+	#endif
+}
+
+
+s32 Lead () {
+	SYNC::Lead (TEST_PORT);
+
+	const u64 start = TESTS::Now ();
+	SYNC::Publish (start, TEST_SPB, 0, TEST_PATTERN);
+
+	while (TESTS::Now () - start < TEST_LIFE * 1000000000ull) SYNC::Serve ();
+
+	SYNC::Close ();
+	return 0;
+}
+
+
+// Holds what came from 'socket' until it's due.
+void Hold (
+	IN		const SYNC::SOCKET& 	socket,
+	IN		const bool& 			isReply
+) {
+	PENDING& entry = pending[pendingCount];
+	sockaddr_in from {};
+	socklen_t fromSize = sizeof (from);
+
+	const s32 size = recvfrom (socket, (c8*)&entry.packet, sizeof (entry.packet), 0, (sockaddr*)&from, &fromSize);
+	if (size != sizeof (entry.packet) || pendingCount == TEST_PENDING - 1) return;
+
+	if (isReply) {
+		entry.packet.receive 	+= TEST_SKEW;
+		entry.packet.transmit 	+= TEST_SKEW;
+		entry.packet.anchor 	+= TEST_SKEW;
+	} else follower = from;
+
+	entry.due 		= TESTS::Now () + TEST_DELAY + GetRandom () % (isReply ? TEST_QUEUE : TEST_QUEUE / 4);
+	entry.isReply 	= isReply;
+	++pendingCount;
+}
+
+
+s32 Relay (
+	INOUT	void* anyargs
+) {
+
+	DEBUG (DEBUG_FLAG_LOGGING) {
+		if (anyargs != nullptr) LOGWARN ("Arguments passed to 'Relay'!");
+	}
+
+	while (isRelaying.load (std::memory_order_relaxed)) {
+		fd_set readable;
+		FD_ZERO (&readable);
+		FD_SET (followers, &readable);
+		FD_SET (leaders, &readable);
+
+		timeval timeout { 0, 100 }; // Packets are sent within 0.1 ms of being due.
+		const SYNC::SOCKET last = followers > leaders ? followers : leaders;
+
+		if (select (last + 1, &readable, nullptr, nullptr, &timeout) > 0) {
+			if (FD_ISSET (followers, &readable)) Hold (followers, false);
+			if (FD_ISSET (leaders, &readable)) Hold (leaders, true);
+		}
+
+		const u64 now = TESTS::Now ();
+
+		for (u32 i = 0; i < pendingCount;) {
+			const PENDING& entry = pending[i];
+			if (entry.due > now) { ++i; continue; }
+
+			const sockaddr_in& to = entry.isReply ? follower : leader;
+			sendto (entry.isReply ? followers : leaders, (const c8*)&entry.packet, sizeof (entry.packet), 0, (const sockaddr*)&to, sizeof (to));
+
+			--pendingCount;
+			if (i != pendingCount) pending[i] = pending[pendingCount];
+		}
+	}
+
+	return 0;
+}
+
+
+s32 main (s32 argumentsCount, c8** arguments) {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	if (argumentsCount > 1 && strcmp (arguments[1], "lead") == 0) return Lead ();
+
+	const c8* const leadArguments [] { "lead" };
+	const TESTS::PROCESS leaderProcess = TESTS::Spawn (arguments[0], leadArguments);
+
+	c8 relayAddress [32];
+	snprintf (relayAddress, sizeof (relayAddress), "127.0.0.1:%u", TEST_RELAY);
+	SYNC::Join (relayAddress);
+
+	followers 	= socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	leaders 	= socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+	sockaddr_in relay {};
+	relay.sin_family 		= AF_INET;
+	relay.sin_port 			= htons (TEST_RELAY);
+	relay.sin_addr.s_addr 	= htonl (INADDR_LOOPBACK);
+
+	leader.sin_family 		= AF_INET;
+	leader.sin_port 		= htons (TEST_PORT);
+	leader.sin_addr.s_addr 	= htonl (INADDR_LOOPBACK);
+
+	if (bind (followers, (const sockaddr*)&relay, sizeof (relay)) != 0) ERROR ("Relay port %u could not be bound.\n", TEST_RELAY);
+
+	thrd_t relayer;
+	thrd_create (&relayer, Relay, nullptr);
+
+	// Requests before the leader is up are lost, they're counted as exchanges anyway.
+	for (u32 i = 0; i < TEST_EXCHANGES; ++i) SYNC::Exchange ();
+
+	isRelaying = false;
+	thrd_join (relayer, nullptr);
+
+	TESTS::Stop (leaderProcess);
+	CloseSocket (followers);
+	CloseSocket (leaders);
+
+	const SYNC::ESTIMATE estimate = SYNC::Read (SYNC::estimate, SYNC::estimateSequence);
+	const u32 samplesCount = estimate.samples < METRONOME_SYNC_SAMPLES ? estimate.samples : METRONOME_SYNC_SAMPLES;
+
+	// What averaging every exchange would have given.
+	r64 naive = 0, naiveMax = 0;
+	for (u32 i = 0; i < samplesCount; ++i) {
+		const r64 error = SYNC::samples[i].offset - TEST_SKEW;
+		naive += error / samplesCount;
+		if (std::abs (error) > naiveMax) naiveMax = std::abs (error);
+	}
+
+	const r64 error = estimate.offset - TEST_SKEW;
+
+	printf ("%u exchanges answered.\n", estimate.samples);
+	printf ("Offset error: estimated %.3f ms, averaging all %.3f ms (worst %.3f ms).\n", error / 1e6, naive / 1e6, naiveMax / 1e6);
+	printf ("Drift: %.1f ppm\n", estimate.drift * 1e6);
+
+	CHECK (estimate.samples >= TEST_EXCHANGES / 2, "only %u of %u exchanges answered", estimate.samples, TEST_EXCHANGES);
+	CHECK (std::abs (error) <= TEST_ERROR, "offset is off by %.3f ms", error / 1e6);
+	CHECK (std::abs (estimate.drift) <= TEST_DRIFT, "drift of %.1f ppm between the same clock", estimate.drift * 1e6);
+
+	u64 deadline, spbNs;
+	u8 pattern, bar;
+
+	const bool isSynced = SYNC::GetBeat (estimate, TESTS::Now (), deadline, spbNs, pattern, bar);
+	CHECK (isSynced, "no beat after the exchanges");
+
+	if (isSynced) {
+		const u64 anchor = estimate.timeline.anchor - TEST_SKEW; // Leader's beat, on the shared clock.
+		const s64 phase = (s64)((deadline - anchor) % TEST_SPB);
+		const s64 apart = phase < (s64)TEST_SPB / 2 ? phase : phase - (s64)TEST_SPB;
+
+		printf ("Beats %.3f ms from the leader's.\n", apart / 1e6);
+
+		CHECK (std::abs (apart) <= TEST_ERROR, "beat is %.3f ms off the leader's", apart / 1e6);
+		CHECK (pattern == TEST_PATTERN, "pattern %u instead of %u", pattern, TEST_PATTERN);
+		CHECK (bar == ((deadline - anchor + TEST_SPB / 2) / TEST_SPB) % (TEST_PATTERN + 1), "beat %u of the bar is wrong", bar);
+	}
+
+	SYNC::Close ();
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
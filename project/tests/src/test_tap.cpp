@@ -0,0 +1,75 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+// HACK. Ensure the following is always included first.
+#include "bluelib.hpp"
+//
+#include "tap.hpp"
+#include "tests.hpp"
+
+
+//  ABOUT
+// Tap tempo ('TAP::Estimate') replayed from recorded taps - milliseconds of presses on
+//  enter, no keyboard and no waiting. Each recording is replayed from no taps and the tempo
+//  after its last tap has to be within 'TEST_BPM' of the one tapped, or 0 where no tempo
+//  may be set yet. Taps are replayed in the order listed - an onset from '--grade' can
+//  come after a newer key tap, it has to be put in its place, or left out when it's older
+//  than the newest by a reset or older than all of a full list.
+//
+//  USAGE: test_tap
+//
+
+#define TEST_BPM 			1.0 	// Allowed off the tapped tempo.
+#define TEST_TAPS 			16
+
+
+struct RECORDING {
+	const c8* name;
+	r64 bpm; 				// 0 -> none yet
+	u32 count;
+	u32 ms [TEST_TAPS];
+};
+
+
+constexpr RECORDING recordings [] {
+	{ "steady 120", 		120, 	10, 	{ 0, 512, 995, 1508, 2003, 2489, 3011, 3497, 4004, 4510 } },
+	{ "steady 90", 			90, 	8, 		{ 0, 671, 1329, 2006, 2661, 3338, 3994, 4667 } },
+	{ "steady 200", 		200, 	9, 		{ 0, 297, 604, 898, 1203, 1497, 1806, 2099, 2401 } },
+	{ "skipped beat", 		120, 	8, 		{ 0, 507, 996, 1503, 2497, 3004, 3498, 4003 } },
+	{ "double tap", 		120, 	9, 		{ 0, 497, 1006, 1049, 1502, 1998, 2507, 2994, 3501 } },
+	{ "late tap", 			120, 	8, 		{ 0, 503, 996, 1651, 2004, 2497, 3002, 3499 } },
+	{ "slowing 140 to 100", 100, 	14, 	{ 0, 431, 855, 1284, 1713, 2142, 2743, 3342, 3946, 4541, 5144, 5742, 6341, 6944 } },
+	{ "two taps", 			0, 		2, 		{ 0, 500 } },
+	{ "pause, two taps", 	0, 		6, 		{ 0, 498, 1003, 1502, 3810, 4309 } },
+	{ "pause, three taps", 	90, 	7, 		{ 0, 498, 1003, 1502, 3810, 4477, 5143 } },
+	{ "onset behind a tap", 120, 	6, 		{ 0, 497, 1003, 1502, 2004, 1998 } },
+	{ "onset a reset old", 	120, 	5, 		{ 3000, 3497, 4002, 500, 4501 } },
+	{ "onset before all", 	120, 	10, 	{ 500, 1003, 1498, 2001, 2502, 2996, 3503, 4000, 300, 4498 } },
+};
+
+
+s32 main () {
+
+	TIMESTAMP_BEGIN = TIMESTAMP::GetCurrent ();
+	LOGSTART ();
+
+	const u64 start = 1000000000000ull; // Arbitrary, only differences count.
+
+	for (const RECORDING& recording : recordings) {
+		TAP::TAPS taps {};
+		r64 bpm = 0;
+
+		for (u32 i = 0; i < recording.count; ++i) bpm = TAP::Estimate (taps, start + recording.ms[i] * 1000000ull);
+
+		printf ("%-20s %6.2f bpm\n", recording.name, bpm);
+
+		if (recording.bpm == 0) {
+			CHECK (bpm == 0, "%s: %.2f bpm before enough taps", recording.name, bpm);
+		} else {
+			CHECK (std::abs (bpm - recording.bpm) <= TEST_BPM, "%s: %.2f bpm instead of %.0f", recording.name, bpm, recording.bpm);
+		}
+	}
+
+	LOGSTOP ();
+	return TESTS::Result ();
+}
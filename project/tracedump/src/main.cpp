@@ -0,0 +1,162 @@
+// Created 2026.10.19 by Matthew Strumiłło (dotBlueShoes)
+//  LICENSE: GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+//
+#include <blue/error.hpp>
+#include <blue/trace.hpp>
+//
+#include <cinttypes>
+//
+#include "events.hpp"
+
+
+//  ABOUT
+// Turns a 'metronome.trace' dump into Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+//  and prints beat and MIDI clock jitter histograms (done - scheduled) to stdout.
+//
+//  USAGE: tracedump <file.trace> [output.json]
+//
+
+#define TRACEDUMP_DEFAULT_OUTPUT "metronome.json"
+
+namespace HISTOGRAM {
+
+	// Bucket upper bounds in microseconds. The last bucket takes everything above.
+	const s64 BOUNDS [] { -1000, -250, -50, 0, 50, 100, 250, 500, 1000, 2500, 5000 };
+	const u8 COUNT = sizeof (BOUNDS) / sizeof (BOUNDS[0]) + 1;
+
+	u8 GetBucket (
+		IN		const s64& 		jitter
+	) {
+		u8 i = 0;
+		for (; i < COUNT - 1 && jitter >= BOUNDS[i]; ++i);
+		return i;
+	}
+
+	void Print (
+		IN		const u32* const& 	buckets,
+		IN		const u32& 			total
+	) {
+		for (u8 i = 0; i < COUNT; ++i) {
+			const u32 width = total ? buckets[i] * 50 / total : 0;
+
+			if (i == 0) 				printf ("  (      , %6" PRId64 ") us | %6u | ", BOUNDS[i], buckets[i]);
+			else if (i == COUNT - 1) 	printf ("  [%6" PRId64 ",       ) us | %6u | ", BOUNDS[i - 1], buckets[i]);
+			else 						printf ("  [%6" PRId64 ", %6" PRId64 ") us | %6u | ", BOUNDS[i - 1], BOUNDS[i], buckets[i]);
+
+			for (u32 j = 0; j < width; ++j) putc ('#', stdout);
+			putc ('\n', stdout);
+		}
+	}
+
+}
+
+
+// 'scheduled' events carry a deadline, each is paired with the 'done' event of the same value.
+void PrintJitter (
+	IN		const TRACE::EVENT* const& 	events,
+	IN		const u32& 					eventsCount,
+	IN		const u16& 					scheduled,
+	IN		const u16& 					done,
+	IN		const c8* const& 			title,
+	IN		const c8* const& 			unit
+) {
+	u32 buckets [HISTOGRAM::COUNT] {};
+	u32 total = 0;
+	s64 minimum = INT64_MAX, maximum = INT64_MIN, sum = 0;
+
+	u64 deadline = 0;
+	u32 deadlineValue = UINT32_MAX;
+
+	// Events are grouped by thread in recording order, 'scheduled' always precedes its 'done'.
+	for (u32 i = 0; i < eventsCount; ++i) {
+		const auto& event = events[i];
+
+		if (event.type == scheduled) {
+			deadline = event.time;
+			deadlineValue = event.value;
+		} else if (event.type == done && event.value == deadlineValue) {
+			const s64 jitter = ((s64)event.time - (s64)deadline) / 1000;
+
+			++buckets[HISTOGRAM::GetBucket (jitter)];
+			++total;
+			sum += jitter;
+			if (jitter < minimum) minimum = jitter;
+			if (jitter > maximum) maximum = jitter;
+
+			deadlineValue = UINT32_MAX;
+		}
+	}
+
+	if (total == 0) { printf ("No %s recorded.\n", unit); return; }
+
+	printf ("%s over %u %s: min %" PRId64 " us, max %" PRId64 " us, mean %" PRId64 " us\n", title, total, unit, minimum, maximum, sum / total);
+	HISTOGRAM::Print (buckets, total);
+}
+
+
+s32 main (s32 argumentsCount, c8** arguments) {
+
+	if (argumentsCount < 2) ERROR ("Usage: tracedump <file.trace> [output.json]\n");
+
+	const c8* const inputFilename = arguments[1];
+	const c8* const outputFilename = argumentsCount > 2 ? arguments[2] : TRACEDUMP_DEFAULT_OUTPUT;
+
+	TRACE::HEADER header;
+	TRACE::EVENT* events;
+
+	{ // READ
+		FILE* input = fopen (inputFilename, "rb");
+		if (input == nullptr) ERROR ("File could not be opened - '%s'.\n", inputFilename);
+
+		if (fread (&header, sizeof (header), 1, input) != 1 || header.magic != TRACE_MAGIC) {
+			fclose (input);
+			ERROR ("'%s' is not a trace file.\n", inputFilename);
+		}
+
+		if (header.version != TRACE_VERSION) {
+			fclose (input);
+			ERROR ("Unsupported trace version %u.\n", header.version);
+		}
+
+		ALLOCATE (TRACE::EVENT, events, header.events * sizeof (TRACE::EVENT));
+		MEMORY::EXIT::PUSH (FREE, 1, events);
+
+		const u32 read = fread (events, sizeof (TRACE::EVENT), header.events, input);
+		fclose (input);
+
+		if (read != header.events) ERROR ("Trace truncated: %u of %u events.\n", read, header.events);
+	}
+
+	u64 begin = UINT64_MAX;
+	for (u32 i = 0; i < header.events; ++i) if (events[i].time < begin) begin = events[i].time;
+
+	{ // CHROME TRACE JSON
+		FILE* output = fopen (outputFilename, "wb");
+		if (output == nullptr) ERROR ("File could not be opened - '%s'.\n", outputFilename);
+
+		fprintf (output, "{\"traceEvents\":[\n");
+
+		for (u32 i = 0; i < header.events; ++i) {
+			const auto& event = events[i];
+			const c8* const name = event.type < EVENTS::COUNT ? EVENTS::NAMES[event.type] : "unknown";
+
+			fprintf (
+				output, "%s{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%u}}\n",
+				i ? "," : "", name, event.thread, (event.time - begin) / 1000.0, event.value
+			);
+		}
+
+		fprintf (output, "]}\n");
+		fclose (output);
+
+		printf ("%u events from %u threads written to '%s'.\n", header.events, header.threads, outputFilename);
+	}
+
+	PrintJitter (events, header.events, EVENTS::BEAT_SCHEDULED, EVENTS::BEAT_PLAYED, "Beat jitter (played - scheduled)", "beats");
+	PrintJitter (events, header.events, EVENTS::CLOCK_SCHEDULED, EVENTS::CLOCK_SENT, "MIDI clock jitter (sent - scheduled)", "clocks");
+
+	MEMORY::EXIT::POP ();
+	FREE (1, events);
+
+	return 0;
+}